@@ -0,0 +1,110 @@
+// bench/autosave_bench.cpp
+// Measures what an autosave costs the game thread: a world of generated chunks is edited by a
+// "game" thread while autosaves run, and the time spent inside SnapshotModified() (the only part
+// that holds the world lock) is compared with the time the I/O thread takes to write the chunks.
+// Every saved chunk is then reloaded and checked against the world.
+// Usage: autosave_bench [chunksPerSide] [saves] [directory]
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "RegionFile.h"
+#include "AutoSave.h"
+
+int main(int argc, char** argv) {
+    const int chunksPerSide = (argc > 1) ? std::atoi(argv[1]) : 16;
+    const int saveCount = (argc > 2) ? std::atoi(argv[2]) : 5;
+    const std::string directory = (argc > 3) ? argv[3] : "autosave_bench_world";
+
+    std::filesystem::remove_all(directory);
+    TerrainGenerator generator;
+    World world;
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+            chunk->chunkX = cx;
+            chunk->chunkZ = cz;
+            generator.GenerateChunk(*chunk);
+            world.InsertChunk(std::move(chunk));
+        }
+    }
+
+    RegionStore store(directory);
+    AutoSaver saver(store);
+    std::mutex worldMutex;
+    const int worldBlocks = chunksPerSide * CHUNK_SIZE;
+
+    double snapshotMs = 0.0, worstSnapshotMs = 0.0, flushMs = 0.0;
+    size_t snapshotted = 0;
+    unsigned int rng = 12345;
+    for (int save = 0; save < saveCount; ++save) {
+        // Edit a quarter of the chunks (the rest must not be re-written)
+        {
+            std::lock_guard<std::mutex> lock(worldMutex);
+            for (int i = 0; i < chunksPerSide * chunksPerSide; ++i) {
+                rng = rng * 1664525u + 1013904223u;
+                int x = (int)((rng >> 8) % (unsigned)worldBlocks);
+                int z = (int)((rng >> 16) % (unsigned)worldBlocks);
+                if ((x / CHUNK_SIZE + z / CHUNK_SIZE) % 4 == save % 4) {
+                    world.setBlock(x, CHUNK_HEIGHT - 1, z, 5);
+                }
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(worldMutex);
+            snapshotted += saver.SnapshotModified(world);
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        snapshotMs += ms;
+        worstSnapshotMs = std::max(worstSnapshotMs, ms);
+
+        // Keep editing the live chunks while the I/O thread writes the snapshots
+        {
+            std::lock_guard<std::mutex> lock(worldMutex);
+            world.setBlock(0, CHUNK_HEIGHT - 2, 0, 6);
+        }
+
+        start = std::chrono::steady_clock::now();
+        saver.Flush();
+        flushMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    {
+        std::lock_guard<std::mutex> lock(worldMutex);
+        snapshotted += saver.SnapshotModified(world);
+    }
+    saver.Stop();
+    AutoSaveStats stats = saver.GetStats();
+
+    // --- Verify: every chunk that was ever saved matches the world ---
+    RegionStore loadStore(directory);
+    int mismatches = 0, onDisk = 0;
+    Chunk loaded;
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            loaded.chunkX = cx;
+            loaded.chunkZ = cz;
+            if (!loadStore.LoadChunk(loaded)) continue;
+            ++onDisk;
+            const Chunk* live = world.GetChunk(cx, cz);
+            if (std::memcmp(loaded.blocks, live->blocks, sizeof(loaded.blocks)) != 0) ++mismatches;
+        }
+    }
+
+    std::cout << "Chunks: " << chunksPerSide * chunksPerSide << ", saves: " << saveCount
+              << ", chunk snapshots: " << snapshotted << ", written: " << stats.chunksWritten << std::endl;
+    std::cout << "Game thread per save: " << snapshotMs / saveCount << " ms avg, " << worstSnapshotMs << " ms worst" << std::endl;
+    std::cout << "I/O thread per save: " << flushMs / saveCount << " ms (off the game thread)" << std::endl;
+    std::cout << "Chunks on disk: " << onDisk << ", mismatches: " << mismatches << std::endl;
+
+    std::filesystem::remove_all(directory);
+    return (mismatches == 0 && stats.writeErrors == 0) ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+// bench/brick_bench.cpp
+// Measures brick map storage for far chunks (see BrickMap.h): memory per loaded area with every
+// chunk dense versus every chunk compact, conversion speed both ways, and getBlock throughput on
+// each. Checks every chunk survives the dense -> compact -> dense round trip exactly and that
+// getBlock reads the same world either way.
+// Usage: brick_bench [chunksPerSide]
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "BrickMap.h"
+
+// Sums getBlock over the whole area, so the reads can't be optimised away
+static uint64_t ReadArea(const World& world, int chunksPerSide) {
+    uint64_t sum = 0;
+    const int side = chunksPerSide * CHUNK_SIZE;
+    for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+        for (int x = 0; x < side; ++x) {
+            for (int z = 0; z < side; ++z) {
+                sum += world.getBlock(x, y, z);
+            }
+        }
+    }
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    const int chunksPerSide = (argc > 1) ? std::atoi(argv[1]) : 24;
+
+    TerrainGenerator generator;
+    World world;
+    std::vector<std::unique_ptr<Chunk>> originals;
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+            chunk->chunkX = cx;
+            chunk->chunkZ = cz;
+            generator.GenerateChunk(*chunk);
+            originals.push_back(std::make_unique<Chunk>(*chunk));
+            world.InsertChunk(std::move(chunk));
+        }
+    }
+    const size_t chunkCount = originals.size();
+
+    // --- Dense ---
+    const size_t denseBytes = world.ChunkMemoryBytes();
+    auto start = std::chrono::steady_clock::now();
+    const uint64_t denseSum = ReadArea(world, chunksPerSide);
+    double denseReadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // --- Compact ---
+    start = std::chrono::steady_clock::now();
+    for (const auto& chunk : originals) {
+        world.CompactChunk(chunk->chunkX, chunk->chunkZ);
+    }
+    double compactSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const size_t compactBytes = world.ChunkMemoryBytes();
+
+    start = std::chrono::steady_clock::now();
+    const uint64_t compactSum = ReadArea(world, chunksPerSide);
+    double compactReadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // --- Back to dense ---
+    start = std::chrono::steady_clock::now();
+    for (const auto& chunk : originals) {
+        world.ExpandChunk(chunk->chunkX, chunk->chunkZ);
+    }
+    double expandSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int mismatches = 0;
+    for (const auto& original : originals) {
+        const Chunk* chunk = world.GetChunk(original->chunkX, original->chunkZ);
+        if (!chunk || std::memcmp(chunk->blocks, original->blocks, sizeof(chunk->blocks)) != 0 ||
+            std::memcmp(chunk->fluidLevel, original->fluidLevel, sizeof(chunk->fluidLevel)) != 0) {
+            ++mismatches;
+        }
+    }
+
+    const double n = (double)chunkCount;
+    const double cells = n * CHUNK_VOLUME;
+    std::cout << "Chunks: " << chunkCount << std::endl;
+    std::cout << "Dense: " << denseBytes / 1024 << " KB (" << denseBytes / chunkCount << " bytes/chunk)" << std::endl;
+    std::cout << "Compact: " << compactBytes / 1024 << " KB (" << compactBytes / chunkCount << " bytes/chunk, "
+              << (double)denseBytes / compactBytes << "x smaller)" << std::endl;
+    std::cout << "Compact: " << compactSeconds / n * 1e6 << " us/chunk, expand: " << expandSeconds / n * 1e6 << " us/chunk" << std::endl;
+    std::cout << "getBlock dense: " << denseReadSeconds / cells * 1e9 << " ns, compact: " << compactReadSeconds / cells * 1e9
+              << " ns" << std::endl;
+    std::cout << "Round trip mismatches: " << mismatches << ", reads equal: " << (denseSum == compactSum ? "yes" : "NO") << std::endl;
+    return (mismatches == 0 && denseSum == compactSum) ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+// bench/cave_cull_bench.cpp
+// Measures cave culling (see CaveCulling.h) on generated terrain: meshes a square of chunks, then
+// runs the section search from a camera above the surface and one buried in the rock, and reports
+// the share of sections and opaque faces it keeps, the search time and the cost of building the
+// visibility sets at mesh time. Rays cast from the camera through the world check the result:
+// every surface a ray hits first must be in a kept section (a miss would be visible as a hole, and
+// fails the bench).
+// Usage: cave_cull_bench [chunksPerSide]
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "Mesher.h"
+#include "CaveCulling.h"
+
+struct ChunkFaces {
+    int64_t key;
+    int sectionVertexStart[SECTIONS + 1];
+};
+
+// First opaque cell along a ray (3D DDA over unit cells), or false if none within maxDistance
+static bool FirstOpaque(const World& world, glm::vec3 origin, glm::vec3 direction, float maxDistance, glm::ivec3& hit) {
+    glm::ivec3 cell((int)std::floor(origin.x), (int)std::floor(origin.y), (int)std::floor(origin.z));
+    glm::ivec3 step;
+    glm::vec3 next, delta;
+    for (int axis = 0; axis < 3; ++axis) {
+        step[axis] = direction[axis] >= 0.0f ? 1 : -1;
+        delta[axis] = direction[axis] != 0.0f ? std::fabs(1.0f / direction[axis]) : 1e30f;
+        const float boundary = (float)cell[axis] + (step[axis] > 0 ? 1.0f : 0.0f);
+        next[axis] = direction[axis] != 0.0f ? (boundary - origin[axis]) / direction[axis] : 1e30f;
+    }
+    float travelled = 0.0f;
+    while (travelled < maxDistance) {
+        if (cell.y < 0 || cell.y >= CHUNK_HEIGHT) return false;
+        if (world.isOpaque(cell.x, cell.y, cell.z)) {
+            hit = cell;
+            return true;
+        }
+        int axis = (next.x < next.y) ? (next.x < next.z ? 0 : 2) : (next.y < next.z ? 1 : 2);
+        travelled = next[axis];
+        next[axis] += delta[axis];
+        cell[axis] += step[axis];
+    }
+    return false;
+}
+
+// Returns the number of rays whose first opaque hit is in a culled section (must be 0)
+static int Report(const char* name, const World& world, CaveCuller& culler, const std::vector<ChunkFaces>& chunks,
+                   glm::vec3 camera, glm::vec3 forward, int maxDistance) {
+    auto start = std::chrono::steady_clock::now();
+    const int runs = 100;
+    for (int i = 0; i < runs; ++i) {
+        culler.Update(camera, forward, maxDistance);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / runs;
+
+    size_t totalFaces = 0, keptFaces = 0;
+    for (const ChunkFaces& chunk : chunks) {
+        const uint8_t sections = culler.VisibleSections(chunk.key);
+        for (int s = 0; s < SECTIONS; ++s) {
+            const int faces = (chunk.sectionVertexStart[s + 1] - chunk.sectionVertexStart[s]) / 6;
+            totalFaces += faces;
+            if (sections & (1u << s)) keptFaces += faces;
+        }
+    }
+
+    // Rays within 45 degrees of the view direction
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    const float forwardLength = std::sqrt(forward.x * forward.x + forward.y * forward.y + forward.z * forward.z);
+    int rays = 0, misses = 0;
+    while (rays < 20000) {
+        glm::vec3 direction(unit(rng), unit(rng), unit(rng));
+        const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+        if (length < 0.1f || length > 1.0f) continue;
+        direction = direction * (1.0f / length);
+        if (direction.x * forward.x + direction.y * forward.y + direction.z * forward.z < 0.7071f * forwardLength) continue;
+        ++rays;
+        glm::ivec3 hit;
+        // The search stops at maxDistance chunks (centre to centre); stay a chunk inside that
+        if (!FirstOpaque(world, camera, direction, (float)(maxDistance - 1) * CHUNK_SIZE, hit)) continue;
+        const int64_t key = World::ChunkKey(World::ToChunkCoord(hit.x), World::ToChunkCoord(hit.z));
+        if (!(culler.VisibleSections(key) & (1u << (hit.y / SECTION_HEIGHT)))) ++misses;
+    }
+
+    CaveCullStats stats = culler.GetStats();
+    std::cout << name << ": " << stats.visibleSections << "/" << stats.chunks * SECTIONS << " sections, "
+              << stats.visibleChunks << "/" << stats.chunks << " chunks, opaque faces kept " << keptFaces / 1000 << "k/"
+              << totalFaces / 1000 << "k (" << 100.0 * keptFaces / totalFaces << "%), search " << seconds * 1e6
+              << " us, ray misses " << misses << "/" << rays << std::endl;
+    return misses;
+}
+
+int main(int argc, char** argv) {
+    const int chunksPerSide = (argc > 1) ? std::atoi(argv[1]) : 33;
+    const int maxDistance = chunksPerSide / 2;
+
+    // Terrain block IDs (see TerrainSettings): stone, dirt and grass are opaque, water is not
+    TerrainGenerator generator;
+    World world;
+    for (BlockID id = 1; id <= 4; ++id) {
+        world.SetBlockOpacity(id, id != 3);
+        world.SetBlockTextureIndex(id, id - 1);
+    }
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+            chunk->chunkX = cx;
+            chunk->chunkZ = cz;
+            generator.GenerateChunk(*chunk);
+            world.InsertChunk(std::move(chunk));
+        }
+    }
+
+    CaveCuller culler;
+    std::vector<ChunkFaces> chunks;
+    ChunkMesh mesh;
+    double visibilitySeconds = 0.0;
+    uint16_t visibility[SECTIONS];
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            GenerateChunkMesh(world, cx, cz, mesh);
+            const int64_t key = World::ChunkKey(cx, cz);
+            culler.SetChunk(key, mesh.sectionVisibility);
+            ChunkFaces faces;
+            faces.key = key;
+            std::copy(mesh.sectionVertexStart, mesh.sectionVertexStart + SECTIONS + 1, faces.sectionVertexStart);
+            chunks.push_back(faces);
+
+            auto start = std::chrono::steady_clock::now();
+            ComputeSectionVisibility(world, *world.GetChunk(cx, cz), visibility);
+            visibilitySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+    std::cout << "Chunks: " << chunks.size() << ", visibility sets: " << visibilitySeconds / chunks.size() * 1e6
+              << " us/chunk at mesh time" << std::endl;
+
+    // Middle of the square: find the surface there
+    const int middle = chunksPerSide / 2 * CHUNK_SIZE + CHUNK_SIZE / 2;
+    int surface = CHUNK_HEIGHT - 1;
+    while (surface > 0 && !world.isOpaque(middle, surface, middle)) --surface;
+    const glm::vec3 level(1.0f, -0.2f, 0.3f);
+    int misses = Report("Above ground", world, culler, chunks, glm::vec3(middle + 0.5f, surface + 3.5f, middle + 0.5f), level, maxDistance);
+    misses += Report("Underground", world, culler, chunks, glm::vec3(middle + 0.5f, 5.5f, middle + 0.5f), level, maxDistance);
+    return misses == 0 ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+// bench/codec_bench.cpp
+// Compares chunk payload encodings on generated terrain: the original run-length codec, the
+// palette + run-length stage alone and palette + run-length + LZ (the region file codec).
+// Reports compression ratio against the in-memory chunk and MB/s (of chunk data) both ways,
+// and verifies every round trip.
+// Usage: codec_bench [chunks] [seed]
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "RegionFile.h"
+#include "ChunkCodec.h"
+
+typedef void (*EncodeFn)(const Chunk&, std::vector<uint8_t>&);
+typedef bool (*DecodeFn)(const uint8_t*, size_t, Chunk&);
+
+static const size_t CHUNK_DATA_BYTES = sizeof(Chunk::blocks) + sizeof(Chunk::fluidLevel);
+
+static bool Run(const char* name, EncodeFn encode, DecodeFn decode, const std::vector<std::unique_ptr<Chunk>>& chunks) {
+    std::vector<std::vector<uint8_t>> encoded(chunks.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        encode(*chunks[i], encoded[i]);
+    }
+    double encodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::unique_ptr<Chunk> decoded = std::make_unique<Chunk>();
+    int failures = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (!decode(encoded[i].data(), encoded[i].size(), *decoded)) ++failures;
+    }
+    double decodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Verification outside the timed loop
+    size_t totalBytes = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        totalBytes += encoded[i].size();
+        if (!decode(encoded[i].data(), encoded[i].size(), *decoded) ||
+            std::memcmp(decoded->blocks, chunks[i]->blocks, sizeof(decoded->blocks)) != 0 ||
+            std::memcmp(decoded->fluidLevel, chunks[i]->fluidLevel, sizeof(decoded->fluidLevel)) != 0) {
+            ++failures;
+        }
+    }
+
+    const double rawMB = (double)(CHUNK_DATA_BYTES * chunks.size()) / (1024.0 * 1024.0);
+    std::cout << name << ": " << (double)totalBytes / chunks.size() << " bytes/chunk, ratio "
+              << (double)(CHUNK_DATA_BYTES * chunks.size()) / totalBytes << ":1, encode "
+              << rawMB / encodeSeconds << " MB/s, decode " << rawMB / decodeSeconds << " MB/s, failures: "
+              << failures << std::endl;
+    return failures == 0;
+}
+
+static void EncodeBoth(const Chunk& chunk, std::vector<uint8_t>& out) { EncodeChunkCompressed(chunk, out); }
+
+int main(int argc, char** argv) {
+    const int chunkCount = (argc > 1) ? std::atoi(argv[1]) : 256;
+    TerrainSettings settings;
+    if (argc > 2) settings.seed = (uint32_t)std::strtoul(argv[2], nullptr, 10);
+    TerrainGenerator generator(settings);
+
+    // A square of terrain chunks, with some player-style edits and flowing water levels mixed in
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    int side = 1;
+    while (side * side < chunkCount) ++side;
+    unsigned int rng = 99;
+    for (int i = 0; i < chunkCount; ++i) {
+        std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+        chunk->chunkX = i % side;
+        chunk->chunkZ = i / side;
+        generator.GenerateChunk(*chunk);
+        for (int e = 0; e < 64; ++e) {
+            rng = rng * 1664525u + 1013904223u;
+            int index = (int)(rng >> 8) % CHUNK_VOLUME;
+            chunk->blocks[index] = (BlockID)(1 + (rng >> 28));
+            chunk->fluidLevel[index] = (uint8_t)((rng >> 24) & 7);
+        }
+        chunks.push_back(std::move(chunk));
+    }
+
+    std::cout << "Chunks: " << chunkCount << " (" << CHUNK_DATA_BYTES / 1024 << " KB of block + fluid data each)" << std::endl;
+    bool ok = true;
+    ok &= Run("RLE           ", EncodeChunkRLE, DecodeChunkRLE, chunks);
+    ok &= Run("Palette+RLE   ", EncodeChunkPalette, DecodeChunkPalette, chunks);
+    ok &= Run("Palette+RLE+LZ", EncodeBoth, DecodeChunkCompressed, chunks);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+// bench/collision_bench.cpp
+// Measures swept-AABB collision throughput: many bodies falling and sliding through a voxel world.
+// Usage: collision_bench [bodies] [ticks]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "World.h"
+#include "VoxelCollision.h"
+
+int main(int argc, char** argv) {
+    const int bodyCount = (argc > 1) ? std::atoi(argv[1]) : 10000;
+    const int tickCount = (argc > 2) ? std::atoi(argv[2]) : 600;
+    const int worldChunks = 4; // 4x4 chunk columns = 64x64 blocks
+    const float dt = 1.0f / 60.0f;
+
+    // --- Test World: a floor with scattered pillars so bodies hit walls as well as the ground ---
+    World world;
+    world.SetBlockOpacity(1, true);
+
+    std::mt19937 rng(1234);
+    for (int cx = 0; cx < worldChunks; ++cx) {
+        for (int cz = 0; cz < worldChunks; ++cz) {
+            world.CreateChunk(cx, cz);
+        }
+    }
+    const int extent = worldChunks * CHUNK_SIZE;
+    for (int x = 0; x < extent; ++x) {
+        for (int z = 0; z < extent; ++z) {
+            world.setBlock(x, 0, z, 1);
+            if (rng() % 10 == 0) {
+                int height = 1 + (int)(rng() % 6);
+                for (int y = 1; y <= height; ++y) {
+                    world.setBlock(x, y, z, 1);
+                }
+            }
+        }
+    }
+
+    // --- Bodies: random positions and velocities, including some very fast ones ---
+    std::uniform_real_distribution<float> posDist(2.0f, (float)extent - 2.0f);
+    std::uniform_real_distribution<float> heightDist(2.0f, (float)CHUNK_HEIGHT - 2.0f);
+    std::uniform_real_distribution<float> velDist(-8.0f, 8.0f);
+
+    std::vector<glm::vec3> positions(bodyCount);
+    std::vector<glm::vec3> velocities(bodyCount);
+    for (int i = 0; i < bodyCount; ++i) {
+        positions[i] = glm::vec3(posDist(rng), heightDist(rng), posDist(rng));
+        velocities[i] = glm::vec3(velDist(rng), velDist(rng) * ((i % 16 == 0) ? 40.0f : 1.0f), velDist(rng));
+    }
+    const glm::vec3 halfSize(0.3f, 0.9f, 0.3f);
+
+    // --- Run ---
+    long long sweeps = 0;
+    long long contacts = 0;
+    long long lookups = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < tickCount; ++t) {
+        for (int i = 0; i < bodyCount; ++i) {
+            velocities[i].y += -25.0f * dt;
+            AABBSweepResult sweep = SweepAABB(world, positions[i], halfSize, velocities[i], dt);
+            positions[i] = sweep.position;
+            velocities[i] = sweep.velocity;
+
+            // Keep bodies bouncing around the arena
+            if (sweep.grounded()) {
+                velocities[i].y = 6.0f;
+            }
+            if (sweep.normal.x != 0) velocities[i].x = -velDist(rng);
+            if (sweep.normal.z != 0) velocities[i].z = -velDist(rng);
+            if (positions[i].x < 1.0f || positions[i].x > extent - 1.0f) velocities[i].x = (positions[i].x < 1.0f) ? 4.0f : -4.0f;
+            if (positions[i].z < 1.0f || positions[i].z > extent - 1.0f) velocities[i].z = (positions[i].z < 1.0f) ? 4.0f : -4.0f;
+
+            ++sweeps;
+            contacts += sweep.hitAny() ? 1 : 0;
+            lookups += sweep.cellLookups;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Anything that ended up below the floor tunnelled through it
+    int escaped = 0;
+    for (int i = 0; i < bodyCount; ++i) {
+        if (positions[i].y - halfSize.y < 1.0f - 1e-3f) ++escaped;
+    }
+
+    std::cout << "Bodies: " << bodyCount << ", ticks: " << tickCount << std::endl;
+    std::cout << "Sweeps/sec:        " << (double)sweeps / seconds << std::endl;
+    std::cout << "Collisions/sec:    " << (double)contacts / seconds << std::endl;
+    std::cout << "Cell lookups/step: " << (double)lookups / (double)sweeps << std::endl;
+    std::cout << "Bodies through floor: " << escaped << std::endl;
+    std::cout << "Time: " << seconds * 1000.0 << " ms" << std::endl;
+
+    return (escaped == 0) ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+// bench/face_record_bench.cpp
+// Measures the upload size of chunk meshes as vertices and as face records (vertex pulling, see
+// PackFaceRecords) on a square of generated terrain, at full detail and at every LOD, and the
+// cost of packing. Every record is expanded back with WriteFace() and must give the vertices
+// it came from, which is what shaders/pulled.vs computes on the GPU.
+// Usage: face_record_bench [chunksPerSide]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "Mesher.h"
+
+// Rebuilds the vertex buffer from records as the vertex shader does
+static void ExpandRecords(const std::vector<uint32_t>& records, std::vector<float>& vertices) {
+    const int baseX = (int)records[0], baseZ = (int)records[1];
+    const size_t faceCount = (records.size() - FACE_RECORD_HEADER_WORDS) / FACE_RECORD_WORDS;
+    vertices.resize(faceCount * FACE_FLOATS);
+    for (size_t f = 0; f < faceCount; ++f) {
+        const uint32_t* record = records.data() + FACE_RECORD_HEADER_WORDS + f * FACE_RECORD_WORDS;
+        WriteFace(vertices.data() + f * FACE_FLOATS, (record[0] >> 14) & 7, baseX + (int)(record[0] & 15),
+                  (int)((record[0] >> 8) & 63), baseZ + (int)((record[0] >> 4) & 15), (float)(record[1] & 0xFFFF),
+                  record[1] >> 16, 1 << ((record[0] >> 17) & 3));
+    }
+}
+
+int main(int argc, char** argv) {
+    const int chunksPerSide = (argc > 1) ? std::atoi(argv[1]) : 16;
+
+    // Terrain block IDs (see TerrainSettings): stone, dirt and grass are opaque, water is not
+    TerrainGenerator generator;
+    World world;
+    for (BlockID id = 1; id <= 4; ++id) {
+        world.SetBlockOpacity(id, id != 3);
+        world.SetBlockTextureIndex(id, id - 1);
+    }
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+            chunk->chunkX = cx;
+            chunk->chunkZ = cz;
+            generator.GenerateChunk(*chunk);
+            world.InsertChunk(std::move(chunk));
+        }
+    }
+
+    ChunkMesh mesh;
+    std::vector<uint32_t> records;
+    std::vector<float> expanded;
+    size_t mismatches = 0;
+    for (int lod = 0; lod <= MAX_LOD; ++lod) {
+        size_t vertexBytes = 0, recordBytes = 0;
+        double packSeconds = 0.0;
+        for (int cx = 0; cx < chunksPerSide; ++cx) {
+            for (int cz = 0; cz < chunksPerSide; ++cz) {
+                const int neighbourLods[4] = { lod, lod, lod, lod };
+                GenerateLodChunkMesh(world, cx, cz, lod, neighbourLods, mesh);
+                for (const std::vector<float>* vertices : { &mesh.vertices, &mesh.translucentVertices }) {
+                    auto start = std::chrono::steady_clock::now();
+                    const bool packed = PackFaceRecords(*vertices, cx, cz, records);
+                    packSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    ExpandRecords(records, expanded);
+                    mismatches += (packed && expanded == *vertices) ? 0 : 1;
+                    vertexBytes += vertices->size() * sizeof(float);
+                    recordBytes += records.size() * sizeof(uint32_t);
+                }
+            }
+        }
+        const double n = (double)chunksPerSide * chunksPerSide;
+        std::cout << "LOD " << lod << ": vertices " << vertexBytes / n / 1024 << " KB/chunk, face records "
+                  << recordBytes / n / 1024 << " KB/chunk (" << (double)vertexBytes / recordBytes << "x smaller), pack "
+                  << packSeconds / n * 1e6 << " us/chunk" << std::endl;
+    }
+    std::cout << "Mismatching buffers: " << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+// bench/job_bench.cpp
+// Checks and times the job system (see JobSystem.h):
+//   - correctness: ParallelFor sums, children, a dependency diamond, MainThread jobs, jobs
+//     submitted from a thread that is not a worker, and the same execution order on every run
+//     in the deterministic (no worker) mode
+//   - overhead: create + run + wait of empty jobs, ParallelFor ranges and continuation chains,
+//     against starting and joining threads per batch (what the entity step used to do)
+// Usage: job_bench [workers] [jobs]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "JobSystem.h"
+
+static double NanosecondsSince(std::chrono::steady_clock::time_point start, double count) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+}
+
+// Empty jobs created and run in batches under a parent, then waited for
+static double EmptyJobCost(JobSystem& jobs, int jobCount) {
+    const int batch = JOB_POOL_SIZE / 2;
+    std::atomic<int> ran(0);
+    const auto start = std::chrono::steady_clock::now();
+    for (int done = 0; done < jobCount; done += batch) {
+        Job* parent = jobs.Create([] {});
+        for (int i = 0; i < batch; ++i) {
+            jobs.Run(jobs.CreateChild(parent, [&ran] { ran.fetch_add(1, std::memory_order_relaxed); }));
+        }
+        jobs.Run(parent);
+        jobs.Wait(parent);
+    }
+    const double cost = NanosecondsSince(start, ran.load());
+    return cost;
+}
+
+// Each job is the only continuation of the previous one
+static double ChainCost(JobSystem& jobs, int length) {
+    std::atomic<int> ran(0);
+    const auto start = std::chrono::steady_clock::now();
+    for (int done = 0; done < length; done += JOB_POOL_SIZE / 2) {
+        Job* first = jobs.Create([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+        Job* last = first;
+        for (uint32_t i = 1; i < JOB_POOL_SIZE / 2; ++i) {
+            Job* next = jobs.Create([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+            jobs.Depend(next, last);
+            jobs.Run(next);
+            last = next;
+        }
+        jobs.Run(first);
+        jobs.Wait(last);
+    }
+    return NanosecondsSince(start, ran.load());
+}
+
+// Records which job ran when, for a tree of children and a diamond of dependencies
+static std::vector<int> ExecutionOrder(JobSystem& jobs) {
+    std::vector<int> order;
+    std::mutex orderMutex;
+    auto record = [&](int id) {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.push_back(id);
+    };
+    Job* root = jobs.Create([&] { record(0); });
+    for (int i = 1; i <= 20; ++i) {
+        jobs.Run(jobs.CreateChild(root, [&, i] { record(i); }));
+    }
+    Job* after = jobs.Create([&] { record(100); });
+    jobs.Depend(after, root);
+    jobs.Run(after);
+    jobs.Run(root);
+    jobs.Wait(after);
+    jobs.ParallelFor(0, 64, 4, [&](uint32_t first, uint32_t) { record(200 + (int)first); });
+    return order;
+}
+
+int main(int argc, char** argv) {
+    const int workerCount = (argc > 1) ? std::atoi(argv[1]) : JobSystem::DefaultWorkerCount();
+    const int jobCount = (argc > 2) ? std::atoi(argv[2]) : 200000;
+    int failures = 0;
+    auto check = [&](bool ok, const char* what) {
+        std::cout << "  " << (ok ? "ok    " : "FAILED") << " " << what << std::endl;
+        if (!ok) ++failures;
+    };
+
+    JobSystem jobs(workerCount);
+    std::cout << "Job system: " << jobs.ThreadCount() << " threads (" << workerCount << " workers + main)" << std::endl;
+
+    // --- Correctness ---
+    std::vector<uint32_t> values(1 << 20);
+    for (uint32_t i = 0; i < values.size(); ++i) values[i] = i * 2654435761u;
+    uint64_t serialSum = 0;
+    for (uint32_t v : values) serialSum += v;
+    std::atomic<uint64_t> parallelSum(0);
+    jobs.ParallelFor(0, (uint32_t)values.size(), 1024, [&](uint32_t first, uint32_t last) {
+        uint64_t sum = 0;
+        for (uint32_t i = first; i < last; ++i) sum += values[i];
+        parallelSum.fetch_add(sum);
+    });
+    check(parallelSum.load() == serialSum, "ParallelFor sum matches the serial sum");
+
+    std::atomic<int> childrenRun(0);
+    Job* parent = jobs.Create([] {});
+    for (int i = 0; i < 500; ++i) {
+        jobs.Run(jobs.CreateChild(parent, [&] { childrenRun.fetch_add(1); }));
+    }
+    jobs.Run(parent);
+    jobs.Wait(parent);
+    check(childrenRun.load() == 500, "waiting for a parent waits for its children");
+
+    std::atomic<int> step(0);
+    int aAt = -1, bAt = -1, cAt = -1, dAt = -1;
+    Job* a = jobs.Create([&] { aAt = step.fetch_add(1); });
+    Job* b = jobs.Create([&] { bAt = step.fetch_add(1); });
+    Job* c = jobs.Create([&] { cAt = step.fetch_add(1); });
+    Job* d = jobs.Create([&] { dAt = step.fetch_add(1); });
+    jobs.Depend(b, a);
+    jobs.Depend(c, a);
+    jobs.Depend(d, b);
+    jobs.Depend(d, c);
+    jobs.Run(d);
+    jobs.Run(c);
+    jobs.Run(b);
+    jobs.Run(a);
+    jobs.Wait(d);
+    check(aAt == 0 && bAt > aAt && cAt > aAt && dAt == 3, "dependency diamond runs in order");
+
+    const std::thread::id mainId = std::this_thread::get_id();
+    std::atomic<int> onMain(0), mainJobs(0);
+    jobs.ParallelFor(0, 64, 1, [&](uint32_t, uint32_t) {
+        // Queued from the workers, run by the main thread while it waits
+        Job* gl = jobs.Create([&] {
+            mainJobs.fetch_add(1);
+            if (std::this_thread::get_id() == mainId) onMain.fetch_add(1);
+        });
+        jobs.Run(gl, JobAffinity::MainThread);
+    });
+    while (mainJobs.load() < 64) jobs.RunMainThreadJobs();
+    check(onMain.load() == 64, "MainThread jobs run on the main thread");
+
+    std::atomic<uint64_t> externalSum(0);
+    std::thread external([&] {
+        jobs.ParallelFor(0, (uint32_t)values.size(), 4096, [&](uint32_t first, uint32_t last) {
+            uint64_t sum = 0;
+            for (uint32_t i = first; i < last; ++i) sum += values[i];
+            externalSum.fetch_add(sum);
+        });
+    });
+    external.join();
+    check(externalSum.load() == serialSum, "ParallelFor from a thread that is not a worker");
+
+    {
+        JobSystem deterministic(0);
+        const std::vector<int> first = ExecutionOrder(deterministic);
+        bool same = true;
+        for (int run = 0; run < 5; ++run) {
+            same = same && ExecutionOrder(deterministic) == first;
+        }
+        check(same && first.size() == 38, "deterministic mode runs jobs in the same order every time");
+    }
+
+    // --- Overhead ---
+    std::cout << "Per job (create + run + wait, empty):" << std::endl;
+    {
+        JobSystem deterministic(0);
+        std::cout << "  deterministic:  " << EmptyJobCost(deterministic, jobCount) << " ns" << std::endl;
+        std::cout << "  chain link:     " << ChainCost(deterministic, jobCount / 4) << " ns (deterministic)" << std::endl;
+    }
+    std::cout << "  " << jobs.ThreadCount() << " threads:      " << EmptyJobCost(jobs, jobCount) << " ns" << std::endl;
+    std::cout << "  chain link:     " << ChainCost(jobs, jobCount / 4) << " ns" << std::endl;
+
+    const int batches = 2000;
+    const int ranges = std::max(2, jobs.ThreadCount());
+    std::atomic<int> touched(0);
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < batches; ++n) {
+        jobs.ParallelFor(0, ranges, 1, [&](uint32_t, uint32_t) { touched.fetch_add(1, std::memory_order_relaxed); });
+    }
+    const double parallelForNs = NanosecondsSince(start, batches);
+    start = std::chrono::steady_clock::now();
+    for (int n = 0; n < batches; ++n) {
+        std::vector<std::thread> threads;
+        for (int t = 1; t < ranges; ++t) {
+            threads.emplace_back([&] { touched.fetch_add(1, std::memory_order_relaxed); });
+        }
+        touched.fetch_add(1, std::memory_order_relaxed);
+        for (std::thread& thread : threads) thread.join();
+    }
+    const double threadsNs = NanosecondsSince(start, batches);
+    std::cout << "Batch of " << ranges << " ranges: ParallelFor " << parallelForNs / 1000.0 << " us, new threads "
+              << threadsNs / 1000.0 << " us (" << threadsNs / parallelForNs << "x)" << std::endl;
+
+    std::cout << (failures == 0 ? "All checks passed" : "Checks FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
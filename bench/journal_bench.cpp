@@ -0,0 +1,174 @@
+// bench/journal_bench.cpp
+// Measures the edit journal: the cost of Append() on the game thread and the write/fsync traffic
+// for each sync policy, then simulates a crash (segments left on disk) and checks that a new
+// session replays every edit - through LoadChunk() for chunks that stream in and through
+// background compaction into the region files for the rest - and keeps the old segments until the
+// streamed chunks have been saved too.
+// Usage: journal_bench [edits] [directory]
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "RegionFile.h"
+#include "EditJournal.h"
+
+static const char* PolicyName(JournalSync sync) {
+    switch (sync) {
+        case JournalSync::None:  return "none";
+        case JournalSync::Batch: return "batch";
+        case JournalSync::Edit:  return "edit";
+    }
+    return "?";
+}
+
+static int CountSegments(const std::string& directory) {
+    int count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.path().extension() == ".journal") ++count;
+    }
+    return count;
+}
+
+int main(int argc, char** argv) {
+    const int editCount = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const std::string directory = (argc > 2) ? argv[2] : "journal_bench_world";
+    const int chunksPerSide = 8;
+    const int worldBlocks = chunksPerSide * CHUNK_SIZE;
+
+    TerrainGenerator generator;
+    std::vector<JournalRecord> edits(editCount);
+    unsigned int rng = 2024;
+    for (JournalRecord& edit : edits) {
+        rng = rng * 1664525u + 1013904223u;
+        edit.x = (int)((rng >> 4) % (unsigned)worldBlocks) - worldBlocks / 2;
+        edit.z = (int)((rng >> 12) % (unsigned)worldBlocks) - worldBlocks / 2;
+        edit.y = (uint16_t)((rng >> 20) % CHUNK_HEIGHT);
+        edit.newID = (BlockID)(1 + (rng >> 28));
+    }
+
+    auto source = [&generator](Chunk& chunk) { generator.GenerateChunk(chunk); };
+
+    // --- Append cost per policy (the edit policy is capped: one fsync per edit) ---
+    uint64_t writeFailures = 0;
+    for (JournalSync sync : { JournalSync::None, JournalSync::Batch, JournalSync::Edit }) {
+        std::filesystem::remove_all(directory);
+        RegionStore store(directory);
+        EditJournal journal;
+        journal.Open(directory, sync, source, [&store](const Chunk& chunk) { return store.SaveChunk(chunk); },
+                     [&store]() { return store.Sync(); });
+
+        const int count = (sync == JournalSync::Edit) ? std::min(editCount, 500) : editCount;
+        double worstUs = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; ++i) {
+            auto editStart = std::chrono::steady_clock::now();
+            const JournalRecord& edit = edits[i];
+            if (!journal.WaitWritten(journal.Append(edit.x, edit.y, edit.z, 0, edit.newID, (uint64_t)i))) ++writeFailures;
+            worstUs = std::max(worstUs, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - editStart).count());
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        journal.Close();
+        JournalStats stats = journal.GetStats();
+        writeFailures += stats.writeFailures;
+        std::cout << "sync " << PolicyName(sync) << ": " << count << " edits, " << seconds * 1e6 / count << " us/edit avg, "
+                  << worstUs << " us worst, " << stats.bytesWritten / 1024 << " KB written, " << stats.fsyncs << " fsyncs, "
+                  << stats.writeFailures << " failed writes" << std::endl;
+    }
+
+    // --- Crash and replay ---
+    std::filesystem::remove_all(directory);
+    {
+        RegionStore store(directory);
+        EditJournal journal;
+        journal.Open(directory, JournalSync::Batch, source, [&store](const Chunk& chunk) { return store.SaveChunk(chunk); },
+                     [&store]() { return store.Sync(); });
+        for (int i = 0; i < editCount; ++i) {
+            journal.Append(edits[i].x, edits[i].y, edits[i].z, 0, edits[i].newID, (uint64_t)i);
+            if (i == editCount / 2) journal.Seal(); // Never discarded: the "autosave" did not finish
+        }
+        journal.Close(); // Segments stay on disk, as after a crash
+    }
+
+    // Expected world: generated terrain with every edit applied in order
+    World expected;
+    for (int cx = -chunksPerSide / 2; cx < chunksPerSide / 2; ++cx) {
+        for (int cz = -chunksPerSide / 2; cz < chunksPerSide / 2; ++cz) {
+            std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+            chunk->chunkX = cx;
+            chunk->chunkZ = cz;
+            generator.GenerateChunk(*chunk);
+            expected.InsertChunk(std::move(chunk));
+        }
+    }
+    for (const JournalRecord& edit : edits) {
+        expected.setBlock(edit.x, edit.y, edit.z, edit.newID);
+    }
+
+    int mismatches = 0;
+    int segmentsBeforeSave = 0;
+    double replaySeconds;
+    {
+        RegionStore store(directory);
+        EditJournal journal;
+        auto start = std::chrono::steady_clock::now();
+        journal.Open(directory, JournalSync::Batch,
+                     [&store, &generator](Chunk& chunk) { if (!store.LoadChunk(chunk)) generator.GenerateChunk(chunk); },
+                     [&store](const Chunk& chunk) { return store.SaveChunk(chunk); },
+                     [&store]() { return store.Sync(); });
+
+        // A few chunks "stream in" while compaction runs
+        std::vector<std::unique_ptr<Chunk>> streamed;
+        for (int c = -chunksPerSide / 2; c < chunksPerSide / 2; ++c) {
+            std::unique_ptr<Chunk> loaded = std::make_unique<Chunk>();
+            loaded->chunkX = c;
+            loaded->chunkZ = c;
+            journal.LoadChunk(*loaded);
+            if (std::memcmp(loaded->blocks, expected.GetChunk(c, c)->blocks, sizeof(loaded->blocks)) != 0) ++mismatches;
+            streamed.push_back(std::move(loaded));
+        }
+        journal.Close();
+        replaySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // The streamed chunks' edits only live in memory until the "world" saves them, so the old
+        // segments must still be there; once the saves are flushed and reported, they go
+        segmentsBeforeSave = CountSegments(directory);
+        std::vector<int64_t> saved;
+        for (const std::unique_ptr<Chunk>& chunk : streamed) {
+            if (store.SaveChunk(*chunk)) saved.push_back(World::ChunkKey(chunk->chunkX, chunk->chunkZ));
+        }
+        if (store.Sync()) journal.ChunksSaved(saved);
+    }
+
+    // Every chunk must be in the region files now, and the old segments gone
+    RegionStore check(directory);
+    Chunk loaded;
+    int compacted = 0;
+    for (int cx = -chunksPerSide / 2; cx < chunksPerSide / 2; ++cx) {
+        for (int cz = -chunksPerSide / 2; cz < chunksPerSide / 2; ++cz) {
+            loaded.chunkX = cx;
+            loaded.chunkZ = cz;
+            if (!check.LoadChunk(loaded) ||
+                std::memcmp(loaded.blocks, expected.GetChunk(cx, cz)->blocks, sizeof(loaded.blocks)) != 0) {
+                ++mismatches;
+            } else {
+                ++compacted;
+            }
+        }
+    }
+    const int segmentsLeft = CountSegments(directory);
+
+    std::cout << "Replay: " << editCount << " edits in " << replaySeconds * 1000.0 << " ms, "
+              << compacted << " chunks saved, " << segmentsBeforeSave << " segments kept until the streamed chunks were saved, "
+              << segmentsLeft << " segments left, mismatches: " << mismatches << std::endl;
+
+    std::filesystem::remove_all(directory);
+    return (mismatches == 0 && writeFailures == 0 && segmentsBeforeSave > 0 && segmentsLeft == 0) ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+// bench/lod_bench.cpp
+// Measures level-of-detail meshing: meshes a square of generated terrain around a camera in its
+// middle at full detail and with LODs chosen by ChunkLod(), and reports triangles and meshing time.
+// Per LOD band it also reports triangles per chunk times the squared distance to the camera (in
+// units of lodDistance), a proxy for triangles per screen area: it should stay roughly level.
+// Usage: lod_bench [chunksPerSide] [lodDistance]
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "Mesher.h"
+
+int main(int argc, char** argv) {
+    const int chunksPerSide = (argc > 1) ? std::atoi(argv[1]) : 48;
+    const int lodDistance = (argc > 2) ? std::atoi(argv[2]) : DEFAULT_LOD_DISTANCE;
+
+    // Terrain block IDs (see TerrainSettings): stone, dirt and grass are opaque, water is not
+    TerrainGenerator generator;
+    World world;
+    for (BlockID id = 1; id <= 4; ++id) {
+        world.SetBlockOpacity(id, id != 3);
+        world.SetBlockTextureIndex(id, id - 1);
+    }
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+            chunk->chunkX = cx;
+            chunk->chunkZ = cz;
+            generator.GenerateChunk(*chunk);
+            world.InsertChunk(std::move(chunk));
+        }
+    }
+    const glm::ivec2 cameraChunk(chunksPerSide / 2, chunksPerSide / 2);
+
+    ChunkMesh mesh;
+    size_t fullTriangles = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            GenerateChunkMesh(world, cx, cz, mesh);
+            fullTriangles += (mesh.opaqueVertexCount + mesh.translucentVertexCount) / 3;
+        }
+    }
+    double fullSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t lodTriangles = 0;
+    size_t bandChunks[MAX_LOD + 1] = {};
+    size_t bandTriangles[MAX_LOD + 1] = {};
+    double bandScreenTriangles[MAX_LOD + 1] = {};
+    start = std::chrono::steady_clock::now();
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            const int lod = ChunkLod(cx, cz, cameraChunk, lodDistance);
+            int neighbourLods[4];
+            for (int n = 0; n < 4; ++n) {
+                neighbourLods[n] = ChunkLod(cx + FACE_OFFSETS[2 + n][0], cz + FACE_OFFSETS[2 + n][2], cameraChunk, lodDistance);
+            }
+            GenerateLodChunkMesh(world, cx, cz, lod, neighbourLods, mesh);
+            const size_t triangles = (mesh.opaqueVertexCount + mesh.translucentVertexCount) / 3;
+            lodTriangles += triangles;
+
+            const double dx = cx - cameraChunk.x, dz = cz - cameraChunk.y;
+            const double distance = std::max(1.0, std::sqrt(dx * dx + dz * dz)) / std::max(1, lodDistance);
+            ++bandChunks[lod];
+            bandTriangles[lod] += triangles;
+            bandScreenTriangles[lod] += triangles * distance * distance;
+        }
+    }
+    double lodSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double n = (double)chunksPerSide * chunksPerSide;
+    std::cout << "Chunks: " << chunksPerSide * chunksPerSide << ", LOD distance " << lodDistance << std::endl;
+    std::cout << "Full detail: " << fullTriangles / 1000 << "k triangles, " << fullSeconds / n * 1e6 << " us/chunk" << std::endl;
+    std::cout << "With LOD: " << lodTriangles / 1000 << "k triangles (" << (double)fullTriangles / lodTriangles << "x fewer), "
+              << lodSeconds / n * 1e6 << " us/chunk" << std::endl;
+    for (int lod = 0; lod <= MAX_LOD; ++lod) {
+        if (bandChunks[lod] == 0) continue;
+        std::cout << "  LOD " << lod << ": " << bandChunks[lod] << " chunks, " << bandTriangles[lod] / bandChunks[lod]
+                  << " triangles/chunk, " << (size_t)(bandScreenTriangles[lod] / bandChunks[lod]) << " per screen area" << std::endl;
+    }
+    return (lodTriangles <= fullTriangles) ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+// bench/map_bench.cpp
+// Measures the memory-mapped read-only world: bakes a square of generated terrain, then compares
+// getting a playable world from it (Open + attach) with building the same chunks on the heap, and
+// getBlock() throughput / results between the two. Meshes are compared too, since the mesher reads
+// mapped chunks in place.
+// Usage: map_bench [chunksPerSide] [file]
+
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "MappedWorld.h"
+#include "Mesher.h"
+
+int main(int argc, char** argv) {
+    const int chunksPerSide = (argc > 1) ? std::atoi(argv[1]) : 32;
+    const std::string path = (argc > 2) ? argv[2] : "map_bench.map";
+    const int minChunk = -chunksPerSide / 2;
+
+    TerrainGenerator generator;
+    auto start = std::chrono::steady_clock::now();
+    bool baked = MappedWorld::Bake(path, minChunk, minChunk, chunksPerSide, chunksPerSide,
+                                   [&generator](Chunk& chunk) { generator.GenerateChunk(chunk); return true; });
+    double bakeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!baked) {
+        return 1;
+    }
+
+    // --- Heap world: every chunk generated and inserted (what streaming does, minus threads) ---
+    start = std::chrono::steady_clock::now();
+    World heapWorld;
+    for (int cx = minChunk; cx < minChunk + chunksPerSide; ++cx) {
+        for (int cz = minChunk; cz < minChunk + chunksPerSide; ++cz) {
+            std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+            chunk->chunkX = cx;
+            chunk->chunkZ = cz;
+            generator.GenerateChunk(*chunk);
+            heapWorld.InsertChunk(std::move(chunk));
+        }
+    }
+    double heapSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // --- Mapped world ---
+    start = std::chrono::steady_clock::now();
+    MappedWorld mapped;
+    if (!mapped.Open(path)) {
+        return 1;
+    }
+    World mappedWorld;
+    mappedWorld.AttachMappedWorld(&mapped);
+    double openSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // --- Random getBlock() over the whole area (first pass pages the map in) ---
+    const int extent = chunksPerSide * CHUNK_SIZE;
+    const int queries = 4000000;
+    auto Query = [&](const World& world, unsigned int seed, uint64_t& checksum) {
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < queries; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            int x = (int)((seed >> 4) % (unsigned)extent) + minChunk * CHUNK_SIZE;
+            int z = (int)((seed >> 14) % (unsigned)extent) + minChunk * CHUNK_SIZE;
+            int y = (int)(seed >> 26);
+            checksum = checksum * 31 + world.getBlock(x, y, z);
+        }
+        return queries / std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() / 1e6;
+    };
+    uint64_t heapSum = 0, mappedSum = 0, coldSum = 0;
+    double coldRate = Query(mappedWorld, 7, coldSum);
+    double heapRate = Query(heapWorld, 7, heapSum);
+    double mappedRate = Query(mappedWorld, 7, mappedSum);
+
+    // --- Meshes built from mapped chunks match the heap ones ---
+    int meshMismatches = 0;
+    ChunkMesh heapMesh, mappedMesh;
+    for (int c = minChunk; c < minChunk + chunksPerSide; c += 3) {
+        GenerateChunkMesh(heapWorld, c, c, heapMesh);
+        GenerateChunkMesh(mappedWorld, c, c, mappedMesh);
+        if (heapMesh.vertices != mappedMesh.vertices || heapMesh.translucentVertices != mappedMesh.translucentVertices) {
+            ++meshMismatches;
+        }
+    }
+
+    const bool match = heapSum == mappedSum && coldSum == mappedSum && meshMismatches == 0 &&
+                       mappedWorld.ChunkCount() == heapWorld.ChunkCount();
+    std::cout << "Chunks: " << mapped.ChunkCount() << ", map file: " << mapped.MappedBytes() / (1024 * 1024)
+              << " MB (baked in " << bakeSeconds << " s)" << std::endl;
+    std::cout << "World ready: heap " << heapSeconds * 1000.0 << " ms, mapped " << openSeconds * 1000.0 << " ms" << std::endl;
+    std::cout << "getBlock: heap " << heapRate << " M/s, mapped " << mappedRate << " M/s (" << coldRate
+              << " M/s while paging in)" << std::endl;
+    std::cout << "Results match: " << (match ? "yes" : "NO") << ", mesh mismatches: " << meshMismatches << std::endl;
+
+    mapped.Close();
+    std::remove(path.c_str());
+    return match ? 0 : 1;
+}
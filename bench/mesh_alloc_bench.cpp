@@ -0,0 +1,110 @@
+// bench/mesh_alloc_bench.cpp
+// Counts heap allocations on the remesh path: GenerateChunkMesh(), GenerateLodChunkMesh(), a mesh
+// cache round trip (EncodeMesh / DecodeMesh) and the translucent order reset + sort the upload
+// does, all into one reused ChunkMesh as the game does. After a warm-up pass that grows the
+// buffers to the largest chunk, every further remesh must allocate nothing. For comparison it
+// also counts a fresh ChunkMesh per chunk (a mesh returned by value).
+// Usage: mesh_alloc_bench [chunksPerSide] [rounds]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "Mesher.h"
+#include "MeshCache.h"
+
+static std::atomic<uint64_t> allocations(0);
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    const int chunksPerSide = (argc > 1) ? std::atoi(argv[1]) : 12;
+    const int rounds = (argc > 2) ? std::atoi(argv[2]) : 3;
+
+    // Terrain block IDs (see TerrainSettings): stone, dirt and grass are opaque, water is not
+    TerrainGenerator generator;
+    World world;
+    for (BlockID id = 1; id <= 4; ++id) {
+        world.SetBlockOpacity(id, id != 3);
+        world.SetBlockTextureIndex(id, id - 1);
+    }
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+            chunk->chunkX = cx;
+            chunk->chunkZ = cz;
+            generator.GenerateChunk(*chunk);
+            world.InsertChunk(std::move(chunk));
+        }
+    }
+
+    ChunkMesh mesh;
+    std::vector<uint8_t> payload;
+    std::vector<TranslucentOrder> orders(chunksPerSide * chunksPerSide); // One per chunk, as in the renderer
+    const glm::vec3 camera(chunksPerSide * CHUNK_SIZE * 0.5f, 40.0f, chunksPerSide * CHUNK_SIZE * 0.5f);
+    size_t remeshes = 0;
+    bool decoded = true;
+    auto remeshAll = [&]() {
+        for (int cx = 0; cx < chunksPerSide; ++cx) {
+            for (int cz = 0; cz < chunksPerSide; ++cz) {
+                TranslucentOrder& order = orders[cx * chunksPerSide + cz];
+                GenerateChunkMesh(world, cx, cz, mesh);
+                order.Reset(mesh.translucentFaceCenters);
+                order.Sort(camera);
+
+                MeshCache::EncodeMesh(mesh, cx, cz, 1, payload);
+                decoded = MeshCache::DecodeMesh(payload.data(), payload.size(), cx, cz, 1, mesh) && decoded;
+
+                const int neighbourLods[4] = { 1, 1, 1, 1 };
+                for (int lod = 1; lod <= MAX_LOD; ++lod) {
+                    GenerateLodChunkMesh(world, cx, cz, lod, neighbourLods, mesh);
+                }
+                GenerateChunkMesh(world, cx, cz, mesh); // Back to the largest mesh for the next chunk
+                remeshes += 3 + MAX_LOD;
+            }
+        }
+    };
+
+    remeshAll(); // Warm-up: buffers grow to the largest chunk
+    remeshes = 0;
+    const uint64_t before = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        remeshAll();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const uint64_t steadyAllocations = allocations.load() - before;
+
+    // A new mesh per chunk grows every buffer from nothing
+    const uint64_t freshBefore = allocations.load();
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            ChunkMesh fresh;
+            GenerateChunkMesh(world, cx, cz, fresh);
+        }
+    }
+    const double freshPerMesh = (double)(allocations.load() - freshBefore) / (chunksPerSide * chunksPerSide);
+
+    std::cout << "Remeshes: " << remeshes << " (" << seconds / remeshes * 1e6 << " us each)" << std::endl;
+    std::cout << "Reused mesh: " << steadyAllocations << " allocations after warm-up" << std::endl;
+    std::cout << "Fresh mesh per chunk: " << freshPerMesh << " allocations per mesh" << std::endl;
+    if (!decoded) {
+        std::cout << "Mesh cache round trip failed" << std::endl;
+    }
+    return (steadyAllocations == 0 && decoded) ? 0 : 1;
+}
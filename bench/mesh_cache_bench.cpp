@@ -0,0 +1,139 @@
+// bench/mesh_cache_bench.cpp
+// Measures the on-disk mesh cache against the mesher: meshes a square of generated terrain cold
+// (what a start without the cache does), stores every mesh, then loads them back through a fresh
+// cache (what the next start does) and checks each loaded mesh is identical to the generated one.
+// Also reports the key hashing cost (paid on every remesh) and the cache size on disk.
+// Usage: mesh_cache_bench [chunksPerSide] [directory]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "Mesher.h"
+#include "MeshCache.h"
+
+static uintmax_t DirectorySize(const std::string& directory) {
+    uintmax_t total = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        total += entry.file_size();
+    }
+    return total;
+}
+
+int main(int argc, char** argv) {
+    const int chunksPerSide = (argc > 1) ? std::atoi(argv[1]) : 24;
+    const std::string directory = (argc > 2) ? argv[2] : "mesh_cache_bench";
+    std::filesystem::remove_all(directory);
+
+    // Terrain block IDs (see TerrainSettings): stone, dirt and grass are opaque, water is not
+    TerrainGenerator generator;
+    World world;
+    for (BlockID id = 1; id <= 4; ++id) {
+        world.SetBlockOpacity(id, id != 3);
+        world.SetBlockTextureIndex(id, id - 1);
+    }
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+            chunk->chunkX = cx;
+            chunk->chunkZ = cz;
+            generator.GenerateChunk(*chunk);
+            world.InsertChunk(std::move(chunk));
+        }
+    }
+    // The inner chunks: the ones with all four neighbours loaded
+    std::vector<int64_t> keys;
+    for (int cx = 1; cx < chunksPerSide - 1; ++cx) {
+        for (int cz = 1; cz < chunksPerSide - 1; ++cz) {
+            keys.push_back(World::ChunkKey(cx, cz));
+        }
+    }
+
+    MeshCache cache;
+    cache.Open(directory, world);
+
+    // --- Keys ---
+    std::vector<uint64_t> meshKeys(keys.size());
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        meshKeys[i] = cache.MeshKey(world, World::ChunkKeyX(keys[i]), World::ChunkKeyZ(keys[i]));
+    }
+    double keySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // --- Cold: mesh everything ---
+    std::vector<ChunkMesh> generated(keys.size());
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        GenerateChunkMesh(world, World::ChunkKeyX(keys[i]), World::ChunkKeyZ(keys[i]), generated[i]);
+    }
+    double meshSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Store() is the game thread's share; compression and writing happen on the I/O thread
+    double storeSeconds = 0.0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        start = std::chrono::steady_clock::now();
+        cache.Store(World::ChunkKeyX(keys[i]), World::ChunkKeyZ(keys[i]), meshKeys[i], generated[i]);
+        storeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if ((i + 1) % (MESH_CACHE_MAX_PENDING / 2) == 0) {
+            cache.Flush(); // The game stores a few meshes a frame; don't let the queue drop any here
+        }
+    }
+    cache.Close();
+
+    std::vector<uint8_t> payload;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        MeshCache::EncodeMesh(generated[i], World::ChunkKeyX(keys[i]), World::ChunkKeyZ(keys[i]), meshKeys[i], payload);
+    }
+    double encodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const uintmax_t cacheBytes = DirectorySize(directory);
+
+    // --- Warm: load everything through a fresh cache (region files opened and read again) ---
+    MeshCache warmCache;
+    warmCache.Open(directory, world);
+    ChunkMesh loaded;
+    int mismatches = 0;
+    double loadSeconds = 0.0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        start = std::chrono::steady_clock::now();
+        bool hit = warmCache.Load(World::ChunkKeyX(keys[i]), World::ChunkKeyZ(keys[i]), meshKeys[i], loaded);
+        loadSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (!hit || loaded.vertices != generated[i].vertices || loaded.translucentVertices != generated[i].translucentVertices ||
+            loaded.translucentFaceCenters != generated[i].translucentFaceCenters ||
+            loaded.opaqueVertexCount != generated[i].opaqueVertexCount ||
+            loaded.translucentVertexCount != generated[i].translucentVertexCount ||
+            !std::equal(loaded.sectionVertexStart, loaded.sectionVertexStart + SECTIONS + 1, generated[i].sectionVertexStart) ||
+            !std::equal(loaded.sectionVisibility, loaded.sectionVisibility + SECTIONS, generated[i].sectionVisibility)) {
+            ++mismatches;
+        }
+    }
+
+    // --- An edit changes the key of its chunk and of the neighbour sharing the face ---
+    world.setBlock(2 * CHUNK_SIZE, 1, 2 * CHUNK_SIZE + 5, 0);
+    const bool editMisses = !warmCache.Load(2, 2, warmCache.MeshKey(world, 2, 2), loaded) &&
+                            !warmCache.Load(1, 2, warmCache.MeshKey(world, 1, 2), loaded) &&
+                            warmCache.MeshKey(world, 3, 2) == meshKeys[(3 - 1) * (chunksPerSide - 2) + (2 - 1)];
+    MeshCacheStats stats = warmCache.GetStats();
+    warmCache.Close();
+
+    const double n = (double)keys.size();
+    std::cout << "Chunks: " << keys.size() << ", cache: " << cacheBytes / 1024 << " KB ("
+              << cacheBytes / keys.size() << " bytes/chunk on disk)" << std::endl;
+    std::cout << "Mesh key: " << keySeconds / n * 1e6 << " us/chunk" << std::endl;
+    std::cout << "Meshing (cold start): " << meshSeconds * 1000.0 << " ms, " << meshSeconds / n * 1e6 << " us/chunk" << std::endl;
+    std::cout << "Cache load (warm start): " << loadSeconds * 1000.0 << " ms, " << loadSeconds / n * 1e6
+              << " us/chunk (" << meshSeconds / loadSeconds << "x faster)" << std::endl;
+    std::cout << "Store: " << storeSeconds / n * 1e6 << " us/chunk on the game thread, full encode "
+              << encodeSeconds / n * 1e6 << " us/chunk" << std::endl;
+    std::cout << "Hits: " << stats.hits << ", misses: " << stats.misses << ", mismatches: " << mismatches
+              << ", edit invalidates: " << (editMisses ? "yes" : "NO") << std::endl;
+
+    std::filesystem::remove_all(directory);
+    return (mismatches == 0 && editMisses) ? 0 : 1;
+}
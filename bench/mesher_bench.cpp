@@ -0,0 +1,135 @@
+// bench/mesher_bench.cpp
+// Measures GenerateChunkMesh() (opacity bitmasks) against the per-block loop it replaced, which
+// looked up the six neighbours of every block through World::getBlock(), on a square of generated
+// terrain. Both must produce the same vertices, translucent faces and section ranges. The section
+// visibility flood fill (shared by both) is timed separately.
+// Usage: mesher_bench [chunksPerSide] [rounds]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "Mesher.h"
+
+// The previous GenerateChunkMesh() face loop, kept as the reference
+static void ReferenceChunkMesh(const World& world, int chunkX, int chunkZ, ChunkMesh& mesh) {
+    mesh.vertices.clear();
+    mesh.translucentVertices.clear();
+    mesh.translucentFaceCenters.clear();
+    const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
+    const int baseX = chunkX * CHUNK_SIZE;
+    const int baseZ = chunkZ * CHUNK_SIZE;
+    for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+        if (y % SECTION_HEIGHT == 0) {
+            mesh.sectionVertexStart[y / SECTION_HEIGHT] = (int)(mesh.vertices.size() / VERTEX_ATTRIBUTES);
+        }
+        for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+            for (int lz = 0; lz < CHUNK_SIZE; ++lz) {
+                BlockID id = chunk->blocks[Chunk::Index(lx, y, lz)];
+                if (id == 0) continue;
+                const int x = baseX + lx;
+                const int z = baseZ + lz;
+                const bool opaque = world.isOpaqueID(id);
+                unsigned int texIndex = world.GetTextureIndex(id);
+                for (int face = 0; face < 6; ++face) {
+                    BlockID neighborId = world.getBlock(x + FACE_OFFSETS[face][0], y + FACE_OFFSETS[face][1], z + FACE_OFFSETS[face][2]);
+                    if (world.isOpaqueID(neighborId)) continue;
+                    if (opaque) {
+                        AppendFace(mesh.vertices, face, x, y, z, (float)id, texIndex);
+                    } else if (neighborId != id) {
+                        AppendFace(mesh.translucentVertices, face, x, y, z, (float)id, texIndex);
+                        mesh.translucentFaceCenters.push_back(FaceCenter(face, x, y, z));
+                    }
+                }
+            }
+        }
+    }
+    mesh.opaqueVertexCount = (int)(mesh.vertices.size() / VERTEX_ATTRIBUTES);
+    mesh.translucentVertexCount = (int)(mesh.translucentVertices.size() / VERTEX_ATTRIBUTES);
+    mesh.sectionVertexStart[SECTIONS] = mesh.opaqueVertexCount;
+}
+
+static bool SameMesh(const ChunkMesh& a, const ChunkMesh& b) {
+    if (a.vertices != b.vertices || a.translucentVertices != b.translucentVertices ||
+        a.translucentFaceCenters != b.translucentFaceCenters) {
+        return false;
+    }
+    for (int s = 0; s <= SECTIONS; ++s) {
+        if (a.sectionVertexStart[s] != b.sectionVertexStart[s]) return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const int chunksPerSide = (argc > 1) ? std::atoi(argv[1]) : 16;
+    const int rounds = (argc > 2) ? std::atoi(argv[2]) : 5;
+
+    // Terrain block IDs (see TerrainSettings): stone, dirt and grass are opaque, water is not
+    TerrainGenerator generator;
+    World world;
+    for (BlockID id = 1; id <= 4; ++id) {
+        world.SetBlockOpacity(id, id != 3);
+        world.SetBlockTextureIndex(id, id - 1);
+    }
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+            chunk->chunkX = cx;
+            chunk->chunkZ = cz;
+            generator.GenerateChunk(*chunk);
+            world.InsertChunk(std::move(chunk));
+        }
+    }
+
+    // Correctness first (border chunks included: their neighbours are unloaded and read as air)
+    ChunkMesh reference, mesh;
+    size_t mismatches = 0, faces = 0;
+    for (int cx = 0; cx < chunksPerSide; ++cx) {
+        for (int cz = 0; cz < chunksPerSide; ++cz) {
+            ReferenceChunkMesh(world, cx, cz, reference);
+            GenerateChunkMesh(world, cx, cz, mesh);
+            mismatches += SameMesh(reference, mesh) ? 0 : 1;
+            faces += (mesh.opaqueVertexCount + mesh.translucentVertexCount) / 6;
+        }
+    }
+
+    double referenceSeconds = 0.0, bitmaskSeconds = 0.0, visibilitySeconds = 0.0;
+    uint16_t visibility[SECTIONS];
+    for (int round = 0; round < rounds; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        for (int cx = 0; cx < chunksPerSide; ++cx) {
+            for (int cz = 0; cz < chunksPerSide; ++cz) {
+                ReferenceChunkMesh(world, cx, cz, reference);
+            }
+        }
+        auto middle = std::chrono::steady_clock::now();
+        for (int cx = 0; cx < chunksPerSide; ++cx) {
+            for (int cz = 0; cz < chunksPerSide; ++cz) {
+                GenerateChunkMesh(world, cx, cz, mesh);
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        for (int cx = 0; cx < chunksPerSide; ++cx) {
+            for (int cz = 0; cz < chunksPerSide; ++cz) {
+                ComputeSectionVisibility(world, *world.GetChunk(cx, cz), visibility);
+            }
+        }
+        visibilitySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - end).count();
+        referenceSeconds += std::chrono::duration<double>(middle - start).count();
+        bitmaskSeconds += std::chrono::duration<double>(end - middle).count();
+    }
+
+    const double n = (double)chunksPerSide * chunksPerSide * rounds;
+    const double faceMicros = (bitmaskSeconds - visibilitySeconds) / n * 1e6;
+    std::cout << "Chunks: " << chunksPerSide * chunksPerSide << ", " << faces / (chunksPerSide * chunksPerSide) << " faces/chunk" << std::endl;
+    std::cout << "Per-block getBlock loop: " << referenceSeconds / n * 1e6 << " us/chunk (faces only)" << std::endl;
+    std::cout << "Bitmask mesher: " << bitmaskSeconds / n * 1e6 << " us/chunk, of which section visibility "
+              << visibilitySeconds / n * 1e6 << " us; faces " << faceMicros << " us ("
+              << referenceSeconds / n * 1e6 / faceMicros << "x faster)" << std::endl;
+    std::cout << "Mismatching meshes: " << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+// bench/region_bench.cpp
+// Measures region file I/O: saves a square of generated chunks, reloads them from several threads
+// (verifying every block), then re-saves edited chunks to check that freed sectors are reused.
+// Usage: region_bench [chunksPerSide] [threads] [directory]
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "RegionFile.h"
+
+static uintmax_t DirectorySize(const std::string& directory) {
+    uintmax_t total = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        total += entry.file_size();
+    }
+    return total;
+}
+
+int main(int argc, char** argv) {
+    const int chunksPerSide = (argc > 1) ? std::atoi(argv[1]) : 32;
+    const int threadCount = (argc > 2) ? std::atoi(argv[2]) : 4;
+    const std::string directory = (argc > 3) ? argv[3] : "region_bench_world";
+    const int chunkCount = chunksPerSide * chunksPerSide;
+
+    std::filesystem::remove_all(directory);
+    TerrainGenerator generator;
+
+    // --- Reference chunks (centred on the origin, so they span several region files) ---
+    std::vector<Chunk> chunks(chunkCount);
+    for (int i = 0; i < chunkCount; ++i) {
+        chunks[i].chunkX = i % chunksPerSide - chunksPerSide / 2;
+        chunks[i].chunkZ = i / chunksPerSide - chunksPerSide / 2;
+        generator.GenerateChunk(chunks[i]);
+    }
+
+    // --- Save ---
+    RegionStore store(directory);
+    auto start = std::chrono::steady_clock::now();
+    for (const Chunk& chunk : chunks) {
+        store.SaveChunk(chunk);
+    }
+    double saveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const uintmax_t savedBytes = DirectorySize(directory);
+
+    // --- Parallel load (fresh store, so every region file is opened and read from disk) ---
+    RegionStore loadStore(directory);
+    std::vector<int> failures(threadCount, 0);
+    start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t] {
+            Chunk loaded;
+            for (int i = t; i < chunkCount; i += threadCount) {
+                loaded.chunkX = chunks[i].chunkX;
+                loaded.chunkZ = chunks[i].chunkZ;
+                if (!loadStore.LoadChunk(loaded) ||
+                    std::memcmp(loaded.blocks, chunks[i].blocks, sizeof(loaded.blocks)) != 0) {
+                    ++failures[t];
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    int failed = 0;
+    for (int f : failures) failed += f;
+
+    // --- Edit and re-save every chunk, then re-save it unchanged: with copy-on-write each save moves
+    // the chunk, so the file only stays the same size if freed sectors are being reused ---
+    for (Chunk& chunk : chunks) {
+        for (int i = 0; i < CHUNK_VOLUME; i += 97) chunk.blocks[i] = 5;
+        loadStore.SaveChunk(chunk);
+    }
+    const uintmax_t editedBytes = DirectorySize(directory);
+    for (int pass = 0; pass < 3; ++pass) {
+        for (const Chunk& chunk : chunks) {
+            loadStore.SaveChunk(chunk);
+        }
+    }
+    const uintmax_t resavedBytes = DirectorySize(directory);
+
+    std::cout << "Chunks: " << chunkCount << ", load threads: " << threadCount << std::endl;
+    std::cout << "Save: " << chunkCount / saveSeconds << " chunks/sec, " << savedBytes / 1024 << " KB on disk ("
+              << (double)savedBytes / chunkCount / 1024.0 << " KB/chunk vs " << sizeof(Chunk) / 1024 << " KB in memory)" << std::endl;
+    std::cout << "Load: " << chunkCount / loadSeconds << " chunks/sec, mismatches: " << failed << std::endl;
+    std::cout << "After edits: " << editedBytes / 1024 << " KB on disk, after 3 more re-saves: "
+              << resavedBytes / 1024 << " KB" << std::endl;
+
+    std::filesystem::remove_all(directory);
+    return failed == 0 ? 0 : 1;
+}
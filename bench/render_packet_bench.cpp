@@ -0,0 +1,119 @@
+// bench/render_packet_bench.cpp
+// Frame time with the frame built and drawn in turn on one thread, and pipelined through a
+// RenderPacketQueue (the game thread builds frame N+1 while the render thread draws frame N).
+// Building a frame remeshes a few chunks into the packet's uploads and lists every chunk to
+// draw, as the game does; drawing checks that the packets arrive in order and sleeps for the
+// given time in place of GL submission and the buffer swap (a render thread mostly waits on the
+// driver). Pipelined, a frame costs about the longer of the two instead of their sum.
+// Usage: render_packet_bench [frames] [remeshesPerFrame] [drawMilliseconds]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "World.h"
+#include "TerrainGen.h"
+#include "Mesher.h"
+#include "RenderPacket.h"
+
+static const int CHUNKS_PER_SIDE = 8;
+
+int main(int argc, char** argv) {
+    const int frames = (argc > 1) ? std::atoi(argv[1]) : 120;
+    const int remeshesPerFrame = (argc > 2) ? std::atoi(argv[2]) : 4;
+    const int drawMilliseconds = (argc > 3) ? std::atoi(argv[3]) : 4;
+
+    // Terrain block IDs (see TerrainSettings): stone, dirt and grass are opaque, water is not
+    TerrainGenerator generator;
+    World world;
+    for (BlockID id = 1; id <= 4; ++id) {
+        world.SetBlockOpacity(id, id != 3);
+        world.SetBlockTextureIndex(id, id - 1);
+    }
+    for (int cx = 0; cx < CHUNKS_PER_SIDE; ++cx) {
+        for (int cz = 0; cz < CHUNKS_PER_SIDE; ++cz) {
+            std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+            chunk->chunkX = cx;
+            chunk->chunkZ = cz;
+            generator.GenerateChunk(*chunk);
+            world.InsertChunk(std::move(chunk));
+        }
+    }
+
+    const int chunkCount = CHUNKS_PER_SIDE * CHUNKS_PER_SIDE;
+    uint64_t frameNumber = 0;
+    size_t nextChunk = 0;
+    auto buildFrame = [&](RenderPacket& packet) {
+        packet.Clear();
+        packet.frame = frameNumber++;
+        for (int i = 0; i < remeshesPerFrame; ++i, ++nextChunk) {
+            const int chunkX = (int)(nextChunk % chunkCount) / CHUNKS_PER_SIDE;
+            const int chunkZ = (int)(nextChunk % chunkCount) % CHUNKS_PER_SIDE;
+            ChunkUpload& upload = packet.NextUpload();
+            upload.key = World::ChunkKey(chunkX, chunkZ);
+            GenerateChunkMesh(world, chunkX, chunkZ, upload.mesh);
+            packet.CommitUpload();
+        }
+        for (int cx = 0; cx < CHUNKS_PER_SIDE; ++cx) {
+            for (int cz = 0; cz < CHUNKS_PER_SIDE; ++cz) {
+                packet.draws.push_back({ World::ChunkKey(cx, cz), ALL_SECTIONS });
+            }
+        }
+    };
+
+    uint64_t expectedFrame = 0;
+    size_t outOfOrder = 0, vertices = 0;
+    auto drawFrame = [&](const RenderPacket& packet) {
+        if (packet.frame != expectedFrame++ || packet.uploadCount != (size_t)remeshesPerFrame ||
+            packet.draws.size() != (size_t)chunkCount) {
+            ++outOfOrder;
+        }
+        for (size_t i = 0; i < packet.uploadCount; ++i) {
+            vertices += packet.uploads[i].mesh.vertices.size() / VERTEX_ATTRIBUTES;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(drawMilliseconds));
+    };
+
+    // --- One thread: build, then draw ---
+    RenderPacket packet;
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        buildFrame(packet);
+        drawFrame(packet);
+    }
+    const double serialMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+    const size_t serialVertices = vertices;
+
+    // --- Pipelined through the packet queue ---
+    frameNumber = 0;
+    nextChunk = 0;
+    expectedFrame = 0;
+    vertices = 0;
+    RenderPacketQueue queue;
+    start = std::chrono::steady_clock::now();
+    std::thread gameThread([&]() {
+        for (int f = 0; f < frames; ++f) {
+            RenderPacket* next = queue.BeginWrite();
+            if (next == nullptr) break;
+            buildFrame(*next);
+            queue.EndWrite();
+        }
+    });
+    for (int f = 0; f < frames; ++f) {
+        const RenderPacket* next = queue.BeginRead();
+        drawFrame(*next);
+        queue.EndRead();
+    }
+    gameThread.join();
+    const double pipelinedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    std::cout << frames << " frames, " << remeshesPerFrame << " remeshes each, " << drawMilliseconds << " ms draw" << std::endl;
+    std::cout << "  one thread: " << serialMs << " ms/frame" << std::endl;
+    std::cout << "  pipelined:  " << pipelinedMs << " ms/frame (" << serialMs / pipelinedMs << "x)" << std::endl;
+    std::cout << "  packets out of order: " << outOfOrder << ", vertices uploaded "
+              << (vertices == serialVertices ? "match" : "DIFFER") << std::endl;
+    return (outOfOrder == 0 && vertices == serialVertices) ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+// bench/spatial_hash_bench.cpp
+// Measures SpatialHash rebuild and query cost from 1k to 100k entities at constant density,
+// and checks query results against a brute-force scan.
+// Usage: spatial_hash_bench [queries]
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Entities.h"
+#include "SpatialHash.h"
+
+// Brute-force reference for the radius query
+static uint32_t BruteForceRadius(const EntityStore& e, glm::vec3 center, float radius) {
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < e.Count(); ++i) {
+        glm::vec3 pos = e.GetPosition(i);
+        glm::vec3 half = e.GetSize(i) * 0.5f;
+        glm::vec3 closest = glm::clamp(center, pos - half, pos + half);
+        glm::vec3 d = closest - center;
+        if (glm::dot(d, d) <= radius * radius) ++found;
+    }
+    return found;
+}
+
+int main(int argc, char** argv) {
+    const int queryCount = (argc > 1) ? std::atoi(argv[1]) : 10000;
+    const float density = 0.25f;   // Entities per square block
+    const float queryRadius = 3.0f; // Roughly a pickup / sensing radius
+    const int sizes[] = {1000, 10000, 100000};
+
+    SpatialHash grid(2.0f);
+    std::vector<uint32_t> results(4096); // Caller-owned result buffer, allocated once
+    bool allCorrect = true;
+
+    for (int count : sizes) {
+        const float extent = std::sqrt((float)count / density);
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> xz(0.0f, extent);
+        std::uniform_real_distribution<float> y(0.0f, 8.0f);
+
+        EntityStore entities;
+        for (int i = 0; i < count; ++i) {
+            glm::vec3 size = (i % 4) ? glm::vec3(0.25f) : glm::vec3(0.6f, 1.8f, 0.6f);
+            entities.Spawn(glm::vec3(xz(rng), y(rng), xz(rng)), size, ENTITY_ITEM);
+        }
+
+        // Warm up once so the timed builds reuse their arrays
+        grid.Build(entities);
+
+        const int buildRuns = 20;
+        auto buildStart = std::chrono::steady_clock::now();
+        for (int r = 0; r < buildRuns; ++r) {
+            grid.Build(entities);
+        }
+        double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count() / buildRuns;
+
+        // Queries centred on random entities (realistic: entities look around themselves)
+        std::uniform_int_distribution<uint32_t> pick(0, (uint32_t)count - 1);
+        long long neighbours = 0;
+        auto queryStart = std::chrono::steady_clock::now();
+        for (int q = 0; q < queryCount; ++q) {
+            glm::vec3 center = entities.GetPosition(pick(rng));
+            neighbours += grid.QueryRadius(center, queryRadius, results.data(), (uint32_t)results.size());
+        }
+        double querySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - queryStart).count();
+
+        // Spot-check against brute force
+        for (int q = 0; q < 50; ++q) {
+            glm::vec3 center = entities.GetPosition(pick(rng));
+            uint32_t expected = BruteForceRadius(entities, center, queryRadius);
+            uint32_t actual = grid.QueryRadius(center, queryRadius, results.data(), (uint32_t)results.size());
+            if (expected != actual) {
+                std::cout << "MISMATCH: expected " << expected << " got " << actual << std::endl;
+                allCorrect = false;
+            }
+        }
+
+        std::cout << count << " entities: build " << buildMs << " ms, "
+                  << (double)queryCount / querySeconds << " queries/sec, "
+                  << (double)neighbours / queryCount << " avg neighbours" << std::endl;
+    }
+
+    return allCorrect ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+// bench/terrain_bench.cpp
+// Measures terrain generation throughput (chunks/sec) for every noise instruction set the CPU
+// supports, and checks that they all generate exactly the same blocks.
+// Usage: terrain_bench [chunksPerSide] [seed]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "World.h"
+#include "TerrainGen.h"
+
+// FNV-1a over every block of every generated chunk
+static uint64_t HashBlocks(const Chunk& chunk, uint64_t hash) {
+    for (int i = 0; i < CHUNK_VOLUME; ++i) {
+        hash = (hash ^ chunk.blocks[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+int main(int argc, char** argv) {
+    const int chunksPerSide = (argc > 1) ? std::atoi(argv[1]) : 24;
+    const uint32_t seed = (argc > 2) ? (uint32_t)std::strtoul(argv[2], nullptr, 10) : 1337u;
+    const int chunkCount = chunksPerSide * chunksPerSide;
+
+    TerrainSettings settings;
+    settings.seed = seed;
+    TerrainGenerator generator(settings);
+    Chunk chunk;
+
+    const NoiseISA best = DetectNoiseISA();
+    std::cout << "Chunks: " << chunkCount << " (" << CHUNK_SIZE << "x" << CHUNK_HEIGHT << "x" << CHUNK_SIZE
+              << "), seed " << seed << ", best ISA: " << NoiseISAName(best) << std::endl;
+
+    uint64_t referenceHash = 0;
+    bool allMatch = true;
+    const NoiseISA isas[] = { NoiseISA::Scalar, NoiseISA::SSE41, NoiseISA::AVX2 };
+    for (NoiseISA isa : isas) {
+        if ((int)isa > (int)best) {
+            continue;
+        }
+        SetNoiseISA(isa);
+
+        uint64_t hash = 0xcbf29ce484222325ull;
+        size_t solid = 0, water = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int cx = 0; cx < chunksPerSide; ++cx) {
+            for (int cz = 0; cz < chunksPerSide; ++cz) {
+                chunk.chunkX = cx - chunksPerSide / 2;
+                chunk.chunkZ = cz - chunksPerSide / 2;
+                generator.GenerateChunk(chunk);
+                hash = HashBlocks(chunk, hash);
+                for (int i = 0; i < CHUNK_VOLUME; ++i) {
+                    if (chunk.blocks[i] == settings.waterID) ++water;
+                    else if (chunk.blocks[i] != 0) ++solid;
+                }
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (isa == NoiseISA::Scalar) {
+            referenceHash = hash;
+        } else if (hash != referenceHash) {
+            allMatch = false;
+        }
+        std::cout << NoiseISAName(isa) << ": " << chunkCount / seconds << " chunks/sec ("
+                  << seconds * 1000.0 / chunkCount << " ms per chunk), hash " << std::hex << hash << std::dec
+                  << ", solid " << solid << ", water " << water << std::endl;
+    }
+    SetNoiseISA(best);
+
+    std::cout << "All instruction sets identical: " << (allMatch ? "YES" : "NO") << std::endl;
+    return allMatch ? 0 : 1;
+}
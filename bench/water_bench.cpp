@@ -0,0 +1,109 @@
+// bench/water_bench.cpp
+// Measures water flow: sources poured into a walled basin, then left to spread and settle.
+// Reports cell updates/sec, the worst tick, and how many chunk remeshes the flow caused.
+// Fails unless the flow settles (nothing left pending) without any water outside the basin.
+// Usage: water_bench [sources] [ticks]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include "World.h"
+#include "Water.h"
+#include "Mesher.h"
+
+int main(int argc, char** argv) {
+    const int sourceCount = (argc > 1) ? std::atoi(argv[1]) : 64;
+    const int tickCount = (argc > 2) ? std::atoi(argv[2]) : 1200;
+    const int worldChunks = 8; // 8x8 chunk columns = 128x128 blocks
+    const BlockID STONE = 1;
+    const BlockID WATER = 2;
+
+    // --- Test World: a stone floor at y = 0 with a wall around the edge ---
+    World world;
+    world.SetBlockOpacity(STONE, true);
+    world.SetBlockFluid(WATER, true);
+    for (int cx = 0; cx < worldChunks; ++cx) {
+        for (int cz = 0; cz < worldChunks; ++cz) {
+            world.CreateChunk(cx, cz);
+        }
+    }
+    const int extent = worldChunks * CHUNK_SIZE;
+    for (int x = 0; x < extent; ++x) {
+        for (int z = 0; z < extent; ++z) {
+            world.setBlock(x, 0, z, STONE);
+            if (x == 0 || z == 0 || x == extent - 1 || z == extent - 1) {
+                world.setBlock(x, 1, z, STONE);
+                world.setBlock(x, 2, z, STONE);
+            }
+        }
+    }
+    std::vector<int64_t> dirty;
+    world.TakeDirtyChunks(dirty); // Terrain setup is not part of the measurement
+
+    // --- Sources: dropped from the top of the world so every one falls before spreading ---
+    WaterSimulation water;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> posDist(1, extent - 2);
+    uint64_t tick = 0;
+    for (int i = 0; i < sourceCount; ++i) {
+        int x = posDist(rng), z = posDist(rng), y = CHUNK_HEIGHT - 1;
+        world.setBlock(x, y, z, WATER);
+        water.OnBlockChanged(world, x, y, z, tick);
+    }
+
+    // --- Run: simulate, then remesh only what the flow dirtied (as the render loop would) ---
+    ChunkMesh mesh;
+    size_t remeshes = 0;
+    size_t busiestTick = 0;
+    double worstTick = 0.0, meshSeconds = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < tickCount; ++t) {
+        auto tickStart = std::chrono::steady_clock::now();
+        size_t updated = water.Update(world, ++tick);
+        worstTick = std::max(worstTick, std::chrono::duration<double>(std::chrono::steady_clock::now() - tickStart).count());
+        busiestTick = std::max(busiestTick, updated);
+
+        auto meshStart = std::chrono::steady_clock::now();
+        world.TakeDirtyChunks(dirty);
+        for (int64_t key : dirty) {
+            GenerateChunkMesh(world, World::ChunkKeyX(key), World::ChunkKeyZ(key), mesh);
+        }
+        remeshes += dirty.size();
+        meshSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - meshStart).count();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double simSeconds = seconds - meshSeconds;
+
+    // --- Check: the flow settles inside the walls, above the floor ---
+    const uint64_t settleLimit = tick + 10 * (uint64_t)tickCount;
+    while (water.PendingCount() > 0 && tick < settleLimit) {
+        water.Update(world, ++tick);
+    }
+    size_t waterCells = 0, escapedCells = 0;
+    for (int x = -1; x <= extent; ++x) {
+        for (int z = -1; z <= extent; ++z) {
+            const bool inside = x > 0 && z > 0 && x < extent - 1 && z < extent - 1;
+            for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+                if (world.getBlock(x, y, z) != WATER) continue;
+                ++waterCells;
+                if (!inside || y == 0) ++escapedCells;
+            }
+        }
+    }
+    const bool settled = water.PendingCount() == 0;
+
+    std::cout << "Sources: " << sourceCount << ", ticks: " << tickCount << std::endl;
+    std::cout << "Cells updated: " << water.TotalCellsUpdated() << " (busiest tick " << busiestTick
+              << ", still pending " << water.PendingCount() << ")" << std::endl;
+    std::cout << "Cell updates/sec: " << (double)water.TotalCellsUpdated() / simSeconds << std::endl;
+    std::cout << "Worst sim tick: " << worstTick * 1000.0 << " ms" << std::endl;
+    std::cout << "Chunk remeshes: " << remeshes << " (" << (remeshes ? meshSeconds * 1000.0 / remeshes : 0.0)
+              << " ms each)" << std::endl;
+    std::cout << "Water cells at end: " << waterCells << " (" << escapedCells << " outside the basin)" << std::endl;
+    std::cout << "Settled: " << (settled ? "yes" : "NO") << " after " << tick << " ticks" << std::endl;
+    std::cout << "60 Hz budget (16.7 ms): " << ((worstTick * 1000.0 < 1000.0 / 60.0) ? "OK" : "EXCEEDED") << std::endl;
+
+    return (settled && escapedCells == 0) ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+// include/AutoSave.h
+
+#ifndef AUTO_SAVE_H
+#define AUTO_SAVE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "World.h"
+#include "RegionFile.h"
+
+// --- Autosave Constants ---
+const double AUTOSAVE_INTERVAL = 30.0; // Seconds between autosaves
+
+struct AutoSaveStats {
+    size_t pendingChunks = 0;   // Snapshots waiting to be written
+    uint64_t chunksWritten = 0;
+    uint64_t writeErrors = 0;
+    double lastSnapshotMs = 0.0; // Time the world lock was held by the last SnapshotModified()
+};
+
+// Background chunk saver.
+//
+// SnapshotModified() runs on the game thread (under the world lock) and only copies chunks whose
+// version moved since their last save - a 48 KB memcpy each, from a pool of reused buffers -
+// then marks them saved. Encoding and region file writes happen on the I/O thread from those
+// immutable snapshots, so edits continue on the live chunks while the save is in progress.
+// A chunk edited again meanwhile simply gets a newer version and is picked up by the next save.
+//
+// Before an AfterWrites() callback runs, and when the saver stops, the written regions are flushed
+// (RegionStore::Sync), so callbacks can rely on the saves surviving power loss.
+class AutoSaver {
+public:
+    explicit AutoSaver(RegionStore& store);
+    ~AutoSaver();
+
+    AutoSaver(const AutoSaver&) = delete;
+    AutoSaver& operator=(const AutoSaver&) = delete;
+
+    // Queues a snapshot of every modified chunk and marks them saved. Returns the number queued.
+    size_t SnapshotModified(World& world);
+    // Queues a snapshot of one chunk (e.g. one about to be evicted), modified or not
+    void Enqueue(const Chunk& chunk);
+
+    // Runs done on the I/O thread once every snapshot queued so far is written and flushed.
+    // allSaved is false if any write or flush has failed since the saver started.
+    void AfterWrites(std::function<void(bool allSaved)> done);
+    // Called on the I/O thread after each flush with the chunks (World::ChunkKey) it made durable.
+    // Set before queueing anything.
+    void SetSavedCallback(std::function<void(const std::vector<int64_t>& keys)> saved);
+
+    // Copies the newest not-yet-written snapshot of (chunk.chunkX, chunk.chunkZ) into chunk.
+    // Streaming must check this before reading the region file, or it could load stale data for
+    // a chunk that was evicted and requested again before its save landed. Thread-safe.
+    bool ReadPending(Chunk& chunk) const;
+
+    // Blocks until every queued snapshot is on disk
+    void Flush();
+    // Flushes, then stops the I/O thread. Called by the destructor.
+    void Stop();
+
+    AutoSaveStats GetStats() const;
+
+private:
+    void IOLoop();
+    // Flushes the region files and reports savedKeys; I/O thread only. False if the flush failed.
+    bool SyncWrites();
+    std::unique_ptr<Chunk> AcquireSnapshot();
+
+    RegionStore& store;
+
+    mutable std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable queueDrained;
+    struct Pending {
+        std::unique_ptr<Chunk> snapshot;      // Null for an AfterWrites() callback
+        std::function<void(bool)> done;
+    };
+
+    std::deque<Pending> queue;                          // FIFO, so the newest snapshot of a chunk lands last
+    std::unordered_map<int64_t, const Chunk*> newest;   // Newest queued/in-flight snapshot per chunk
+    std::vector<std::unique_ptr<Chunk>> pool;           // Written snapshots, reused
+    bool writing = false;
+    bool stopping = false;
+    std::thread ioThread;
+    std::function<void(const std::vector<int64_t>&)> savedCallback;
+    std::vector<int64_t> savedKeys; // Written since the last flush (I/O thread only)
+
+    uint64_t chunksWritten = 0;
+    uint64_t writeErrors = 0;
+    double lastSnapshotMs = 0.0;
+};
+
+#endif
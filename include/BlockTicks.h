@@ -0,0 +1,57 @@
+// include/BlockTicks.h
+
+#ifndef BLOCK_TICKS_H
+#define BLOCK_TICKS_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include "World.h"
+
+// Scheduler for delayed block updates ("block ticks").
+//
+// Each chunk owns a min-heap of pending updates keyed by due tick. A cell can only have one pending
+// update at a time: scheduling it again keeps whichever is due first (later duplicates are
+// dropped, stale heap entries are skipped when popped). Nothing is scanned - only cells that
+// something explicitly scheduled are ever visited.
+class BlockTickScheduler {
+public:
+    // Schedules an update of block (x, y, z) at tick dueTick
+    void Schedule(int x, int y, int z, uint64_t dueTick);
+
+    // Pops every update due at or before currentTick, up to maxUpdates, into out (world coordinates).
+    // Updates beyond the budget stay queued and are returned by the next call. Chunks take turns:
+    // each call starts with the chunk after the one the last call stopped in, so a saturated budget
+    // still reaches every chunk.
+    size_t CollectDue(uint64_t currentTick, size_t maxUpdates, std::vector<glm::ivec3>& out);
+
+    // Drops every pending update of a chunk (e.g. when it is unloaded)
+    void ClearChunk(int chunkX, int chunkZ);
+
+    size_t PendingCount() const { return pendingTotal; }
+    // Keys (World::ChunkKey) of the chunks with pending updates
+    void GetChunkKeys(std::vector<int64_t>& out) const;
+
+private:
+    struct Entry {
+        uint64_t dueTick;
+        uint32_t localIndex; // Chunk::Index of the cell
+        bool operator>(const Entry& other) const { return dueTick > other.dueTick; }
+    };
+
+    struct ChunkQueue {
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+        std::unordered_map<uint32_t, uint64_t> pending; // localIndex -> due tick (deduplication)
+    };
+
+    static const int64_t NO_CHUNK_KEY = INT64_MIN;
+
+    std::unordered_map<int64_t, ChunkQueue> chunks;
+    int64_t nextChunkKey = NO_CHUNK_KEY; // Where the next CollectDue starts
+    size_t pendingTotal = 0;
+};
+
+#endif
@@ -0,0 +1,84 @@
+// include/BrickMap.h
+
+#ifndef BRICK_MAP_H
+#define BRICK_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "World.h"
+
+// --- Brick Map Layout ---
+// A chunk column is split into BRICK_SIZE^3 bricks. The top level holds one node per brick: either
+// a uniform value (every cell of the brick is the same, e.g. all air or all stone), or the number
+// of a dense brick of BRICK_VOLUME values. Bricks and their cells are ordered like Chunk::Index
+// (Y, then X, then Z). Block IDs and fluid levels are stored as two separate layers, so the fluid
+// layer of dry terrain collapses to uniform zero everywhere.
+const int BRICK_SIZE = 4;
+const int BRICK_VOLUME = BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+const int BRICKS_XZ = CHUNK_SIZE / BRICK_SIZE;
+const int BRICKS_Y = CHUNK_HEIGHT / BRICK_SIZE;
+const int BRICK_COUNT = BRICKS_XZ * BRICKS_Y * BRICKS_XZ;
+
+static_assert(CHUNK_SIZE % BRICK_SIZE == 0 && CHUNK_HEIGHT % BRICK_SIZE == 0, "Chunks must be whole bricks");
+
+// One per-cell channel of a chunk as a two-level brick map
+template <typename T>
+class BrickLayer {
+public:
+    // Builds the layer from a dense CHUNK_VOLUME array in Chunk::Index order
+    void Build(const T* cells);
+    // Writes the layer back into a dense array
+    void Expand(T* cells) const;
+
+    // x / z in [0, CHUNK_SIZE), y in [0, CHUNK_HEIGHT)
+    T Get(int x, int y, int z) const {
+        const uint32_t node = nodes[BrickIndex(x / BRICK_SIZE, y / BRICK_SIZE, z / BRICK_SIZE)];
+        if (node & UNIFORM) {
+            return (T)(node & ~UNIFORM);
+        }
+        return bricks[(size_t)node * BRICK_VOLUME + CellIndex(x % BRICK_SIZE, y % BRICK_SIZE, z % BRICK_SIZE)];
+    }
+
+    size_t DenseBrickCount() const { return bricks.size() / BRICK_VOLUME; }
+    size_t HeapBytes() const { return bricks.capacity() * sizeof(T); }
+
+    static int BrickIndex(int bx, int by, int bz) { return (by * BRICKS_XZ + bx) * BRICKS_XZ + bz; }
+    static int CellIndex(int x, int y, int z) { return (y * BRICK_SIZE + x) * BRICK_SIZE + z; }
+
+private:
+    static const uint32_t UNIFORM = 1u << 31;
+
+    uint32_t nodes[BRICK_COUNT] = {}; // UNIFORM | value, or dense brick number
+    std::vector<T> bricks;            // Dense bricks, BRICK_VOLUME values each
+};
+
+// A chunk column in brick map storage: the compact form World keeps far chunks in
+// (see World::CompactChunk). Read-only; it is expanded back to a Chunk before any edit.
+//
+// Far terrain is mostly uniform bricks - air above the surface, stone below it - so only the
+// bricks the surface, caves or water pass through are stored densely.
+class BrickChunk {
+public:
+    int chunkX = 0;
+    int chunkZ = 0;
+    uint32_t version = 0;
+    uint32_t savedVersion = 0;
+
+    void FromChunk(const Chunk& chunk);
+    void ToChunk(Chunk& chunk) const;
+
+    // Local coordinates, same ranges as Chunk::Index
+    BlockID GetBlock(int x, int y, int z) const { return blocks.Get(x, y, z); }
+    uint8_t GetFluidLevel(int x, int y, int z) const { return fluid.Get(x, y, z); }
+
+    size_t DenseBrickCount() const { return blocks.DenseBrickCount() + fluid.DenseBrickCount(); }
+    // Bytes held by this chunk, to compare with sizeof(Chunk)
+    size_t MemoryBytes() const { return sizeof(BrickChunk) + blocks.HeapBytes() + fluid.HeapBytes(); }
+
+private:
+    BrickLayer<BlockID> blocks;
+    BrickLayer<uint8_t> fluid;
+};
+
+#endif
@@ -0,0 +1,68 @@
+// include/CaveCulling.h
+
+#ifndef CAVE_CULLING_H
+#define CAVE_CULLING_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "World.h"
+#include "Mesher.h"
+
+// Every section of a chunk column (bit s = section s)
+const uint8_t ALL_SECTIONS = (uint8_t)((1u << SECTIONS) - 1);
+
+struct CaveCullStats {
+    size_t chunks = 0;          // Chunks in the graph
+    size_t visibleChunks = 0;   // With at least one visible section
+    size_t visibleSections = 0;
+};
+
+// CPU occlusion culling from the section visibility sets built at mesh time (see
+// ComputeSectionVisibility): a breadth-first search from the camera's section that only leaves a
+// section through a face connected (through air, water or glass) to the face it entered by.
+// It never steps back against a direction it has already travelled, nor into sections behind
+// the camera, so sight lines only bend outwards. Solid rock between the camera and a cave, or
+// the surface above an underground camera, stops the search: most underground geometry is never
+// drawn, with no GPU round trip and the same result for the same world and camera.
+//
+// Chunks without a mesh are not in the graph and stop the search (they have nothing to draw).
+class CaveCuller {
+public:
+    // Adds or replaces the visibility sets of a meshed chunk
+    void SetChunk(int64_t key, const uint16_t visibility[SECTIONS]);
+    void RemoveChunk(int64_t key);
+
+    // Searches from cameraPos out to maxDistance chunks. viewDirection need not be normalised.
+    void Update(glm::vec3 cameraPos, glm::vec3 viewDirection, int maxDistance);
+    // Sections of the chunk reached by the last Update(). Everything while the camera's own
+    // chunk is not in the graph (e.g. before it is meshed): the search has nowhere to start.
+    uint8_t VisibleSections(int64_t key) const {
+        if (!searched) return ALL_SECTIONS;
+        auto it = visible.find(key);
+        return it == visible.end() ? 0 : it->second;
+    }
+
+    CaveCullStats GetStats() const;
+
+private:
+    struct SectionVisibility {
+        uint16_t faces[SECTIONS];
+    };
+    struct Node {
+        int chunkX;
+        int section;
+        int chunkZ;
+        int enteredFace;    // Face (FACE_OFFSETS order) the search came in through, -1 at the start
+        uint8_t directions; // Faces crossed so far, as bits
+    };
+
+    std::unordered_map<int64_t, SectionVisibility> graph;
+    std::unordered_map<int64_t, uint8_t> visible;
+    std::unordered_map<int64_t, uint32_t> entered; // Bit section * 6 + face: searched from that face
+    std::vector<Node> queue;
+    bool searched = false;
+};
+
+#endif
@@ -0,0 +1,16 @@
+// include/Checksum.h
+
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+// FNV-1a, used for the simulation checksum (--record / --replay) and the headless image hash.
+// Not for anything that must resist deliberate collisions.
+const uint64_t CHECKSUM_BASIS = 14695981039346656037ull;
+
+// FNV-1a of size bytes, continuing from h (start from CHECKSUM_BASIS)
+uint64_t ChecksumBytes(uint64_t h, const void* data, size_t size);
+
+#endif
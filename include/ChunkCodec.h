@@ -0,0 +1,35 @@
+// include/ChunkCodec.h
+
+#ifndef CHUNK_CODEC_H
+#define CHUNK_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "World.h"
+
+// Voxel-specific chunk compression, in two stages:
+//
+// 1. Palette + run-length: the distinct block IDs of the chunk are listed once, then the blocks are
+//    written as (palette index, run length) varint pairs walking Chunk::blocks in its Y-major order,
+//    so whole stone / air layers collapse to one run. Fluid levels follow as (level, run) pairs.
+// 2. LZ: an LZ4-style byte coder (literal runs + 16-bit back-references) over the stage 1 output,
+//    which picks up the repeating patterns that runs alone miss (e.g. identical terrain columns).
+//
+// Used by the region files (REGION_CODEC_PALETTE_LZ); everything is in-tree.
+
+// --- Stage 1: palette + run-length ---
+void EncodeChunkPalette(const Chunk& chunk, std::vector<uint8_t>& out);
+bool DecodeChunkPalette(const uint8_t* data, size_t size, Chunk& chunk);
+
+// --- Stage 2: LZ byte coder ---
+// Appends the compressed form of data to out
+void LZCompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+// Decompresses into exactly outSize bytes. Returns false for corrupt input (never writes past out + outSize).
+bool LZDecompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize);
+
+// --- Both stages (uint32 stage 1 size, then the LZ stream) ---
+void EncodeChunkCompressed(const Chunk& chunk, std::vector<uint8_t>& out);
+bool DecodeChunkCompressed(const uint8_t* data, size_t size, Chunk& chunk);
+
+#endif
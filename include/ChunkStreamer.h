@@ -0,0 +1,135 @@
+// include/ChunkStreamer.h
+
+#ifndef CHUNK_STREAMER_H
+#define CHUNK_STREAMER_H
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "World.h"
+#include "TerrainGen.h"
+
+// --- Streaming Constants ---
+const int DEFAULT_VIEW_DISTANCE = 8;     // Chunks kept loaded around the camera (radius)
+const int EVICT_MARGIN = 2;              // Chunks are evicted this many chunks past the view distance (hysteresis)
+const int MAX_CHUNKS_INSERTED_PER_UPDATE = 8; // Finished chunks handed to the world per Update()
+const int DEFAULT_COMPACT_DISTANCE = 4;  // Chunks further than this from the camera are kept compact (0 = never)
+const int MAX_CHUNKS_COMPACTED_PER_UPDATE = 16; // Conversions to / from compact storage per Update()
+
+struct StreamerStats {
+    size_t residentChunks = 0;
+    size_t compactChunks = 0;   // Resident chunks in brick map storage
+    size_t residentBytes = 0;   // Block + fluid data of the resident chunks (meshes not included)
+    size_t queuedChunks = 0;    // Waiting for a worker
+    size_t inFlightChunks = 0;  // Being generated / loaded, or finished but not yet in the world
+    double loadRate = 0.0;      // Chunks inserted per second (over the last second)
+    uint64_t totalLoaded = 0;
+    uint64_t totalEvicted = 0;
+};
+
+// Keeps the chunks within a radius of the camera loaded.
+//
+// Update() (called once per frame from the thread that owns the world) works out which chunks are
+// missing and queues them, nearest first and favouring the view direction. Worker threads build
+// each chunk into a private Chunk - they never touch the World - and Update() later moves finished
+// chunks into the world a few at a time, so the render loop never waits on generation.
+// Chunks that fall outside the radius (plus a margin) are evicted. Chunks beyond the compact
+// distance are converted to brick maps (World::CompactChunk) and back to dense storage when the
+// camera comes within a chunk of that distance again.
+class ChunkStreamer {
+public:
+    // Optional hook tried before generation, e.g. reading saved chunks from disk. Runs on worker
+    // threads (must be thread-safe); returns false to fall back to the terrain generator.
+    // A loader that changes the chunk from its saved state bumps chunk.version so it gets saved.
+    typedef std::function<bool(Chunk& chunk)> ChunkLoader;
+
+    ChunkStreamer(const TerrainGenerator& generator, int viewDistance = DEFAULT_VIEW_DISTANCE, int workerCount = 2);
+    ~ChunkStreamer();
+
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    // Optional hook called on the Update() thread just before a chunk is evicted, or dropped because
+    // the camera moved away while it was being built (e.g. to save it)
+    typedef std::function<void(const Chunk& chunk)> ChunkUnloader;
+
+    void SetLoader(ChunkLoader chunkLoader) { loader = std::move(chunkLoader); }
+    void SetUnloader(ChunkUnloader chunkUnloader) { unloader = std::move(chunkUnloader); }
+    // Distance (in chunks) beyond which chunks are kept compact; 0 keeps every chunk dense
+    void SetCompactDistance(int distance) { compactDistance = std::max(0, distance); compactPending = true; }
+
+    // Queues missing chunks, moves finished ones into the world, evicts far ones and
+    // compacts / expands chunks crossing the compact distance.
+    // The keys of evicted chunks are written to evicted so the caller can drop their meshes.
+    // The caller must hold whatever lock protects the world.
+    void Update(World& world, glm::vec3 cameraPos, glm::vec3 cameraForward, std::vector<int64_t>& evicted);
+
+    // Builds a chunk synchronously on the calling thread (e.g. the spawn area before the first frame)
+    void LoadNow(World& world, int chunkX, int chunkZ);
+
+    // Stops the workers (queued chunks are dropped). Called by the destructor.
+    void Stop();
+
+    StreamerStats GetStats() const;
+    int ViewDistance() const { return viewDistance; }
+
+private:
+    struct Job {
+        int64_t key;
+        float priority; // Lower is sooner
+    };
+
+    static bool JobOrder(const Job& a, const Job& b);
+
+    void WorkerLoop();
+    void BuildChunk(Chunk& chunk) const;
+    float Priority(int chunkX, int chunkZ) const;
+    void Reprioritise(const World& world);
+    void Evict(World& world, std::vector<int64_t>& evicted);
+    // Returns true once every chunk has the storage its distance calls for
+    bool UpdateCompaction(World& world);
+
+    const TerrainGenerator& generator;
+    ChunkLoader loader;
+    ChunkUnloader unloader;
+    int viewDistance;
+    int compactDistance = DEFAULT_COMPACT_DISTANCE;
+    bool compactPending = true; // Chunks were inserted or the camera moved since compaction last finished
+
+    // --- Main thread state ---
+    std::unordered_set<int64_t> requested; // Queued, in flight, or finished but not yet inserted
+    glm::ivec2 cameraChunk = glm::ivec2(INT32_MIN);
+    glm::vec2 cameraPosXZ = glm::vec2(0.0f);
+    glm::vec2 cameraDir = glm::vec2(0.0f, -1.0f); // Forward direction the queue was last sorted for
+    std::vector<int64_t> keyScratch;
+    std::vector<std::unique_ptr<Chunk>> readyScratch;
+
+    // --- Shared with the workers (guarded by queueMutex) ---
+    mutable std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::vector<Job> queue;                        // Min-heap on priority
+    std::vector<std::unique_ptr<Chunk>> finished;  // Built chunks waiting for Update()
+    size_t building = 0;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+    // --- Stats (main thread) ---
+    size_t residentChunks = 0;
+    size_t compactChunks = 0;
+    size_t residentBytes = 0;
+    uint64_t totalLoaded = 0;
+    uint64_t totalEvicted = 0;
+    uint64_t loadedThisWindow = 0;
+    double loadRate = 0.0;
+    std::chrono::steady_clock::time_point windowStart;
+};
+
+#endif
@@ -0,0 +1,162 @@
+// include/EditJournal.h
+
+#ifndef EDIT_JOURNAL_H
+#define EDIT_JOURNAL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "World.h"
+
+// --- Journal Constants ---
+const double JOURNAL_BATCH_INTERVAL = 0.1; // Seconds between batched journal writes
+const int JOURNAL_RECORD_SIZE = 19;        // int32 x, uint16 y, int32 z, uint16 old ID, uint16 new ID, uint32 tick, uint8 check
+
+// When appended edits reach the disk
+enum class JournalSync {
+    None,  // Batched writes, never fsync'd: survives a crash of the game, not of the machine
+    Batch, // Batched writes, fsync'd once per batch: loses at most JOURNAL_BATCH_INTERVAL of edits
+    Edit   // Every edit is written and fsync'd before WaitWritten() returns
+};
+
+struct JournalRecord {
+    int32_t x = 0;
+    uint16_t y = 0;
+    int32_t z = 0;
+    BlockID oldID = 0;
+    BlockID newID = 0;
+    uint32_t tick = 0;
+};
+
+struct JournalStats {
+    uint64_t recordsAppended = 0;
+    uint64_t recordsReplayed = 0;  // Read back from earlier sessions at Open()
+    size_t chunksAwaitingReplay = 0; // Replayed chunks not yet saved and flushed to the region files
+    uint64_t bytesWritten = 0;
+    uint64_t fsyncs = 0;
+    uint64_t writeFailures = 0;      // Failed batch writes or fsyncs (the batch is kept and retried)
+};
+
+// Write-ahead log of block edits, so edits made between autosaves survive a crash without
+// rewriting whole chunks on every click.
+//
+// Edits are appended to an in-memory batch and written to the active segment file
+// (DIR/edits.<sequence>.journal) by a writer thread. When an autosave snapshots the world, Seal()
+// starts a new segment; once the autosave's writes have landed, Discard() deletes the sealed ones.
+//
+// Segments left behind by a session that did not shut down cleanly are read at Open(). Their edits
+// are applied to chunks as they stream in (LoadChunk()), and a background thread folds the rest
+// into the region files. A chunk's records are only dropped once a copy carrying them is flushed to
+// disk - by the compactor, or by a save reported through ChunksSaved() - and the old segments are
+// deleted when no records are left.
+class EditJournal {
+public:
+    // Loads a chunk's saved state (region file, else generated terrain). Must be thread-safe.
+    typedef std::function<void(Chunk& chunk)> ChunkSource;
+    typedef std::function<bool(const Chunk& chunk)> ChunkSink;
+    // Flushes what the sink wrote to disk (e.g. RegionStore::Sync). False if the flush failed.
+    typedef std::function<bool()> ChunkFlush;
+
+    EditJournal() = default;
+    ~EditJournal();
+
+    EditJournal(const EditJournal&) = delete;
+    EditJournal& operator=(const EditJournal&) = delete;
+
+    // Reads leftover segments, opens a new one and starts the writer (and, if there was anything
+    // to replay, the compaction thread writing replayed chunks through sink, then flush). Returns
+    // false if the journal cannot be created.
+    bool Open(const std::string& directory, JournalSync sync, ChunkSource source, ChunkSink sink, ChunkFlush flush);
+    // Writes everything appended, waits for compaction and stops the threads
+    void Close();
+
+    // Records one edit (called under the world lock, right after World::setBlock). Returns a ticket for WaitWritten().
+    uint64_t Append(int x, int y, int z, BlockID oldID, BlockID newID, uint64_t tick);
+    // With JournalSync::Edit, blocks until the edit with this ticket is on disk; otherwise returns at once.
+    // Returns false if a journal write failed first: the edit is retried, but is not on disk yet.
+    bool WaitWritten(uint64_t ticket);
+
+    // Fills chunk from the source, then applies any edits replayed from an earlier session
+    // (bumping chunk.version so the result gets saved). For use as the streaming loader.
+    // The records are kept until ChunksSaved() reports the chunk on disk.
+    void LoadChunk(Chunk& chunk);
+    // Reports chunks (World::ChunkKey) whose saves have been flushed to disk, so the replayed
+    // records they carried can be dropped. Thread-safe.
+    void ChunksSaved(const std::vector<int64_t>& keys);
+
+    // Closes the active segment and starts a new one. Returns the sealed segment's sequence number.
+    uint32_t Seal();
+    // Deletes this session's sealed segments up to and including sequence (their edits are saved)
+    void Discard(uint32_t sequence);
+
+    JournalStats GetStats() const;
+
+    static void EncodeRecord(const JournalRecord& record, uint8_t* out);
+    // Returns false for a torn or corrupt record
+    static bool DecodeRecord(const uint8_t* data, JournalRecord& record);
+
+private:
+    std::string SegmentPath(uint32_t sequence) const;
+    bool OpenSegment(uint32_t sequence);
+    // Writes batch to the active segment (opening one if the last attempt failed); caller holds
+    // fileMutex. False if it did not reach the disk: the segment is then cut back to its last good
+    // batch, so the caller can queue the batch again.
+    bool WriteBatch(const std::vector<uint8_t>& batch, bool sync);
+    // Undoes a torn write and counts the failure; always returns false. Caller holds fileMutex.
+    bool FailBatch(const std::string& message);
+    bool ReadSegment(const std::string& path);
+    static void ApplyRecord(const JournalRecord& record, Chunk& chunk);
+    void WriterLoop();
+    void CompactLoop();
+    // Deletes the old segments once every replayed record is on disk; caller holds replayMutex
+    void RemoveReplaySegmentsIfDone();
+
+    std::string directory;
+    JournalSync syncPolicy = JournalSync::Batch;
+    ChunkSource source;
+    ChunkSink sink;
+    ChunkFlush flush;
+
+    // --- Active segment (guarded by fileMutex; taken before mutex when both are needed) ---
+    std::mutex fileMutex;
+    int fd = -1;
+    uint32_t activeSequence = 0;
+    uint64_t segmentBytes = 0; // Active segment size up to the last batch that reached the disk
+    bool failing = false;      // The last batch failed (only the first failure in a row is reported)
+    std::vector<uint8_t> writeScratch;
+
+    // --- Shared state (guarded by mutex) ---
+    mutable std::mutex mutex;
+    std::condition_variable batchReady;
+    std::condition_variable batchWritten;
+    std::vector<uint8_t> batch;        // Encoded records waiting for the writer
+    uint64_t appendedTickets = 0;
+    uint64_t writtenTickets = 0;
+    std::vector<uint32_t> sealed;      // This session's sealed segments, oldest first
+    bool stopping = false;
+    std::thread writer;
+
+    // --- Edits from earlier sessions (guarded by replayMutex, held across a chunk's load/apply/save
+    // so a streaming load and the compactor never both use the same chunk's records) ---
+    // By chunk, in journal order. Entries are removed once a copy of the chunk carrying the edits
+    // is flushed to the region files: compacted, or loaded into the world and then saved.
+    struct ReplayChunk {
+        std::vector<JournalRecord> records;
+        bool loaded = false; // Applied to a streamed-in copy, which owns the edits until it is saved
+    };
+    mutable std::mutex replayMutex;
+    std::unordered_map<int64_t, ReplayChunk> replay;
+    std::vector<std::string> replaySegments;
+    bool compactionDone = false;
+    bool compactionFailed = false;
+    std::thread compactor;
+
+    JournalStats stats;
+};
+
+#endif
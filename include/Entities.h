@@ -0,0 +1,64 @@
+// include/Entities.h
+
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "World.h"
+#include "JobSystem.h"
+
+// --- Physics Constants (shared by every simulated body, including the player) ---
+const float GRAVITY = -25.0f;            // Gravity force (units/sec^2)
+const float TERMINAL_VELOCITY = -60.0f;  // Fastest fall speed (units/sec)
+const float GROUND_FRICTION = 0.8f;      // Horizontal velocity kept per tick while grounded
+const float GROUND_STOP_SPEED = 0.05f;   // Below this horizontal speed a grounded body stops
+
+// Per-entity flag bits
+enum EntityFlags : uint32_t {
+    ENTITY_GROUNDED = 1u << 0, // Resting on an opaque block (set by the physics step)
+    ENTITY_PLAYER   = 1u << 1,
+    ENTITY_ITEM     = 1u << 2,
+    ENTITY_MOB      = 1u << 3
+};
+
+// Structure-of-arrays store for every moving body in the world.
+// Each attribute lives in its own tightly packed array so the physics passes are simple
+// loops over floats that the compiler can vectorise.
+// Entities are addressed by index; Despawn() moves the last entity into the freed slot.
+class EntityStore {
+public:
+    // Position (AABB center), velocity and half extents
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> halfX, halfY, halfZ;
+    std::vector<float> gravityScale; // 1 = normal gravity, 0 = floats
+    std::vector<uint32_t> flags;
+
+    // Adds an entity and returns its index. size is the full AABB size (width, height, depth).
+    uint32_t Spawn(glm::vec3 position, glm::vec3 size, uint32_t entityFlags, glm::vec3 velocity = glm::vec3(0.0f));
+    void Despawn(uint32_t index);
+    void Clear();
+    uint32_t Count() const { return (uint32_t)posX.size(); }
+
+    glm::vec3 GetPosition(uint32_t i) const { return glm::vec3(posX[i], posY[i], posZ[i]); }
+    glm::vec3 GetVelocity(uint32_t i) const { return glm::vec3(velX[i], velY[i], velZ[i]); }
+    glm::vec3 GetSize(uint32_t i) const { return glm::vec3(halfX[i], halfY[i], halfZ[i]) * 2.0f; }
+    void SetVelocity(uint32_t i, glm::vec3 v) { velX[i] = v.x; velY[i] = v.y; velZ[i] = v.z; }
+    void SetSize(uint32_t i, glm::vec3 size) { halfX[i] = size.x * 0.5f; halfY[i] = size.y * 0.5f; halfZ[i] = size.z * 0.5f; }
+    bool HasFlag(uint32_t i, uint32_t flag) const { return (flags[i] & flag) != 0; }
+
+    // Scratch space reused by StepEntities (entity indices sorted by chunk)
+    std::vector<uint64_t> chunkOrder;
+};
+
+// Advances every entity by one fixed tick:
+//   1. gravity pass (vectorised over all entities)
+//   2. swept voxel collision, with entities sorted by chunk and each chunk range handed to one thread
+//   3. ground friction pass (vectorised)
+// threadCount <= 1 runs everything on the calling thread. With jobs, the chunk ranges run as jobs on
+// it; otherwise threads are started for the call. The world must not be modified during the call.
+void StepEntities(EntityStore& entities, const World& world, float dt, int threadCount = 1, JobSystem* jobs = nullptr);
+
+#endif
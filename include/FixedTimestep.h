@@ -0,0 +1,84 @@
+// include/FixedTimestep.h
+
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+#include <glm/glm.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Simulation rate. Physics always advances in steps of exactly SIM_TICK_DT seconds,
+// no matter how fast or slow the renderer is running.
+const double SIM_TICK_RATE = 60.0;
+const double SIM_TICK_DT   = 1.0 / SIM_TICK_RATE;
+
+// Longest frame time fed into the accumulator. A longer hitch (window drag, breakpoint, disk stall)
+// is dropped instead of being paid back as hundreds of catch-up ticks.
+const double MAX_FRAME_TIME = 0.25;
+
+// Accumulator that converts variable frame times into a whole number of fixed ticks.
+class FixedTimestep {
+public:
+    double TickDt;
+    uint64_t TickCount; // Total ticks handed out since construction
+
+    FixedTimestep(double tickDt = SIM_TICK_DT);
+
+    // Adds the real time elapsed since the last call and returns how many ticks to run now.
+    int Advance(double frameTime);
+
+    // How far (0..1) we are between the last completed tick and the next one.
+    // Used to blend the previous and current simulation state when rendering.
+    float Alpha() const;
+
+private:
+    double accumulator;
+};
+
+// Everything the renderer needs from one simulation tick.
+struct SimState {
+    glm::vec3 playerPos = glm::vec3(0.0f);
+    glm::vec3 playerVelocity = glm::vec3(0.0f);
+    glm::vec3 playerSize = glm::vec3(0.0f);
+    bool isGrounded = false;
+    uint64_t tick = 0;
+    double time = 0.0; // Seconds (glfwGetTime clock) when this tick was published
+};
+
+// Double-buffered hand-off between the simulation and the renderer.
+// The simulation publishes one state per tick; the renderer always reads the last two
+// so it can interpolate between them. Copies happen under a short lock, never a whole tick.
+class SimStateBuffer {
+public:
+    void Publish(const SimState& state);
+    void Read(SimState& previous, SimState& current) const;
+
+private:
+    SimState states[2];
+    int currentIndex = 0;
+    mutable std::mutex mutex;
+};
+
+// Runs a tick function at a fixed rate on its own thread.
+class SimulationThread {
+public:
+    SimulationThread() = default;
+    ~SimulationThread();
+
+    // Starts calling tickFn(dt) SIM_TICK_RATE times per second until Stop() is called.
+    void Start(std::function<void(float)> tickFn, double tickDt = SIM_TICK_DT);
+    void Stop();
+    bool IsRunning() const { return running.load(); }
+
+private:
+    void run(double tickDt);
+
+    std::function<void(float)> tick;
+    std::thread worker;
+    std::atomic<bool> running{false};
+};
+
+#endif
@@ -0,0 +1,65 @@
+// include/Headless.h
+
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Offscreen rendering for --headless runs (automated render benchmarks).
+//
+// An OpenGL 4.5 core context is created through EGL on Mesa's surfaceless platform (falling back
+// to the default EGL display), so it needs neither a window nor a display server and runs on
+// llvmpipe without a GPU. Frames are drawn into a framebuffer object the size of the window,
+// which stays bound as the draw and read framebuffer.
+// Without EGL at build time (see meson.build), Create() fails with a message.
+class HeadlessContext {
+public:
+    HeadlessContext() = default;
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    // Creates the context and its framebuffer, makes them current and loads the GL functions (GLAD)
+    bool Create(int width, int height);
+    // Deletes the framebuffer and the context
+    void Destroy();
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+
+    // Waits for the frame to finish and reads the colour buffer back (RGBA8, bottom row first)
+    void ReadPixels(std::vector<uint8_t>& pixels) const;
+
+private:
+    void* display = nullptr; // EGLDisplay
+    void* context = nullptr; // EGLContext
+    unsigned int framebuffer = 0;
+    unsigned int colorBuffer = 0;
+    unsigned int depthBuffer = 0;
+    int width = 0;
+    int height = 0;
+};
+
+struct FrameTimeStats {
+    size_t frames = 0;
+    double mean = 0.0; // Milliseconds
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+// Mean and nearest-rank percentiles of frame times in milliseconds
+FrameTimeStats SummarizeFrameTimes(std::vector<double> milliseconds);
+
+// FNV-1a 64 of the pixels: the same image (to the bit) hashes the same
+uint64_t HashPixels(const std::vector<uint8_t>& pixels);
+
+// Writes RGBA8 pixels (bottom row first, as ReadPixels returns them) as a binary PPM
+bool WritePPM(const std::string& path, int width, int height, const std::vector<uint8_t>& pixels);
+
+#endif
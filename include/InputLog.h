@@ -0,0 +1,117 @@
+// include/InputLog.h
+
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Keys held when the keyboard was sampled (InputEvent::keys)
+enum InputKeys : uint16_t {
+    INPUT_KEY_FORWARD        = 1 << 0,
+    INPUT_KEY_BACK           = 1 << 1,
+    INPUT_KEY_LEFT           = 1 << 2,
+    INPUT_KEY_RIGHT          = 1 << 3,
+    INPUT_KEY_SNEAK          = 1 << 4,
+    INPUT_KEY_SPRINT         = 1 << 5,
+    INPUT_KEY_JUMP           = 1 << 6,
+    INPUT_KEY_NEXT_BLOCK     = 1 << 7,
+    INPUT_KEY_PREVIOUS_BLOCK = 1 << 8
+};
+
+enum class InputEventType : uint8_t {
+    Keys,      // The keyboard was sampled: keys
+    MouseMove, // The cursor moved: dx, dy (the offsets handed to Camera::ProcessMouseMovement)
+    Click      // A mouse button was pressed: button (0 left, 1 right, 2 middle), with the camera at eye
+};
+
+struct InputEvent {
+    InputEventType type = InputEventType::Keys;
+    uint64_t tick = 0;  // Simulation ticks done when it was applied: it takes effect from tick + 1
+    uint16_t keys = 0;
+    uint8_t button = 0;
+    float dx = 0.0f;
+    float dy = 0.0f;
+    glm::vec3 eye = glm::vec3(0.0f);
+};
+
+// Input from the window callbacks on its way to the thread that applies it (between ticks, at the
+// start of a frame), so live, recorded and replayed input all take the same path.
+class InputQueue {
+public:
+    void Push(const InputEvent& event);
+    // Moves every queued event into events (cleared first), oldest first
+    void Drain(std::vector<InputEvent>& events);
+
+private:
+    std::mutex mutex;
+    std::vector<InputEvent> pending;
+};
+
+// Writes applied input events to a compact binary log:
+//   header  "TINP", uint32 format version, uint32 world seed
+//   event   varint ticks since the previous record, uint8 type, then
+//             Keys: uint16 keys | MouseMove: float dx, dy | Click: uint8 button, float eye x, y, z
+//   end     varint ticks, uint8 0xFF, uint64 simulation checksum at that tick
+// Numbers are written little-endian on any host and floats bit for bit, so a replay reproduces them
+// exactly. (The checksum hashes the simulation's in-memory state, so it only matches on a host with
+// the same byte order.)
+// A mouse move costs 10 bytes, a key change 4.
+class InputRecorder {
+public:
+    InputRecorder() = default;
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    // Creates (or truncates) the log. False if it cannot be written.
+    bool Open(const std::string& path, uint32_t seed);
+    bool IsOpen() const { return file != nullptr; }
+    void Write(const InputEvent& event);
+    // Ends the log at tick with the simulation checksum there and closes it. False if any write failed.
+    bool Close(uint64_t tick, uint64_t checksum);
+
+    size_t EventCount() const { return eventCount; }
+    uint64_t ByteCount() const { return byteCount; }
+
+private:
+    void PutTick(uint64_t tick);
+    bool Flush();
+
+    FILE* file = nullptr;
+    std::vector<uint8_t> buffer;
+    uint64_t lastTick = 0;
+    size_t eventCount = 0;
+    uint64_t byteCount = 0;
+    bool failed = false;
+};
+
+// Reads a log written by InputRecorder and hands its events back tick by tick
+class InputReplay {
+public:
+    // Reads and checks the whole log. False (with a message) if it is missing, truncated or not a log.
+    bool Open(const std::string& path);
+
+    uint32_t Seed() const { return seed; }
+    // The next event, if it was applied before tick + 1 (a tick's events come out in recorded order)
+    bool Next(uint64_t tick, InputEvent& event);
+    // Ticks the recording ran for, and the simulation checksum it ended with
+    uint64_t EndTick() const { return endTick; }
+    uint64_t EndChecksum() const { return endChecksum; }
+    size_t EventCount() const { return events.size(); }
+
+private:
+    std::vector<InputEvent> events;
+    size_t next = 0;
+    uint32_t seed = 0;
+    uint64_t endTick = 0;
+    uint64_t endChecksum = 0;
+};
+
+#endif
@@ -0,0 +1,226 @@
+// include/JobSystem.h
+
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// --- Job System Constants ---
+const size_t JOB_PAYLOAD_SIZE = 64;     // Bytes of captures a job can hold (capture pointers to anything larger)
+const int MAX_JOB_CONTINUATIONS = 6;    // Jobs that can depend on one job
+const uint32_t JOB_POOL_SIZE = 4096;    // Jobs per creating thread before the slots are reused (power of two)
+const uint32_t JOB_DEQUE_SIZE = 4096;   // Queued jobs per worker (power of two); beyond that jobs run inline
+const uint32_t MAX_PARALLEL_FOR_JOBS = 1024; // ParallelFor coarsens its grain to stay under this many jobs
+
+// Where a job may run
+enum class JobAffinity {
+    Any,       // Any worker (or a thread waiting for jobs)
+    MainThread // Only the thread that created the JobSystem, e.g. GL calls (see RunMainThreadJobs)
+};
+
+// A unit of work: a callable stored in place plus the counters that order it. Jobs come from
+// per-thread pools and are only handled through JobSystem.
+struct alignas(64) Job {
+    void (*invoke)(Job& job) = nullptr;  // Runs (and destroys) the callable in payload
+    Job* parent = nullptr;               // Finishes only after this job has
+    std::atomic<int32_t> unfinished{0};  // This job plus its unfinished children
+    std::atomic<int32_t> blockers{0};    // The pending Run() plus unfinished prerequisites; queued at 0
+    std::atomic<bool> done{true};        // Finished, continuations queued (the slot may be reused)
+    int continuationCount = 0;
+    Job* continuations[MAX_JOB_CONTINUATIONS];
+    JobAffinity affinity = JobAffinity::Any;
+    alignas(std::max_align_t) unsigned char payload[JOB_PAYLOAD_SIZE];
+};
+
+// Chase-Lev work-stealing deque (Le, Pop, Cohen and Zappa Nardelli's C11 version, with sequentially
+// consistent operations instead of fences). The owning worker pushes and pops at the bottom
+// (newest first, which keeps its caches warm); other threads steal from the top (oldest first,
+// which tends to take the biggest pieces of a split range).
+class JobDeque {
+public:
+    // Owner only. False if the deque is full.
+    bool Push(Job* job);
+    // Owner only. nullptr if empty.
+    Job* Pop();
+    // Any thread. nullptr if empty or another thread won the race.
+    Job* Steal();
+    bool Empty() const { return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<Job*> buffer[JOB_DEQUE_SIZE];
+};
+
+// Work-stealing job system: one deque per worker thread, idle workers stealing from the others.
+//
+// Jobs are created, optionally linked, then run:
+//   Job* load = jobs.Create([&] { ... });
+//   Job* mesh = jobs.Create([&] { ... });
+//   jobs.Depend(mesh, load);  // mesh is queued once load (and its children) finished
+//   jobs.Run(mesh);
+//   jobs.Run(load);
+//   jobs.Wait(mesh);          // Runs other jobs while waiting
+// A job created with CreateChild() holds its parent open until it finishes, so waiting for a
+// parent waits for everything spawned under it. ParallelFor() splits an index range over the
+// workers and returns once all of it ran.
+//
+// The thread that creates the JobSystem counts as worker 0 and runs jobs whenever it waits; it
+// alone runs MainThread jobs (GL calls), in Wait() and RunMainThreadJobs(). Other threads (the
+// game or simulation thread) may create, run and wait for jobs too: theirs go to a shared queue.
+// With no background workers every job runs on the thread waiting for it, in an order that
+// depends only on the program: a deterministic mode for debugging.
+//
+// Job slots are recycled: a job must be waited for (or have finished) before its creating thread
+// creates JOB_POOL_SIZE more jobs, and a pointer to a finished job must not be kept beyond that.
+class JobSystem {
+public:
+    // workerCount background threads besides the calling thread (0 = deterministic mode)
+    explicit JobSystem(int workerCount = DefaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // One worker per hardware thread besides the calling one
+    static int DefaultWorkerCount();
+
+    // A job that calls f() once it is run. f must fit in JOB_PAYLOAD_SIZE bytes.
+    template <typename F>
+    Job* Create(F&& f);
+    // A job that its parent waits for. Call before the parent finished (from the parent itself,
+    // or before the parent is run).
+    template <typename F>
+    Job* CreateChild(Job* parent, F&& f);
+    // job is queued only after prerequisite finished. Call before either is run.
+    // False (and no dependency) if prerequisite already has MAX_JOB_CONTINUATIONS.
+    bool Depend(Job* job, Job* prerequisite);
+    // Queues the job (once its prerequisites finished). Every created job must be run once.
+    void Run(Job* job, JobAffinity affinity = JobAffinity::Any);
+    // Runs queued jobs until job (and its children) finished
+    void Wait(const Job* job);
+    bool IsDone(const Job* job) const { return job->done.load(std::memory_order_acquire); }
+
+    // Calls body(first, last) over [begin, end) in ranges of about grain indices, spread over the
+    // workers, and returns when every range is done. Ranges run concurrently: body must be thread-safe.
+    template <typename F>
+    void ParallelFor(uint32_t begin, uint32_t end, uint32_t grain, const F& body);
+
+    // Main thread only: runs the MainThread jobs queued so far. Returns how many ran.
+    int RunMainThreadJobs();
+
+    // Threads running jobs: the background workers plus the main thread
+    int ThreadCount() const { return (int)workers.size(); }
+    bool IsDeterministic() const { return workers.size() == 1; }
+
+private:
+    struct Worker {
+        JobDeque deque;
+        std::unique_ptr<Job[]> pool;
+        uint32_t nextJob = 0;
+        std::thread thread;
+    };
+
+    // Index of the calling thread's worker, -1 for other threads
+    int WorkerIndex() const;
+    Job* Allocate();
+    // Queues a job whose blockers reached 0
+    void Schedule(Job* job);
+    // Takes a job the calling thread may run (nullptr if none)
+    Job* Take(int worker);
+    bool RunOne(int worker);
+    void Execute(Job* job);
+    void Finish(Job* job);
+    void WorkerLoop(int worker);
+
+    template <typename F>
+    void RunRange(Job* root, const F* body, uint32_t begin, uint32_t end, uint32_t grain);
+
+    std::vector<std::unique_ptr<Worker>> workers; // [0] is the main thread
+    std::thread::id mainThread;
+
+    // --- Jobs from threads that are not workers (guarded by sharedMutex) ---
+    std::mutex sharedMutex;
+    std::vector<Job*> sharedQueue;
+    std::atomic<size_t> sharedQueued{0};
+    std::unique_ptr<Job[]> sharedPool;
+    uint32_t nextSharedJob = 0;
+
+    // --- MainThread jobs (guarded by mainMutex) ---
+    std::mutex mainMutex;
+    std::deque<Job*> mainQueue;
+    std::atomic<size_t> mainQueued{0};
+
+    // --- Sleeping workers ---
+    std::atomic<int64_t> queuedJobs{0}; // In a deque or the shared queue
+    std::atomic<int> sleepers{0};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<bool> stopping{false};
+};
+
+template <typename F>
+Job* JobSystem::Create(F&& f) {
+    typedef typename std::decay<F>::type Fn;
+    static_assert(sizeof(Fn) <= JOB_PAYLOAD_SIZE, "job captures too large: capture a pointer instead");
+    static_assert(alignof(Fn) <= alignof(std::max_align_t), "job captures over-aligned");
+    Job* job = Allocate();
+    new (job->payload) Fn(std::forward<F>(f));
+    job->invoke = [](Job& self) {
+        Fn& fn = *reinterpret_cast<Fn*>(self.payload);
+        fn();
+        fn.~Fn();
+    };
+    return job;
+}
+
+template <typename F>
+Job* JobSystem::CreateChild(Job* parent, F&& f) {
+    parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+    Job* job = Create(std::forward<F>(f));
+    job->parent = parent;
+    return job;
+}
+
+// Halves the range, handing the upper half to a child job each time, until it is a grain long,
+// then runs it. Thieves take the oldest (largest) halves first.
+template <typename F>
+void JobSystem::RunRange(Job* root, const F* body, uint32_t begin, uint32_t end, uint32_t grain) {
+    while (end - begin > grain) {
+        const uint32_t middle = begin + (end - begin) / 2;
+        Run(CreateChild(root, [this, root, body, middle, end, grain] { RunRange(root, body, middle, end, grain); }));
+        end = middle;
+    }
+    (*body)(begin, end);
+}
+
+template <typename F>
+void JobSystem::ParallelFor(uint32_t begin, uint32_t end, uint32_t grain, const F& body) {
+    if (begin >= end) {
+        return;
+    }
+    const uint32_t count = end - begin;
+    grain = std::max(std::max(grain, 1u), (count + MAX_PARALLEL_FOR_JOBS - 1) / MAX_PARALLEL_FOR_JOBS);
+    if (count <= grain) {
+        body(begin, end);
+        return;
+    }
+    const F* bodyPtr = &body;
+    Job* root = Create([this, bodyPtr, begin, end, grain, &root] { RunRange(root, bodyPtr, begin, end, grain); });
+    Run(root);
+    Wait(root);
+}
+
+#endif
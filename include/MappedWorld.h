@@ -0,0 +1,77 @@
+// include/MappedWorld.h
+
+#ifndef MAPPED_WORLD_H
+#define MAPPED_WORLD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "World.h"
+
+// --- Baked Map Layout ---
+// A baked map is a rectangle of chunk columns stored as raw Chunk records, so a memory-mapped
+// record *is* a Chunk the mesher, raycaster and collision code can read in place:
+//   page 0           header (magic, format version, chunk dimensions/record layout, bounds)
+//   page 1..         index: one uint32 per column of the rectangle (row-major in Z), record number + 1, 0 = absent
+//   chunksOffset..   records, MAPPED_RECORD_ALIGN aligned
+// The file is only usable on a machine with the same endianness and Chunk layout; Open() checks both.
+const size_t MAPPED_PAGE_SIZE = 4096;
+const size_t MAPPED_RECORD_ALIGN = 64;
+
+// Read-only world backend over a baked map file (see World::AttachMappedWorld).
+//
+// Open() maps the file and validates the header; nothing is read or copied up front, so startup
+// costs the same for any map size. Chunks are paged in by the OS on first touch, and because the
+// mapping is shared and read-only, processes showing the same map share one copy in the page cache.
+class MappedWorld {
+public:
+    MappedWorld() = default;
+    ~MappedWorld();
+
+    MappedWorld(const MappedWorld&) = delete;
+    MappedWorld& operator=(const MappedWorld&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return base != nullptr; }
+
+    const Chunk* GetChunk(int chunkX, int chunkZ) const {
+        const int64_t dx = (int64_t)chunkX - minChunkX;
+        const int64_t dz = (int64_t)chunkZ - minChunkZ;
+        if (dx < 0 || dz < 0 || dx >= width || dz >= depth) {
+            return nullptr;
+        }
+        const uint32_t slot = index[dz * width + dx];
+        return slot ? (const Chunk*)(base + chunksOffset + (size_t)(slot - 1) * recordStride) : nullptr;
+    }
+
+    void GetChunkKeys(std::vector<int64_t>& out) const;
+    size_t ChunkCount() const { return chunkCount; }
+    size_t MappedBytes() const { return mappedSize; }
+
+    int MinChunkX() const { return minChunkX; }
+    int MinChunkZ() const { return minChunkZ; }
+    int Width() const { return width; }
+    int Depth() const { return depth; }
+
+    // Writes a baked map of the width x depth chunk rectangle starting at (minChunkX, minChunkZ).
+    // source fills each chunk (chunkX / chunkZ already set) and returns false to leave it out.
+    static bool Bake(const std::string& path, int minChunkX, int minChunkZ, int width, int depth,
+                     const std::function<bool(Chunk& chunk)>& source);
+
+private:
+    const uint8_t* base = nullptr;
+    size_t mappedSize = 0;
+    const uint32_t* index = nullptr;
+    size_t chunksOffset = 0;
+    size_t recordStride = 0;
+    size_t chunkCount = 0;
+    int minChunkX = 0;
+    int minChunkZ = 0;
+    int width = 0;
+    int depth = 0;
+};
+
+#endif
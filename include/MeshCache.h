@@ -0,0 +1,112 @@
+// include/MeshCache.h
+
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "World.h"
+#include "Mesher.h"
+#include "RegionFile.h"
+
+// --- Mesh Cache Constants ---
+const size_t MESH_CACHE_MAX_PENDING = 256; // Queued stores beyond this are dropped (rebuilt next run)
+
+// --- Cached Mesh Layout ---
+// One REGION_CODEC_MESH_FACES payload per chunk column, in region files under the cache directory:
+//   uint64 key, uint32 opaque face count, uint32 translucent face count,
+//   SECTIONS x uint16 section visibility (ComputeSectionVisibility; all little-endian),
+//   then the LZ-compressed face records (ChunkCodec.h), opaque faces first, in mesher order.
+// A face record is 8 bytes: uint16 cell (Chunk::Index), uint8 face (FACE_OFFSETS order), uint8 0,
+// uint16 block ID, uint16 texture index. The vertices are rebuilt from the records with the
+// mesher's own AppendFace(), so a cached mesh is identical to a freshly generated one.
+
+struct MeshCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stored = 0;
+    uint64_t dropped = 0;     // Stores skipped because the queue was full
+    size_t pendingStores = 0;
+};
+
+// On-disk cache of chunk meshes, so chunks that have not changed since the last run are uploaded
+// without running the mesher.
+//
+// An entry is keyed by a hash of everything GenerateChunkMesh() reads: the chunk's blocks, the
+// border blocks of its four neighbours, the block tables (opacity and texture index per ID) and
+// MESHER_VERSION / VERTEX_ATTRIBUTES. Any edit, a changed blocks.json or a mesher change therefore
+// just misses; stale entries are overwritten by the next store. Loads run on the calling thread
+// (a pread of a few KB plus decompression); stores are compressed and written on an I/O thread.
+class MeshCache {
+public:
+    MeshCache() = default;
+    ~MeshCache();
+
+    MeshCache(const MeshCache&) = delete;
+    MeshCache& operator=(const MeshCache&) = delete;
+
+    // Uses the cache in directory (created on the first store). The block tables of world are part
+    // of every key, so open the cache after the block definitions are loaded.
+    void Open(const std::string& directory, const World& world);
+    // Writes the queued stores, then stops the I/O thread. Called by the destructor.
+    void Close();
+    bool IsOpen() const { return store != nullptr; }
+
+    // Key of the mesh GenerateChunkMesh() would build for (chunkX, chunkZ) right now, or 0 if the
+    // chunk or one of its four neighbours is not loaded: chunks on the edge of the loaded area are
+    // remeshed as soon as their neighbours arrive, so those meshes are not worth caching.
+    // Reads the world; the caller holds whatever lock guards it.
+    uint64_t MeshKey(const World& world, int chunkX, int chunkZ) const;
+
+    // Fills mesh with the cached mesh of (chunkX, chunkZ) if it was stored under key
+    bool Load(int chunkX, int chunkZ, uint64_t key, ChunkMesh& mesh);
+    // Queues mesh (built by GenerateChunkMesh() while the chunk had key) to be written.
+    // A newer store for the same chunk replaces one still waiting in the queue.
+    void Store(int chunkX, int chunkZ, uint64_t key, const ChunkMesh& mesh);
+
+    // Blocks until every queued store is written
+    void Flush();
+
+    MeshCacheStats GetStats() const;
+
+    // Payload encoding (the cache layout above). Encode returns false if the mesh holds a face it
+    // cannot represent (not one of chunk (chunkX, chunkZ)'s cells).
+    static bool EncodeMesh(const ChunkMesh& mesh, int chunkX, int chunkZ, uint64_t key, std::vector<uint8_t>& out);
+    static bool DecodeMesh(const uint8_t* data, size_t size, int chunkX, int chunkZ, uint64_t key, ChunkMesh& mesh);
+
+private:
+    struct PendingStore {
+        int chunkX = 0;
+        int chunkZ = 0;
+        uint64_t key = 0;
+        uint32_t opaqueFaces = 0;
+        uint16_t sectionVisibility[SECTIONS] = {};
+        std::vector<uint8_t> records; // Face records; compressed on the I/O thread
+    };
+
+    void IOLoop();
+
+    std::unique_ptr<RegionStore> store;
+    uint64_t tableHash = 0; // Block tables + mesher version, the seed of every key
+
+    mutable std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable queueDrained;
+    std::unordered_map<int64_t, PendingStore> pending; // Per chunk, so repeated stores coalesce
+    bool writing = false;
+    bool stopping = false;
+    std::thread ioThread;
+
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stored = 0;
+    uint64_t dropped = 0;
+};
+
+#endif
@@ -0,0 +1,143 @@
+// include/Mesher.h
+
+#ifndef MESHER_H
+#define MESHER_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "World.h"
+
+// The number of floats per vertex (Position, Normal, TexCoords, BlockID, TexIndex)
+const int VERTEX_ATTRIBUTES = 10; // Pos(3), Normal(3), TexCoord(2), BlockID(1), TexIndex(1)
+
+// Unit cube faces: 6 faces x 6 vertices x 8 floats (Pos(3), Normal(3), TexCoord(2)), centered at the origin
+extern const float FACE_VERTICES[6 * 48];
+// Offsets for checking neighbors (Top, Bottom, Front, Back, Left, Right), same order as FACE_VERTICES
+extern const int FACE_OFFSETS[6][3];
+
+// Bump whenever GenerateChunkMesh() output changes for the same blocks (vertex layout, culling
+// rules, face winding); cached meshes from other versions are then ignored (see MeshCache.h).
+const uint32_t MESHER_VERSION = 2;
+
+// Floats written per face (6 vertices)
+const int FACE_FLOATS = 6 * VERTEX_ATTRIBUTES;
+
+// Appends the 6 vertices of one face of the block at world position (x, y, z) to a vertex buffer.
+// With scale > 1 the face is that of a scale^3 LOD cell whose lowest block is (x, y, z); its
+// texture coordinates are scaled too, so the texture still repeats once per block.
+void AppendFace(std::vector<float>& finalMesh, int face, int x, int y, int z, float blockId, unsigned int texIndex, int scale = 1);
+// Same, written at out (FACE_FLOATS floats) for buffers sized up front. Returns the end of the face.
+float* WriteFace(float* out, int face, int x, int y, int z, float blockId, unsigned int texIndex, int scale = 1);
+// Centre of that face (the depth sort key of translucent faces)
+inline glm::vec3 FaceCenter(int face, int x, int y, int z, int scale = 1) {
+    const float offset = 0.5f * (scale - 1), half = 0.5f * scale;
+    return glm::vec3(x + offset + half * FACE_OFFSETS[face][0], y + offset + half * FACE_OFFSETS[face][1],
+                     z + offset + half * FACE_OFFSETS[face][2]);
+}
+
+// --- Sections ---
+// For visibility a chunk column is cut into SECTIONS cubes of SECTION_HEIGHT blocks (see CaveCulling.h)
+const int SECTION_HEIGHT = CHUNK_SIZE;
+const int SECTIONS = CHUNK_HEIGHT / SECTION_HEIGHT;
+
+// Bit of the face pair (a, b), a != b, in a section's visibility set: 15 pairs of FACE_OFFSETS faces
+inline int FacePairBit(int a, int b) {
+    if (a > b) { int t = a; a = b; b = t; }
+    return a * (11 - a) / 2 + (b - a - 1);
+}
+inline bool FacesConnected(uint16_t visibility, int a, int b) { return (visibility >> FacePairBit(a, b)) & 1u; }
+
+// Which faces of each section are connected through non-opaque cells (a flood fill per section,
+// with World::isOpaqueID deciding what blocks). A face pair is set if one connected region of
+// air / water / glass touches both faces; sight lines can only pass a section that way.
+void ComputeSectionVisibility(const World& world, const Chunk& chunk, uint16_t visibility[SECTIONS]);
+
+// CPU-side mesh of one chunk column, in world coordinates.
+// Opaque and translucent (non-opaque, e.g. water) geometry go to separate buffers: the opaque part
+// is drawn first with depth writes, the translucent part afterwards, blended, back to front.
+// A ChunkMesh is meant to be reused as the meshing arena of one thread: the buffers keep their
+// capacity, so once they have grown to the largest chunk seen, remeshing allocates nothing and the
+// upload reads the buffers in place.
+struct ChunkMesh {
+    std::vector<float> vertices;                   // Opaque faces
+    std::vector<float> translucentVertices;        // Translucent faces, 6 vertices each
+    std::vector<glm::vec3> translucentFaceCenters; // One per translucent face (for depth sorting)
+    int opaqueVertexCount = 0;
+    int translucentVertexCount = 0;
+    // Opaque faces are emitted bottom to top, so section s owns opaque vertices
+    // [sectionVertexStart[s], sectionVertexStart[s + 1]) and can be drawn on its own
+    int sectionVertexStart[SECTIONS + 1] = {};
+    uint16_t sectionVisibility[SECTIONS] = {}; // See ComputeSectionVisibility
+};
+
+// Generates the mesh for one chunk based on visible faces. Neighbouring chunks are read through
+// the world so faces on chunk borders are culled correctly. Faces between two blocks of the same
+// translucent type (water next to water) are culled too. The buffers keep their capacity and are
+// sized once from a count of the visible faces.
+void GenerateChunkMesh(const World& world, int chunkX, int chunkZ, ChunkMesh& mesh);
+
+// --- Level of Detail ---
+// A chunk at LOD n is meshed from cells of 2^n x 2^n x 2^n blocks (see DownsampleCell), so distant
+// chunks have 4^n times fewer faces. LOD n is used from 2^(n-1) * lodDistance chunks out, doubling
+// the cell size each time the distance doubles, which keeps the projected cell size (and so the face
+// count per screen area) roughly constant.
+const int MAX_LOD = 3; // 8x8x8 cells
+const int DEFAULT_LOD_DISTANCE = 4; // Chunks meshed at full resolution around the camera (0 = no LOD)
+
+// LOD of chunk (chunkX, chunkZ) seen from a camera in cameraChunk: 0 within lodDistance chunks,
+// then one level more each time the distance doubles, up to MAX_LOD
+int ChunkLod(int chunkX, int chunkZ, glm::ivec2 cameraChunk, int lodDistance);
+
+// Block of LOD cell (cellX, cellY, cellZ) of a chunk: a majority filter that keeps the surface.
+// The cell is solid if at least half its blocks are, and then takes the most common block of its
+// highest non-empty layer (grass stays on top of hills, water on lakes). LOD 0 is the block itself.
+BlockID DownsampleCell(const Chunk& chunk, int lod, int cellX, int cellY, int cellZ);
+
+// GenerateChunkMesh() at LOD lod. neighbourLods are the LODs of the four neighbouring chunks, in
+// FACE_OFFSETS order (+Z, -Z, -X, +X). Faces on the chunk border are culled against the neighbour
+// at its own LOD, and only when its cells cover the whole face, so chunks of different LODs meet
+// without cracks: where the coarse surface is lower or higher, the border faces left standing form
+// a skirt down to it. With every LOD 0 this builds exactly GenerateChunkMesh()'s mesh.
+void GenerateLodChunkMesh(const World& world, int chunkX, int chunkZ, int lod, const int neighbourLods[4], ChunkMesh& mesh);
+
+// --- Face Records ---
+// Compact form of a mesh for vertex pulling (shaders/pulled.vs): 8 bytes per face instead of the
+// 240 of its six vertices. A record buffer starts with the chunk's origin in blocks (int32 x, z),
+// then one record of two uint32 per face, in vertex buffer order:
+//   word 0: bits 0-3 x, 4-7 z (in the chunk), 8-13 y, 14-16 face (FACE_OFFSETS order),
+//           17-18 log2 of the LOD scale
+//   word 1: bits 0-15 block ID, 16-31 texture index
+const int FACE_RECORD_HEADER_WORDS = 2;
+const int FACE_RECORD_WORDS = 2;
+
+// Recovers a face written by WriteFace() from its FACE_FLOATS floats. False if they are not one.
+bool ReadFace(const float* faceVertices, int& face, int& x, int& y, int& z, int& scale, BlockID& blockId, unsigned int& texIndex);
+
+// Packs a vertex buffer of chunk (chunkX, chunkZ) into records (replacing its contents).
+// False if a face is outside the chunk or not a mesher face.
+bool PackFaceRecords(const std::vector<float>& vertices, int chunkX, int chunkZ, std::vector<uint32_t>& records);
+
+// Back-to-front draw order for the translucent faces of one chunk.
+// The order persists between sorts and is refined with an insertion sort, so a re-sort after a
+// small camera move (the usual case) costs close to one pass over the faces instead of a full sort.
+class TranslucentOrder {
+public:
+    // Starts over for a new set of faces (after a remesh)
+    void Reset(const std::vector<glm::vec3>& faceCenters);
+
+    // Re-sorts for the given camera position. Returns true if the order changed.
+    bool Sort(glm::vec3 cameraPos);
+
+    // Element indices (6 per face, farthest face first) for GL_ELEMENT_ARRAY_BUFFER
+    const std::vector<uint32_t>& Indices() const { return indices; }
+    size_t FaceCount() const { return centers.size(); }
+
+private:
+    std::vector<glm::vec3> centers;
+    std::vector<uint32_t> faces;    // Face numbers, farthest first
+    std::vector<float> distances;   // Squared distance per face (scratch)
+    std::vector<uint32_t> indices;
+};
+
+#endif
@@ -0,0 +1,56 @@
+// include/Noise.h
+
+#ifndef NOISE_H
+#define NOISE_H
+
+#include <cstdint>
+
+// Fractal Brownian motion: `octaves` layers of gradient noise, each `lacunarity` times the
+// frequency and `gain` times the amplitude of the one before. Results are normalised by the
+// total amplitude, so they stay roughly within [-1, 1] whatever the octave count.
+struct FractalParams {
+    int octaves = 4;
+    float frequency = 1.0f / 64.0f; // Of the first octave, in cycles per block
+    float lacunarity = 2.0f;
+    float gain = 0.5f;
+};
+
+// Instruction set used by the row functions below
+enum class NoiseISA { Scalar, SSE41, AVX2 };
+
+// Seeded 2D/3D gradient (Perlin-style) noise.
+//
+// Lattice gradients come from an integer hash of (seed, cell), so there is no permutation table
+// and every instance is cheap to create and safe to share between threads.
+// The row functions evaluate many samples at once with SSE4.1 or AVX2 (picked at runtime).
+// All paths use the same operations in the same order, so they produce bit-identical results
+// and generated terrain does not depend on the CPU it was generated on.
+class GradientNoise {
+public:
+    explicit GradientNoise(uint32_t seed = 0);
+
+    float Noise2D(float x, float z) const;
+    float Noise3D(float x, float y, float z) const;
+    float Fractal2D(float x, float z, const FractalParams& params) const;
+    float Fractal3D(float x, float y, float z, const FractalParams& params) const;
+
+    // Rows run along Z to match the chunk block layout (Z innermost):
+    // out[i] = Fractal2D(x, z0 + i * step) and out[i] = Fractal3D(x, y, z0 + i * step)
+    void Fractal2DRow(float x, float z0, float step, int count, const FractalParams& params, float* out) const;
+    void Fractal3DRow(float x, float y, float z0, float step, int count, const FractalParams& params, float* out) const;
+
+    uint32_t Seed() const { return seed; }
+
+private:
+    uint32_t seed;
+};
+
+// Best instruction set supported by this CPU (detected once)
+NoiseISA DetectNoiseISA();
+// Instruction set the row functions currently use. Defaults to DetectNoiseISA().
+NoiseISA ActiveNoiseISA();
+// Forces a narrower instruction set (for benchmarking). Requests the CPU cannot run are clamped.
+void SetNoiseISA(NoiseISA isa);
+const char* NoiseISAName(NoiseISA isa);
+
+#endif
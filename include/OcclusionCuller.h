@@ -0,0 +1,110 @@
+// include/OcclusionCuller.h
+
+#ifndef OCCLUSION_CULLER_H
+#define OCCLUSION_CULLER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Shader.h"
+
+// View frustum as six planes (a, b, c, d) with the normals pointing inside
+struct Frustum {
+    glm::vec4 planes[6];
+
+    // Gribb / Hartmann plane extraction from projection * view
+    void Extract(const glm::mat4& viewProjection);
+    // False only if the box is entirely outside one of the planes
+    bool Intersects(glm::vec3 boxMin, glm::vec3 boxMax) const;
+};
+
+struct OcclusionStats {
+    size_t chunks = 0;    // Chunks with a mesh
+    size_t inFrustum = 0;
+    size_t visible = 0;   // Drawn in the first phase (visible last frame)
+    size_t occluded = 0;  // Hidden last frame: drawn only if their box passes this frame
+    size_t queries = 0;   // Box queries issued this frame
+};
+
+// How a chunk is drawn this frame (see OcclusionCuller)
+enum class ChunkVisibility {
+    Culled,  // Outside the frustum
+    Visible, // Draw it in the first phase
+    Tested   // Draw it after IssueQueries(), between BeginConditional() / EndConditional()
+};
+
+// Two-phase occlusion culling of chunk meshes with hardware occlusion queries.
+//
+// Phase 1 draws the chunks that were visible last frame, which fills the depth buffer with (nearly)
+// this frame's occluders. IssueQueries() then draws the bounding box of every chunk in the frustum
+// against that depth, colour and depth writes off, in a GL_ANY_SAMPLES_PASSED_CONSERVATIVE query.
+// Phase 2 draws the chunks that were hidden last frame under conditional rendering on their query,
+// so a chunk coming out from behind a hill appears the same frame; the GPU discards the draw when
+// the box was occluded, without a round trip to the CPU. Query results are read back one frame
+// later, only once available (no stall), and decide which chunks are visible next frame.
+// Core GL 4.3 queries only, so it runs on Mesa llvmpipe too.
+class OcclusionCuller {
+public:
+    OcclusionCuller() = default;
+    ~OcclusionCuller();
+
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    // Needs a current GL context. Box shaders are loaded from vertexPath / fragmentPath.
+    void Init(const char* vertexPath, const char* fragmentPath);
+    // Deletes every query and the box buffers (the GL context must still be current)
+    void Shutdown();
+    // Disabled, every chunk in the frustum is Visible and no queries are issued
+    void SetEnabled(bool enable) { enabled = enable; }
+    bool IsEnabled() const { return enabled; }
+
+    // Collects the query results that have arrived and starts a frame seen through viewProjection
+    void BeginFrame(const glm::mat4& viewProjection, glm::vec3 cameraPos);
+    // Classifies one chunk for this frame; boxMin / boxMax bound its mesh in world coordinates.
+    // Call once per chunk per frame, before IssueQueries().
+    ChunkVisibility Classify(int64_t key, glm::vec3 boxMin, glm::vec3 boxMax);
+    // After phase 1: issues the box queries (changes the bound program, VAO and write masks, and
+    // restores the masks)
+    void IssueQueries();
+    // Wraps the draws of a Tested chunk
+    void BeginConditional(int64_t key) const;
+    void EndConditional() const;
+
+    // A chunk lost its mesh (evicted): drops its query
+    void Release(int64_t key);
+
+    const OcclusionStats& GetStats() const { return stats; }
+
+private:
+    struct ChunkState {
+        unsigned int query = 0;
+        bool visible = true;   // Last known answer; new chunks start visible (phase 1)
+        bool pending = false;  // Query issued, result not read yet
+        bool queued = false;   // In this frame's query list
+    };
+    struct QueuedBox {
+        int64_t key;
+        glm::vec3 center;
+        glm::vec3 size;
+    };
+
+    bool enabled = true;
+    Frustum frustum;
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    glm::vec3 cameraPos = glm::vec3(0.0f);
+    std::unordered_map<int64_t, ChunkState> states;
+    std::vector<QueuedBox> boxes;
+    std::vector<unsigned int> freeQueries;
+    std::unique_ptr<Shader> boxShader;
+    int centerLocation = -1; // Uniform locations of the box shader
+    int sizeLocation = -1;
+    unsigned int boxVAO = 0;
+    unsigned int boxVBO = 0;
+    OcclusionStats stats;
+};
+
+#endif
@@ -0,0 +1,133 @@
+// include/RegionFile.h
+
+#ifndef REGION_FILE_H
+#define REGION_FILE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "World.h"
+
+// --- Region File Layout ---
+// A region file stores REGION_SIZE x REGION_SIZE chunk columns in REGION_SECTOR_SIZE byte sectors.
+// Sector 0 is the offset table: one uint32 per chunk, (firstSector << 8) | sectorCount, 0 = absent.
+// Each chunk payload starts with a 5 byte header: uint32 payload length, uint8 codec (RegionCodec).
+const int REGION_SIZE = 32;
+const int REGION_CHUNKS = REGION_SIZE * REGION_SIZE;
+const int REGION_SECTOR_SIZE = 4096;
+const int REGION_MAX_CHUNK_SECTORS = 255; // Largest payload: ~1 MB
+const size_t REGION_MAX_PAYLOAD = (size_t)REGION_MAX_CHUNK_SECTORS * REGION_SECTOR_SIZE - 5;
+
+// Payload encodings (the codec byte). New encodings get new values; old files stay readable.
+enum RegionCodec : uint8_t {
+    REGION_CODEC_RLE = 1,        // Run-length encoded block IDs and fluid levels
+    REGION_CODEC_PALETTE_LZ = 2, // Palette + run-length, then LZ (see ChunkCodec.h); written by current versions
+    REGION_CODEC_MESH_FACES = 3  // Cached chunk mesh (see MeshCache.h); only found in mesh cache regions
+};
+
+// One region file on disk, with random access to single chunks.
+//
+// Reads use pread under a shared lock, so any number of streaming threads can load chunks at once.
+// Writes take the lock exclusively and are copy-on-write: the new payload goes to freshly allocated
+// sectors, then the offset table entry is switched, then the old sectors are freed. Freed sectors
+// are reused first-fit by later writes, so the file does not keep growing as chunks are re-saved.
+//
+// A durable file (the default) survives power loss as well as a process crash mid-write: the
+// payload is flushed (fdatasync) before the table entry that points at it is written, and the old
+// sectors are only freed once that entry has been flushed too (by the next write or Sync()), so
+// until then the previous version of the chunk is intact on disk. Without durable, writes are only
+// safe against a process crash (for data that can be rebuilt, like the mesh cache).
+class RegionFile {
+public:
+    RegionFile() = default;
+    ~RegionFile();
+
+    RegionFile(const RegionFile&) = delete;
+    RegionFile& operator=(const RegionFile&) = delete;
+
+    // Opens (and with create = true, creates) the file. Returns false if it cannot be opened
+    // or its offset table is corrupt. Entries pointing outside the file or at sectors another
+    // entry already claims are dropped with a warning.
+    bool Open(const std::string& path, bool create, bool durable = true);
+    void Close();
+    bool IsOpen() const { return fd >= 0; }
+
+    // localX / localZ are chunk coordinates within the region, [0, REGION_SIZE)
+    bool HasChunk(int localX, int localZ) const;
+    // Fills chunk.blocks / chunk.fluidLevel. Returns false if the chunk is absent or unreadable.
+    bool ReadChunk(int localX, int localZ, Chunk& chunk) const;
+    bool WriteChunk(int localX, int localZ, const Chunk& chunk);
+
+    // Raw payload access for other per-chunk data kept in the same format (e.g. the mesh cache).
+    // ReadPayload returns false if the slot is empty or its header is corrupt; WritePayload fails
+    // for payloads over REGION_MAX_PAYLOAD.
+    bool ReadPayload(int localX, int localZ, std::vector<uint8_t>& payload, uint8_t& codec) const;
+    bool WritePayload(int localX, int localZ, const uint8_t* payload, size_t size, uint8_t codec);
+
+    // Flushes every write so far to disk and frees the sectors they replaced. False if the flush failed.
+    bool Sync();
+
+    // Allocator stats (in sectors, including the offset table)
+    size_t SectorCount() const;
+    size_t FreeSectorCount() const;
+
+private:
+    static int TableIndex(int localX, int localZ) { return localZ * REGION_SIZE + localX; }
+    // First-fit search for count free sectors; extends the file if no gap is large enough
+    uint32_t AllocateSectors(uint32_t count);
+    void SetSectors(uint32_t first, uint32_t count, bool used);
+    // Frees the sectors of table entries replaced before the last flush
+    void FreeRetiredSectors();
+
+    int fd = -1;
+    bool durable = true;
+    std::vector<uint32_t> retiredEntries; // Replaced table entries whose sectors wait for a flush
+    uint32_t offsets[REGION_CHUNKS] = {};
+    std::vector<bool> sectorUsed; // One flag per sector in the file
+    mutable std::shared_mutex lock;
+};
+
+// Directory of region files making up one saved world. Thread-safe.
+class RegionStore {
+public:
+    // durable: see RegionFile
+    explicit RegionStore(const std::string& directory, bool durable = true);
+
+    // Reads chunk (chunk.chunkX, chunk.chunkZ). Returns false if it was never saved.
+    bool LoadChunk(Chunk& chunk);
+    bool SaveChunk(const Chunk& chunk);
+
+    // RegionFile::ReadPayload / WritePayload for chunk (chunkX, chunkZ)
+    bool LoadPayload(int chunkX, int chunkZ, std::vector<uint8_t>& payload, uint8_t& codec);
+    bool SavePayload(int chunkX, int chunkZ, const uint8_t* payload, size_t size, uint8_t codec);
+
+    // Flushes every region file written since the last call (RegionFile::Sync). Call before
+    // anything that relies on the saves surviving power loss, e.g. deleting the journal.
+    // False if any flush failed.
+    bool Sync();
+
+    const std::string& Directory() const { return directory; }
+
+    static int ToRegionCoord(int chunk) { return (chunk >= 0) ? chunk / REGION_SIZE : -((-chunk - 1) / REGION_SIZE) - 1; }
+
+private:
+    // Returns the open region file, opening it on first use. Without create, a missing file returns nullptr.
+    RegionFile* GetRegion(int regionX, int regionZ, bool create);
+
+    std::string directory;
+    bool durable;
+    std::mutex regionsMutex;
+    std::unordered_map<int64_t, std::unique_ptr<RegionFile>> regions;
+    std::unordered_set<RegionFile*> unsynced; // Written since the last Sync()
+};
+
+// Chunk payload encoding (shared by the region files and anything else that stores chunks)
+void EncodeChunkRLE(const Chunk& chunk, std::vector<uint8_t>& out);
+bool DecodeChunkRLE(const uint8_t* data, size_t size, Chunk& chunk);
+
+#endif
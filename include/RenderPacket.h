@@ -0,0 +1,106 @@
+// include/RenderPacket.h
+
+#ifndef RENDER_PACKET_H
+#define RENDER_PACKET_H
+
+#include <glm/glm.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Mesher.h"
+#include "CaveCulling.h"
+
+// Packets in flight: the game thread fills one while the render thread draws the other
+const int RENDER_PACKET_COUNT = 2;
+
+// A chunk mesh built on the game thread, uploaded by the render thread
+struct ChunkUpload {
+    int64_t key = 0;
+    ChunkMesh mesh;
+    std::vector<uint32_t> translucentIndices; // Translucent faces back to front for the packet's camera
+    glm::vec3 boundsMin = glm::vec3(0.0f);    // Box around every vertex (opaque and translucent)
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+};
+
+// A new back-to-front order for the translucent faces of an already uploaded chunk
+struct TranslucentIndexUpdate {
+    int64_t key = 0;
+    std::vector<uint32_t> indices;
+};
+
+// A chunk to draw this frame, with the sections the cave search reached (see CaveCuller)
+struct ChunkDraw {
+    int64_t key;
+    uint8_t visibleSections;
+};
+
+// Everything the render thread needs for one frame, prepared by the game thread: the camera and
+// light, the GPU buffer changes (applied in order: releases, uploads, index updates) and the
+// draw lists. Nothing in it refers to GL; the render thread owns every GL object.
+//
+// Packets are reused: Clear() keeps the capacity of every list, and the chunk meshes of the
+// uploads stay allocated as arenas for the next frames (see ChunkMesh), so a steady stream of
+// frames allocates nothing.
+struct RenderPacket {
+    uint64_t frame = 0;
+    glm::mat4 view = glm::mat4(1.0f);
+    glm::mat4 projection = glm::mat4(1.0f);
+    glm::vec3 cameraPos = glm::vec3(0.0f);
+    glm::vec3 lightPos = glm::vec3(0.0f);
+    glm::vec3 lightColor = glm::vec3(1.0f);
+
+    std::vector<int64_t> releases; // Chunks whose buffers are freed (evicted)
+    std::vector<ChunkUpload> uploads;
+    size_t uploadCount = 0;        // Entries of uploads in use this frame
+    std::vector<TranslucentIndexUpdate> indexUpdates;
+    size_t indexUpdateCount = 0;
+
+    std::vector<ChunkDraw> draws;          // Every meshed chunk with a visible section
+    std::vector<int64_t> translucentOrder; // The drawn chunks with translucent faces, farthest first
+
+    bool updateTitle = false; // title holds the game side of the window title
+    std::string title;
+    CaveCullStats caves;
+    int benchmarkFrame = -1;  // Measured frame: of the --headless camera path or a --replay (-1 while the view loads)
+    uint64_t tick = 0;        // Simulation ticks done when the packet was built
+    double buildMilliseconds = 0.0;
+    bool replayDone = false;  // --replay: the log's last tick has run
+
+    void Clear();
+    // The next upload, to be filled in place (its mesh keeps its buffers from earlier frames);
+    // counted in uploadCount once CommitUpload() is called
+    ChunkUpload& NextUpload();
+    void CommitUpload() { ++uploadCount; }
+    TranslucentIndexUpdate& AddIndexUpdate();
+};
+
+// In-order hand-off of packets from the game thread to the render thread. Every packet is drawn
+// (it carries buffer changes), so the writer waits while RENDER_PACKET_COUNT packets are queued or
+// being drawn, and the reader waits for the next finished packet. With two packets the game thread
+// prepares frame N+1 while the render thread draws frame N, and a GL stall holds up the game
+// thread by at most one frame.
+class RenderPacketQueue {
+public:
+    // The packet to fill next. nullptr once stopped.
+    RenderPacket* BeginWrite();
+    // Queues the packet from BeginWrite()
+    void EndWrite();
+    // The oldest finished packet. nullptr once stopped.
+    RenderPacket* BeginRead();
+    // Hands the packet from BeginRead() back to the writer
+    void EndRead();
+    // Wakes and refuses both sides (shutdown)
+    void Stop();
+
+private:
+    RenderPacket packets[RENDER_PACKET_COUNT];
+    uint64_t written = 0; // Packets queued so far
+    uint64_t read = 0;    // Packets drawn so far
+    bool stopped = false;
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+#endif
@@ -0,0 +1,65 @@
+// include/SpatialHash.h
+
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "Entities.h"
+
+// Uniform-grid broadphase for entity-entity queries (collision pairs, pickup radius, AI sensing).
+//
+// Every entity is stored once, in the grid cell containing its center; cells are hashed into a
+// power-of-two bucket table and the entries are laid out bucket by bucket with a counting sort,
+// so a rebuild is two linear passes and a query scans contiguous runs of entries.
+// Queries widen their search by the largest half extent seen during Build, so bodies that
+// straddle cell borders are still found.
+//
+// Build() reuses its arrays between ticks and queries write into caller-owned buffers,
+// so neither allocates once the table has grown to the entity count.
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize = 2.0f);
+
+    // Rebuilds the grid from the current entity positions. Call once per tick after physics.
+    void Build(const EntityStore& entities);
+
+    // Writes the indices of entities whose AABB overlaps [boxMin, boxMax] into out.
+    // Returns the number of matches found; only the first maxResults are written.
+    uint32_t QueryAABB(glm::vec3 boxMin, glm::vec3 boxMax, uint32_t* out, uint32_t maxResults) const;
+
+    // Writes the indices of entities whose AABB comes within radius of center.
+    uint32_t QueryRadius(glm::vec3 center, float radius, uint32_t* out, uint32_t maxResults) const;
+
+    uint32_t EntryCount() const { return (uint32_t)entries.size(); }
+    float CellSize() const { return cellSize; }
+
+private:
+    static uint32_t HashCell(int x, int y, int z);
+    uint32_t QueryCells(glm::vec3 boxMin, glm::vec3 boxMax, glm::vec3 center, float radiusSq, bool useRadius,
+                        uint32_t* out, uint32_t maxResults) const;
+
+    float cellSize;
+    float invCellSize;
+    glm::vec3 maxHalfExtent = glm::vec3(0.0f);
+    uint32_t bucketMask = 0;
+
+    std::vector<uint32_t> bucketStart; // bucketStart[b]..bucketStart[b+1] = entries in bucket b
+
+    // Everything a query reads for one entity, kept together so the scatter in Build and the
+    // bucket scan in a query each touch a single cache line per entry
+    struct Entry {
+        glm::vec3 boxMin;  // Entity AABB
+        glm::vec3 boxMax;
+        glm::ivec3 cell;   // Cell the entity was binned into (filters hash collisions)
+        uint32_t index;    // Entity index
+    };
+    std::vector<Entry> entries; // Sorted by bucket
+
+    // Build scratch
+    std::vector<uint32_t> scratchBucket;
+    std::vector<glm::ivec3> scratchCell;
+};
+
+#endif
@@ -0,0 +1,57 @@
+// include/TerrainGen.h
+
+#ifndef TERRAIN_GEN_H
+#define TERRAIN_GEN_H
+
+#include <cstdint>
+#include "World.h"
+#include "Noise.h"
+
+// --- Terrain Settings ---
+// Block IDs default to the entries in data/blocks.json.
+struct TerrainSettings {
+    uint32_t seed = 1337;
+
+    int baseHeight = 24;           // Surface height where the height noise is 0
+    float heightAmplitude = 40.0f; // Blocks of surface height per unit of height noise (noise stays within ~[-0.5, 0.5])
+    int seaLevel = 22;             // Air at or below this height is filled with water
+    int dirtDepth = 3;             // Dirt layers under the surface block
+
+    FractalParams heightNoise = { 5, 1.0f / 96.0f, 2.0f, 0.5f };
+    FractalParams caveNoise = { 2, 1.0f / 24.0f, 2.0f, 0.5f };
+    float caveThreshold = 0.22f; // 3D noise above this is carved out (below the surface only)
+
+    BlockID stoneID = 4;
+    BlockID dirtID = 1;
+    BlockID grassID = 2;
+    BlockID waterID = 3;
+};
+
+// Procedural terrain: a fractal 2D height field with 3D-noise caves, stone under dirt under grass,
+// and water filling everything below sea level.
+//
+// A chunk depends only on (seed, chunkX, chunkZ), so chunks can be generated in any order, on any
+// thread (GenerateChunk is const and keeps no shared scratch), and regenerated identically later.
+// Noise is evaluated a chunk row at a time through GradientNoise's SIMD row functions.
+class TerrainGenerator {
+public:
+    explicit TerrainGenerator(const TerrainSettings& settings = TerrainSettings());
+
+    // Overwrites chunk.blocks (and clears chunk.fluidLevel) for chunk.chunkX / chunk.chunkZ.
+    // Writes the chunk directly: the caller decides when the chunk becomes visible / dirty.
+    void GenerateChunk(Chunk& chunk) const;
+
+    // Surface height of the height field at a block column (ignores caves)
+    int SurfaceHeight(int x, int z) const;
+
+    const TerrainSettings& Settings() const { return settings; }
+
+private:
+    int HeightFromNoise(float n) const;
+
+    TerrainSettings settings;
+    GradientNoise heightNoise;
+    GradientNoise caveNoise;
+};
+
+#endif
@@ -0,0 +1,32 @@
+// include/VoxelCollision.h
+
+#ifndef VOXEL_COLLISION_H
+#define VOXEL_COLLISION_H
+
+#include <glm/glm.hpp>
+#include "World.h"
+
+// Largest distance (in blocks) a body may travel along one axis in a single sweep.
+// Faster motion is clamped, which bounds the cells inspected per step and makes tunnelling impossible.
+const float MAX_SWEEP_DISTANCE = 4.0f;
+
+// Result of moving an AABB through the voxel grid for one step.
+struct AABBSweepResult {
+    glm::vec3 position = glm::vec3(0.0f); // New AABB center
+    glm::vec3 velocity = glm::vec3(0.0f); // Input velocity with blocked components zeroed
+    float timeOfImpact = 1.0f;            // Fraction of the step (0..1) at the first contact; 1 = no contact
+    glm::ivec3 normal = glm::ivec3(0);    // Contact normal per axis, e.g. (0, 1, 0) when landing on a floor
+    int cellLookups = 0;                  // Opacity queries issued (for profiling)
+
+    bool hitAny() const { return normal.x != 0 || normal.y != 0 || normal.z != 0; }
+    bool grounded() const { return normal.y > 0; }
+};
+
+// Moves an AABB (center, halfSize) by velocity * dt against the opaque cells of the world.
+// Axes are resolved separately (Y, then X, then Z); each axis is swept cell-slab by cell-slab from
+// the leading face, so the body stops flush against the first opaque cell instead of being pushed
+// out after overlapping it. Cells the box already overlaps are ignored, which prevents snagging
+// on the seams between neighbouring floor blocks.
+AABBSweepResult SweepAABB(const World& world, glm::vec3 center, glm::vec3 halfSize, glm::vec3 velocity, float dt);
+
+#endif
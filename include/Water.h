@@ -0,0 +1,52 @@
+// include/Water.h
+
+#ifndef WATER_H
+#define WATER_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "World.h"
+#include "BlockTicks.h"
+
+// --- Water Flow Constants ---
+const int WATER_MAX_LEVEL = 7;             // Flowing water reaches this many blocks from its source
+const uint64_t WATER_TICK_DELAY = 5;       // Simulation ticks between flow steps (12 steps/sec at 60 Hz)
+const size_t WATER_UPDATE_BUDGET = 4096;   // Most cells processed in one tick; the rest wait a tick
+
+// Cellular-automaton fluid flow built on the block tick scheduler.
+//
+// Any block marked "is_fluid" flows. Level 0 is a source that never drains; flowing cells carry
+// level 1..WATER_MAX_LEVEL (distance from the feeding source) in Chunk::fluidLevel.
+// Each step a cell falls into air below it, or, when resting on a solid block, spreads sideways
+// with level + 1. Flowing cells that lose their feeding neighbour dry up.
+//
+// Only scheduled cells are visited and every change goes through World::setBlock, so only the
+// chunks water actually touches are marked dirty for remeshing.
+class WaterSimulation {
+public:
+    // Call after a block edit so the cell and any fluid next to it re-evaluate their flow
+    void OnBlockChanged(const World& world, int x, int y, int z, uint64_t currentTick);
+
+    // Runs every flow update that is due. Returns the number of cells updated.
+    size_t Update(World& world, uint64_t currentTick);
+
+    // Drops queued updates for an unloaded chunk
+    void ClearChunk(int chunkX, int chunkZ) { scheduler.ClearChunk(chunkX, chunkZ); }
+
+    size_t PendingCount() const { return scheduler.PendingCount(); }
+    // Chunks with queued flow updates. Flow reads and spreads into their horizontal neighbours too.
+    void GetPendingChunks(std::vector<int64_t>& out) const { scheduler.GetChunkKeys(out); }
+    uint64_t TotalCellsUpdated() const { return totalCellsUpdated; }
+
+private:
+    void UpdateCell(World& world, glm::ivec3 p, uint64_t currentTick);
+    void PlaceFluid(World& world, glm::ivec3 p, BlockID id, uint8_t level, uint64_t currentTick);
+    void WakeFluidNeighbours(const World& world, glm::ivec3 p, uint64_t currentTick);
+
+    BlockTickScheduler scheduler;
+    std::vector<glm::ivec3> dueCells; // Reused between updates
+    uint64_t totalCellsUpdated = 0;
+};
+
+#endif
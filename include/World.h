@@ -0,0 +1,133 @@
+// include/World.h
+
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Block IDs are stored as 16-bit values (blocks.json uses IDs well above 255)
+typedef uint16_t BlockID;
+
+// --- Chunk Dimensions ---
+// The world is split into vertical chunk columns of CHUNK_SIZE x CHUNK_HEIGHT x CHUNK_SIZE blocks.
+const int CHUNK_SIZE   = 16;
+const int CHUNK_HEIGHT = 64;
+const int CHUNK_VOLUME = CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE;
+
+struct Chunk {
+    int chunkX = 0;
+    int chunkZ = 0;
+    // Stored Y-major (y, then x, then z), the same order GenerateMesh walks the world
+    BlockID blocks[CHUNK_VOLUME] = {};
+    // Per-cell fluid level (0 = source / not a fluid, higher = further from the source)
+    uint8_t fluidLevel[CHUNK_VOLUME] = {};
+    // Bumped on every edit. A chunk needs saving while version != savedVersion (see AutoSave.h).
+    uint32_t version = 0;
+    uint32_t savedVersion = 0;
+
+    bool IsModified() const { return version != savedVersion; }
+
+    static int Index(int x, int y, int z) { return (y * CHUNK_SIZE + x) * CHUNK_SIZE + z; }
+};
+
+// Per block ID property bits
+enum BlockFlags : uint8_t {
+    BLOCK_OPAQUE = 1u << 0, // Hides neighbouring faces and blocks movement
+    BLOCK_FLUID  = 1u << 1  // Flows (see Water.h)
+};
+
+class MappedWorld;
+class BrickChunk;
+
+class World {
+public:
+    World();
+    ~World(); // Out of line: BrickChunk is incomplete here
+
+    // Block access in world coordinates. Unloaded chunks and Y outside [0, CHUNK_HEIGHT) read as Air (0).
+    BlockID getBlock(int x, int y, int z) const;
+    // Changing a block marks its chunk (and any neighbour chunk sharing the face) dirty for remeshing
+    void setBlock(int x, int y, int z, BlockID id);
+
+    uint8_t getFluidLevel(int x, int y, int z) const;
+    void setFluidLevel(int x, int y, int z, uint8_t level);
+
+    // True if the cell holds any block (ID != 0)
+    bool isBlock(int x, int y, int z) const { return getBlock(x, y, z) != 0; }
+    // True if the cell holds a block marked "is_opaque" in blocks.json
+    bool isOpaque(int x, int y, int z) const { return isOpaqueID(getBlock(x, y, z)); }
+    bool isOpaqueID(BlockID id) const { return id < blockFlags.size() && (blockFlags[id] & BLOCK_OPAQUE) != 0; }
+    bool isFluidID(BlockID id) const { return id < blockFlags.size() && (blockFlags[id] & BLOCK_FLUID) != 0; }
+    unsigned int GetTextureIndex(BlockID id) const { return id < textureLUT.size() ? textureLUT[id] : 0; }
+
+    // Registers block properties (filled from the loaded block definitions)
+    void SetBlockOpacity(BlockID id, bool opaque);
+    void SetBlockFluid(BlockID id, bool fluid);
+    void SetBlockTextureIndex(BlockID id, unsigned int textureIndex);
+
+    // Serves every chunk from a baked, memory-mapped map instead of heap chunks (nullptr detaches).
+    // The world is then read-only: the non-const GetChunk() finds nothing, so edits are dropped.
+    void AttachMappedWorld(const MappedWorld* mappedWorld);
+    bool IsReadOnly() const { return mapped != nullptr; }
+
+    // Chunk management. GetChunk() only finds chunks in dense storage (see CompactChunk below).
+    Chunk* GetChunk(int chunkX, int chunkZ);
+    const Chunk* GetChunk(int chunkX, int chunkZ) const;
+    Chunk* CreateChunk(int chunkX, int chunkZ); // Returns the existing chunk if already present
+    // Takes ownership of a chunk built elsewhere (e.g. on a streaming thread); replaces any existing one
+    Chunk* InsertChunk(std::unique_ptr<Chunk> chunk);
+    bool RemoveChunk(int chunkX, int chunkZ); // Returns false if the chunk was not loaded
+    // Loaded chunks, dense or compact
+    bool IsChunkLoaded(int chunkX, int chunkZ) const;
+    size_t ChunkCount() const;
+    void GetChunkKeys(std::vector<int64_t>& out) const;
+    // The chunk's data whatever its storage: the dense chunk itself, or a compact chunk expanded
+    // into scratch. nullptr if not loaded.
+    const Chunk* ReadChunk(int chunkX, int chunkZ, Chunk& scratch) const;
+
+    // --- Compact Storage ---
+    // Far chunks can be kept as brick maps (see BrickMap.h), a fraction of a dense chunk's size.
+    // getBlock() / getFluidLevel() read them in place; setBlock() / setFluidLevel() expand them first.
+    // CompactChunk() returns false if the chunk is not dense or has unsaved edits (those stay
+    // dense, so autosaves never have to look at compact chunks).
+    bool CompactChunk(int chunkX, int chunkZ);
+    // Back to dense storage; returns the dense chunk (nullptr if not loaded)
+    Chunk* ExpandChunk(int chunkX, int chunkZ);
+    bool IsCompact(int chunkX, int chunkZ) const { return !compact.empty() && compact.count(ChunkKey(chunkX, chunkZ)) != 0; }
+    size_t CompactChunkCount() const { return compact.size(); }
+    // Block + fluid storage of every loaded chunk, dense and compact
+    size_t ChunkMemoryBytes() const;
+
+    // --- Dirty Chunk Tracking ---
+    void MarkChunkDirty(int chunkX, int chunkZ);
+    // Moves the keys of every chunk needing a remesh into out (clears the dirty set)
+    void TakeDirtyChunks(std::vector<int64_t>& out);
+
+    // Floor division helpers for converting block coordinates to chunk coordinates
+    static int ToChunkCoord(int block) { return (block >= 0) ? block / CHUNK_SIZE : -((-block - 1) / CHUNK_SIZE) - 1; }
+    static int ToLocalCoord(int block) { return block - ToChunkCoord(block) * CHUNK_SIZE; }
+    static int64_t ChunkKey(int chunkX, int chunkZ) { return ((int64_t)chunkX << 32) | (uint32_t)chunkZ; }
+    static int ChunkKeyX(int64_t key) { return (int)(key >> 32); }
+    static int ChunkKeyZ(int64_t key) { return (int)(int32_t)(uint32_t)key; }
+
+private:
+    void setFlag(BlockID id, uint8_t flag, bool enabled);
+
+    const BrickChunk* GetCompactChunk(int chunkX, int chunkZ) const;
+    bool DropCompactChunk(int64_t key); // Returns false if there was none
+
+    std::unordered_map<int64_t, std::unique_ptr<Chunk>> chunks;
+    std::unordered_map<int64_t, std::unique_ptr<BrickChunk>> compact;
+    size_t compactBytes = 0; // Sum of BrickChunk::MemoryBytes() over compact
+    const MappedWorld* mapped = nullptr;
+    std::unordered_set<int64_t> dirtyChunks;
+    // Lookup tables indexed by block ID (replace a std::map lookup per query)
+    std::vector<uint8_t> blockFlags;
+    std::vector<uint16_t> textureLUT;
+};
+
+#endif
@@ -1,4 +1,4 @@
-#version 460 core
+#version 450 core
 out vec4 FragColor;
 
 in vec3 Normal;
@@ -50,5 +50,6 @@ void main() {
 
     // 4. Final Color
     vec3 result = (ambient + diffuse + specular) * cubeColor;
-    FragColor = vec4(result, 1.0f); 
+    // Keep the texture's alpha: opaque blocks are drawn without blending, translucent ones (water) blend
+    FragColor = vec4(result, textureSample.a); 
 }
\ No newline at end of file
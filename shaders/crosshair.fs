@@ -1,5 +1,5 @@
 // shaders/crosshair.fs
-#version 460 core
+#version 450 core
 out vec4 FragColor;
 
 uniform vec3 crosshairColor; // Can be used to change color
@@ -1,5 +1,5 @@
 // shaders/crosshair.vs
-#version 460 core
+#version 450 core
 layout (location = 0) in vec2 aPos;
 
 uniform mat4 model;
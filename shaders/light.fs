@@ -1,5 +1,5 @@
 // shaders/light.fs
-#version 460 core
+#version 450 core
 out vec4 FragColor;
 uniform vec3 cubeColor; // <--- The uniform must exist
 
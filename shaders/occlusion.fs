@@ -0,0 +1,5 @@
+#version 450 core
+
+// Colour writes are off during occlusion queries; only the depth test matters
+void main() {
+}
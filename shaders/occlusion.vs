@@ -0,0 +1,11 @@
+#version 450 core
+layout (location = 0) in vec3 aPos; // Unit cube, centred at the origin
+
+// Chunk bounding box for an occlusion query (see OcclusionCuller.h)
+uniform mat4 viewProjection;
+uniform vec3 boxCenter;
+uniform vec3 boxSize;
+
+void main() {
+    gl_Position = viewProjection * vec4(boxCenter + aPos * boxSize, 1.0);
+}
@@ -0,0 +1,71 @@
+#version 450 core
+// Vertex pulling: no vertex attributes. Each face of the chunk is one 8-byte record in a shader
+// storage buffer (see PackFaceRecords in Mesher.h); a face is drawn as 6 vertices, and gl_VertexID
+// picks the record (gl_VertexID / 6) and which of the face's 4 corners this vertex is.
+// The outputs match basic.vs, so the same fragment shader lights both.
+
+layout (std430, binding = 0) readonly buffer ChunkFaces {
+    ivec2 chunkOrigin; // World block coordinates (x, z) of the chunk's corner
+    uvec2 faces[];     // x: cell, face and LOD scale; y: block ID and texture index
+};
+
+out vec3 Normal;
+out vec3 FragPos;
+out vec2 TexCoords;
+out float BlockID;
+out float TexIndex;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+// Face normals in FACE_OFFSETS order (+Y, -Y, +Z, -Z, -X, +X)
+const vec3 NORMALS[6] = vec3[6](
+    vec3(0.0, 1.0, 0.0), vec3(0.0, -1.0, 0.0), vec3(0.0, 0.0, 1.0),
+    vec3(0.0, 0.0, -1.0), vec3(-1.0, 0.0, 0.0), vec3(1.0, 0.0, 0.0)
+);
+// The 4 corners of each face of the unit cube (centred at the origin) and their texture coordinates
+const vec3 CORNERS[24] = vec3[24](
+    vec3(-0.5, 0.5, -0.5), vec3(0.5, 0.5, -0.5), vec3(0.5, 0.5, 0.5), vec3(-0.5, 0.5, 0.5),
+    vec3(-0.5, -0.5, -0.5), vec3(0.5, -0.5, 0.5), vec3(0.5, -0.5, -0.5), vec3(-0.5, -0.5, 0.5),
+    vec3(-0.5, -0.5, 0.5), vec3(0.5, -0.5, 0.5), vec3(0.5, 0.5, 0.5), vec3(-0.5, 0.5, 0.5),
+    vec3(-0.5, -0.5, -0.5), vec3(0.5, 0.5, -0.5), vec3(0.5, -0.5, -0.5), vec3(-0.5, 0.5, -0.5),
+    vec3(-0.5, 0.5, 0.5), vec3(-0.5, 0.5, -0.5), vec3(-0.5, -0.5, -0.5), vec3(-0.5, -0.5, 0.5),
+    vec3(0.5, 0.5, 0.5), vec3(0.5, -0.5, -0.5), vec3(0.5, 0.5, -0.5), vec3(0.5, -0.5, 0.5)
+);
+const vec2 CORNER_UVS[24] = vec2[24](
+    vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(1.0, 0.0), vec2(0.0, 0.0),
+    vec2(0.0, 1.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 0.0),
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0),
+    vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(1.0, 0.0), vec2(0.0, 1.0),
+    vec2(1.0, 1.0), vec2(0.0, 1.0), vec2(0.0, 0.0), vec2(1.0, 0.0),
+    vec2(0.0, 1.0), vec2(1.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 0.0)
+);
+// Corner of each of a face's 6 vertices (the two triangles of FACE_VERTICES, same winding)
+const int FACE_CORNERS[36] = int[36](
+    0, 1, 2, 2, 3, 0,
+    0, 1, 2, 0, 3, 1,
+    0, 1, 2, 2, 3, 0,
+    0, 1, 2, 0, 3, 1,
+    0, 1, 2, 2, 3, 0,
+    0, 1, 2, 0, 3, 1
+);
+
+void main() {
+    uvec2 record = faces[gl_VertexID / 6];
+    int face = int((record.x >> 14) & 7u);
+    int corner = face * 4 + FACE_CORNERS[face * 6 + gl_VertexID % 6];
+
+    // A scale^3 LOD cell spans blocks (x, y, z) .. + scale - 1: the unit cube scaled about its centre
+    float scale = float(1u << ((record.x >> 17) & 3u));
+    vec3 block = vec3(chunkOrigin.x + int(record.x & 15u), int((record.x >> 8) & 63u), chunkOrigin.y + int((record.x >> 4) & 15u));
+    vec3 aPos = CORNERS[corner] * scale + (block + 0.5 * (scale - 1.0));
+
+    FragPos = vec3(model * vec4(aPos, 1.0));
+    Normal = mat3(transpose(inverse(model))) * NORMALS[face];
+    gl_Position = projection * view * model * vec4(aPos, 1.0);
+
+    TexCoords = CORNER_UVS[corner] * scale; // The texture repeats once per block
+    BlockID = float(record.y & 0xFFFFu);
+    TexIndex = float(record.y >> 16);
+}
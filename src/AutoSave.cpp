@@ -0,0 +1,194 @@
+// src/AutoSave.cpp
+
+#include "AutoSave.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+AutoSaver::AutoSaver(RegionStore& store) : store(store) {
+    ioThread = std::thread(&AutoSaver::IOLoop, this);
+}
+
+AutoSaver::~AutoSaver() {
+    Stop();
+}
+
+std::unique_ptr<Chunk> AutoSaver::AcquireSnapshot() {
+    // Caller holds mutex
+    if (pool.empty()) {
+        return std::make_unique<Chunk>();
+    }
+    std::unique_ptr<Chunk> snapshot = std::move(pool.back());
+    pool.pop_back();
+    return snapshot;
+}
+
+size_t AutoSaver::SnapshotModified(World& world) {
+    auto start = std::chrono::steady_clock::now();
+
+    thread_local std::vector<int64_t> keys;
+    world.GetChunkKeys(keys);
+
+    size_t queued = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int64_t key : keys) {
+            Chunk* chunk = world.GetChunk(World::ChunkKeyX(key), World::ChunkKeyZ(key));
+            if (!chunk || !chunk->IsModified()) continue;
+
+            std::unique_ptr<Chunk> snapshot = AcquireSnapshot();
+            *snapshot = *chunk; // Plain arrays: one flat copy
+            chunk->savedVersion = chunk->version;
+
+            newest[key] = snapshot.get();
+            queue.push_back({ std::move(snapshot), nullptr });
+            ++queued;
+        }
+        lastSnapshotMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    if (queued > 0) {
+        workAvailable.notify_one();
+    }
+    return queued;
+}
+
+void AutoSaver::Enqueue(const Chunk& chunk) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unique_ptr<Chunk> snapshot = AcquireSnapshot();
+        *snapshot = chunk;
+        newest[World::ChunkKey(chunk.chunkX, chunk.chunkZ)] = snapshot.get();
+        queue.push_back({ std::move(snapshot), nullptr });
+    }
+    workAvailable.notify_one();
+}
+
+void AutoSaver::AfterWrites(std::function<void(bool allSaved)> done) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back({ nullptr, std::move(done) });
+    }
+    workAvailable.notify_one();
+}
+
+void AutoSaver::SetSavedCallback(std::function<void(const std::vector<int64_t>& keys)> saved) {
+    std::lock_guard<std::mutex> lock(mutex);
+    savedCallback = std::move(saved);
+}
+
+bool AutoSaver::ReadPending(Chunk& chunk) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = newest.find(World::ChunkKey(chunk.chunkX, chunk.chunkZ));
+    if (it == newest.end()) {
+        return false;
+    }
+    std::memcpy(chunk.blocks, it->second->blocks, sizeof(chunk.blocks));
+    std::memcpy(chunk.fluidLevel, it->second->fluidLevel, sizeof(chunk.fluidLevel));
+    return true;
+}
+
+bool AutoSaver::SyncWrites() {
+    if (!store.Sync()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++writeErrors;
+        std::cerr << "ERROR::AUTOSAVE: Failed to flush saved chunks to disk" << std::endl;
+        return false;
+    }
+    std::function<void(const std::vector<int64_t>&)> saved;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        saved = savedCallback;
+    }
+    if (saved && !savedKeys.empty()) {
+        saved(savedKeys);
+    }
+    savedKeys.clear();
+    return true;
+}
+
+void AutoSaver::IOLoop() {
+    while (true) {
+        Pending next;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workAvailable.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                lock.unlock();
+                SyncWrites();
+                return; // Stopping, and everything queued has been written
+            }
+            next = std::move(queue.front());
+            queue.pop_front();
+            writing = true;
+        }
+
+        if (!next.snapshot) {
+            SyncWrites();
+            bool allSaved;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                allSaved = (writeErrors == 0);
+            }
+            next.done(allSaved);
+            std::lock_guard<std::mutex> lock(mutex);
+            writing = false;
+            if (queue.empty()) {
+                queueDrained.notify_all();
+            }
+            continue;
+        }
+        std::unique_ptr<Chunk>& snapshot = next.snapshot;
+
+        // Encoding and disk I/O happen here, off the game thread. The snapshot stays
+        // visible to ReadPending() until it is on disk.
+        const bool saved = store.SaveChunk(*snapshot);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        const int64_t key = World::ChunkKey(snapshot->chunkX, snapshot->chunkZ);
+        auto it = newest.find(key);
+        if (it != newest.end() && it->second == snapshot.get()) {
+            newest.erase(it); // No newer snapshot queued behind this one
+        }
+        if (saved) {
+            ++chunksWritten;
+            savedKeys.push_back(key);
+        } else {
+            ++writeErrors;
+            std::cerr << "ERROR::AUTOSAVE: Failed to save chunk " << snapshot->chunkX << "," << snapshot->chunkZ << std::endl;
+        }
+        pool.push_back(std::move(snapshot));
+        writing = false;
+        if (queue.empty()) {
+            queueDrained.notify_all();
+        }
+    }
+}
+
+void AutoSaver::Flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    queueDrained.wait(lock, [this] { return queue.empty() && !writing; });
+}
+
+void AutoSaver::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    if (ioThread.joinable()) {
+        ioThread.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    pool.clear();
+}
+
+AutoSaveStats AutoSaver::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    AutoSaveStats stats;
+    stats.pendingChunks = queue.size() + (writing ? 1 : 0);
+    stats.chunksWritten = chunksWritten;
+    stats.writeErrors = writeErrors;
+    stats.lastSnapshotMs = lastSnapshotMs;
+    return stats;
+}
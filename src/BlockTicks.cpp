@@ -0,0 +1,90 @@
+// src/BlockTicks.cpp
+
+#include "BlockTicks.h"
+
+void BlockTickScheduler::Schedule(int x, int y, int z, uint64_t dueTick) {
+    if (y < 0 || y >= CHUNK_HEIGHT) {
+        return;
+    }
+
+    const int chunkX = World::ToChunkCoord(x);
+    const int chunkZ = World::ToChunkCoord(z);
+    const uint32_t localIndex = (uint32_t)Chunk::Index(World::ToLocalCoord(x), y, World::ToLocalCoord(z));
+
+    ChunkQueue& queue = chunks[World::ChunkKey(chunkX, chunkZ)];
+    auto it = queue.pending.find(localIndex);
+    if (it != queue.pending.end()) {
+        if (it->second <= dueTick) {
+            return; // Already scheduled at or before this tick
+        }
+        it->second = dueTick; // Pull forward; the old heap entry becomes stale
+    } else {
+        queue.pending.emplace(localIndex, dueTick);
+        ++pendingTotal;
+    }
+    queue.heap.push({dueTick, localIndex});
+}
+
+size_t BlockTickScheduler::CollectDue(uint64_t currentTick, size_t maxUpdates, std::vector<glm::ivec3>& out) {
+    out.clear();
+
+    // Start after the chunk the last call stopped in and wrap around, visiting each chunk once
+    auto it = chunks.find(nextChunkKey);
+    if (it == chunks.end()) {
+        it = chunks.begin();
+    }
+    for (size_t visited = 0, chunkCount = chunks.size(); visited < chunkCount && out.size() < maxUpdates; ++visited) {
+        if (it == chunks.end()) {
+            it = chunks.begin();
+        }
+        ChunkQueue& queue = it->second;
+        const int baseX = World::ChunkKeyX(it->first) * CHUNK_SIZE;
+        const int baseZ = World::ChunkKeyZ(it->first) * CHUNK_SIZE;
+
+        while (!queue.heap.empty() && queue.heap.top().dueTick <= currentTick && out.size() < maxUpdates) {
+            Entry entry = queue.heap.top();
+            queue.heap.pop();
+
+            // Skip stale entries left behind when a cell was rescheduled earlier
+            auto pending = queue.pending.find(entry.localIndex);
+            if (pending == queue.pending.end() || pending->second != entry.dueTick) {
+                continue;
+            }
+            queue.pending.erase(pending);
+            --pendingTotal;
+
+            // Undo Chunk::Index: (y * CHUNK_SIZE + x) * CHUNK_SIZE + z
+            const int z = (int)(entry.localIndex % CHUNK_SIZE);
+            const int x = (int)((entry.localIndex / CHUNK_SIZE) % CHUNK_SIZE);
+            const int y = (int)(entry.localIndex / (CHUNK_SIZE * CHUNK_SIZE));
+            out.push_back(glm::ivec3(baseX + x, y, baseZ + z));
+        }
+
+        if (queue.heap.empty()) {
+            it = chunks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (it == chunks.end()) {
+        it = chunks.begin();
+    }
+    nextChunkKey = (it != chunks.end()) ? it->first : NO_CHUNK_KEY;
+    return out.size();
+}
+
+void BlockTickScheduler::GetChunkKeys(std::vector<int64_t>& out) const {
+    out.clear();
+    out.reserve(chunks.size());
+    for (const auto& pair : chunks) {
+        out.push_back(pair.first);
+    }
+}
+
+void BlockTickScheduler::ClearChunk(int chunkX, int chunkZ) {
+    auto it = chunks.find(World::ChunkKey(chunkX, chunkZ));
+    if (it != chunks.end()) {
+        pendingTotal -= it->second.pending.size();
+        chunks.erase(it);
+    }
+}
@@ -0,0 +1,86 @@
+// src/BrickMap.cpp
+
+#include "BrickMap.h"
+
+#include <algorithm>
+#include <cstring>
+
+template <typename T>
+void BrickLayer<T>::Build(const T* cells) {
+    thread_local std::vector<T> scratch; // Dense bricks while building; copied out at the exact size
+    scratch.clear();
+
+    T brick[BRICK_VOLUME];
+    for (int by = 0; by < BRICKS_Y; ++by) {
+        for (int bx = 0; bx < BRICKS_XZ; ++bx) {
+            for (int bz = 0; bz < BRICKS_XZ; ++bz) {
+                // Gather the brick: BRICK_SIZE contiguous Z runs per (y, x) row
+                const int x0 = bx * BRICK_SIZE, y0 = by * BRICK_SIZE, z0 = bz * BRICK_SIZE;
+                bool uniform = true;
+                for (int y = 0; y < BRICK_SIZE; ++y) {
+                    for (int x = 0; x < BRICK_SIZE; ++x) {
+                        const T* row = cells + Chunk::Index(x0 + x, y0 + y, z0);
+                        T* out = brick + CellIndex(x, y, 0);
+                        std::memcpy(out, row, BRICK_SIZE * sizeof(T));
+                        for (int z = 0; z < BRICK_SIZE; ++z) {
+                            uniform &= (out[z] == brick[0]);
+                        }
+                    }
+                }
+
+                uint32_t& node = nodes[BrickIndex(bx, by, bz)];
+                if (uniform) {
+                    node = UNIFORM | (uint32_t)brick[0];
+                } else {
+                    node = (uint32_t)(scratch.size() / BRICK_VOLUME);
+                    scratch.insert(scratch.end(), brick, brick + BRICK_VOLUME);
+                }
+            }
+        }
+    }
+    bricks.assign(scratch.begin(), scratch.end());
+}
+
+template <typename T>
+void BrickLayer<T>::Expand(T* cells) const {
+    for (int by = 0; by < BRICKS_Y; ++by) {
+        for (int bx = 0; bx < BRICKS_XZ; ++bx) {
+            for (int bz = 0; bz < BRICKS_XZ; ++bz) {
+                const uint32_t node = nodes[BrickIndex(bx, by, bz)];
+                const int x0 = bx * BRICK_SIZE, y0 = by * BRICK_SIZE, z0 = bz * BRICK_SIZE;
+                const T* brick = (node & UNIFORM) ? nullptr : bricks.data() + (size_t)node * BRICK_VOLUME;
+                for (int y = 0; y < BRICK_SIZE; ++y) {
+                    for (int x = 0; x < BRICK_SIZE; ++x) {
+                        T* row = cells + Chunk::Index(x0 + x, y0 + y, z0);
+                        if (brick) {
+                            std::memcpy(row, brick + CellIndex(x, y, 0), BRICK_SIZE * sizeof(T));
+                        } else {
+                            std::fill(row, row + BRICK_SIZE, (T)(node & ~UNIFORM));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template class BrickLayer<BlockID>;
+template class BrickLayer<uint8_t>;
+
+void BrickChunk::FromChunk(const Chunk& chunk) {
+    chunkX = chunk.chunkX;
+    chunkZ = chunk.chunkZ;
+    version = chunk.version;
+    savedVersion = chunk.savedVersion;
+    blocks.Build(chunk.blocks);
+    fluid.Build(chunk.fluidLevel);
+}
+
+void BrickChunk::ToChunk(Chunk& chunk) const {
+    chunk.chunkX = chunkX;
+    chunk.chunkZ = chunkZ;
+    chunk.version = version;
+    chunk.savedVersion = savedVersion;
+    blocks.Expand(chunk.blocks);
+    fluid.Expand(chunk.fluidLevel);
+}
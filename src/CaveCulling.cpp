@@ -0,0 +1,93 @@
+// src/CaveCulling.cpp
+
+#include "CaveCulling.h"
+#include <algorithm>
+#include <cmath>
+
+// Half the diagonal of a section cube: sections whose centre is further than this behind the
+// camera plane are entirely behind it
+static const float SECTION_RADIUS = 0.8660254f * SECTION_HEIGHT;
+
+void CaveCuller::SetChunk(int64_t key, const uint16_t visibility[SECTIONS]) {
+    SectionVisibility& entry = graph[key];
+    for (int s = 0; s < SECTIONS; ++s) {
+        entry.faces[s] = visibility[s];
+    }
+}
+
+void CaveCuller::RemoveChunk(int64_t key) {
+    graph.erase(key);
+}
+
+void CaveCuller::Update(glm::vec3 cameraPos, glm::vec3 viewDirection, int maxDistance) {
+    visible.clear();
+    entered.clear();
+    queue.clear();
+
+    const int cameraChunkX = World::ToChunkCoord((int)std::floor(cameraPos.x));
+    const int cameraChunkZ = World::ToChunkCoord((int)std::floor(cameraPos.z));
+    searched = graph.count(World::ChunkKey(cameraChunkX, cameraChunkZ)) != 0;
+    if (!searched) {
+        return;
+    }
+    // Above or below the world: start from the nearest section
+    const int cameraSection = std::min(std::max((int)std::floor(cameraPos.y / SECTION_HEIGHT), 0), SECTIONS - 1);
+
+    visible[World::ChunkKey(cameraChunkX, cameraChunkZ)] = (uint8_t)(1u << cameraSection);
+    queue.push_back({ cameraChunkX, cameraSection, cameraChunkZ, -1, 0 });
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const Node node = queue[head];
+        const uint16_t faces = graph.find(World::ChunkKey(node.chunkX, node.chunkZ))->second.faces[node.section];
+
+        for (int face = 0; face < 6; ++face) {
+            const int opposite = face ^ 1; // FACE_OFFSETS pairs each face with its opposite
+            if (node.directions & (1u << opposite)) continue;
+            if (node.enteredFace >= 0 && (node.enteredFace == face || !FacesConnected(faces, node.enteredFace, face))) continue;
+
+            const int chunkX = node.chunkX + FACE_OFFSETS[face][0];
+            const int section = node.section + FACE_OFFSETS[face][1];
+            const int chunkZ = node.chunkZ + FACE_OFFSETS[face][2];
+            if (section < 0 || section >= SECTIONS) continue;
+            const int dx = chunkX - cameraChunkX, dz = chunkZ - cameraChunkZ;
+            if (dx * dx + dz * dz > maxDistance * maxDistance) continue;
+
+            // A section is searched again when reached through another face: what it lets through
+            // depends on the face it is entered by
+            const int64_t key = World::ChunkKey(chunkX, chunkZ);
+            const uint32_t enteredBit = 1u << (section * 6 + opposite);
+            auto enteredIt = entered.find(key);
+            if (enteredIt != entered.end() && (enteredIt->second & enteredBit)) continue;
+            if (graph.find(key) == graph.end()) continue;
+
+            // Skip sections entirely behind the camera
+            const glm::vec3 center((chunkX + 0.5f) * CHUNK_SIZE, (section + 0.5f) * SECTION_HEIGHT, (chunkZ + 0.5f) * CHUNK_SIZE);
+            const glm::vec3 toCenter = center - cameraPos;
+            const float along = toCenter.x * viewDirection.x + toCenter.y * viewDirection.y + toCenter.z * viewDirection.z;
+            if (along < -SECTION_RADIUS * std::sqrt(viewDirection.x * viewDirection.x + viewDirection.y * viewDirection.y +
+                                                    viewDirection.z * viewDirection.z)) {
+                continue;
+            }
+
+            visible[key] |= (uint8_t)(1u << section);
+            entered[key] |= enteredBit;
+            queue.push_back({ chunkX, section, chunkZ, opposite, (uint8_t)(node.directions | (1u << face)) });
+        }
+    }
+}
+
+CaveCullStats CaveCuller::GetStats() const {
+    CaveCullStats stats;
+    stats.chunks = graph.size();
+    if (!searched) {
+        stats.visibleChunks = graph.size();
+        stats.visibleSections = graph.size() * SECTIONS;
+        return stats;
+    }
+    for (const auto& pair : visible) {
+        ++stats.visibleChunks;
+        for (int s = 0; s < SECTIONS; ++s) {
+            stats.visibleSections += (pair.second >> s) & 1u;
+        }
+    }
+    return stats;
+}
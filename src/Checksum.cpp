@@ -0,0 +1,12 @@
+// src/Checksum.cpp
+
+#include "Checksum.h"
+
+uint64_t ChecksumBytes(uint64_t h, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= bytes[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
@@ -0,0 +1,286 @@
+// src/ChunkCodec.cpp
+
+#include "ChunkCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+// --- LZ parameters ---
+static const int LZ_MIN_MATCH = 4;
+static const int LZ_HASH_BITS = 13;
+static const size_t LZ_MAX_OFFSET = 0xFFFF;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void PutVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+static bool GetVarint(const uint8_t* data, size_t size, size_t& pos, uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (pos >= size) return false;
+        uint8_t byte = data[pos++];
+        v |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+static uint32_t Load32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+static uint64_t Load64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+// ============================================================================
+// Stage 1: palette + run-length
+// ============================================================================
+
+void EncodeChunkPalette(const Chunk& chunk, std::vector<uint8_t>& out) {
+    out.clear();
+
+    // Palette in order of first appearance; paletteIndex maps ID -> index + 1 (0 = not yet seen)
+    thread_local std::vector<uint32_t> paletteIndex(65536, 0);
+    thread_local std::vector<BlockID> palette;
+    palette.clear();
+    for (int i = 0; i < CHUNK_VOLUME; ++i) {
+        BlockID id = chunk.blocks[i];
+        if (paletteIndex[id] == 0) {
+            palette.push_back(id);
+            paletteIndex[id] = (uint32_t)palette.size();
+        }
+    }
+
+    PutVarint(out, (uint32_t)palette.size());
+    for (BlockID id : palette) {
+        PutVarint(out, id);
+    }
+
+    // Block runs along the Y-major storage order
+    int i = 0;
+    while (i < CHUNK_VOLUME) {
+        BlockID id = chunk.blocks[i];
+        int run = 1;
+        while (i + run < CHUNK_VOLUME && chunk.blocks[i + run] == id) ++run;
+        PutVarint(out, paletteIndex[id] - 1);
+        PutVarint(out, (uint32_t)run);
+        i += run;
+    }
+
+    // Fluid level runs
+    i = 0;
+    while (i < CHUNK_VOLUME) {
+        uint8_t level = chunk.fluidLevel[i];
+        int run = 1;
+        while (i + run < CHUNK_VOLUME && chunk.fluidLevel[i + run] == level) ++run;
+        out.push_back(level);
+        PutVarint(out, (uint32_t)run);
+        i += run;
+    }
+
+    for (BlockID id : palette) {
+        paletteIndex[id] = 0; // Leave the table clean for the next chunk
+    }
+}
+
+bool DecodeChunkPalette(const uint8_t* data, size_t size, Chunk& chunk) {
+    size_t pos = 0;
+    uint32_t paletteSize;
+    if (!GetVarint(data, size, pos, paletteSize) || paletteSize == 0 || paletteSize > 65536) {
+        return false;
+    }
+    thread_local std::vector<BlockID> palette;
+    palette.resize(paletteSize);
+    for (uint32_t p = 0; p < paletteSize; ++p) {
+        uint32_t id;
+        if (!GetVarint(data, size, pos, id) || id > 0xFFFF) return false;
+        palette[p] = (BlockID)id;
+    }
+
+    int i = 0;
+    while (i < CHUNK_VOLUME) {
+        uint32_t index, run;
+        if (!GetVarint(data, size, pos, index) || !GetVarint(data, size, pos, run)) return false;
+        if (index >= paletteSize || run == 0 || run > (uint32_t)(CHUNK_VOLUME - i)) return false;
+        std::fill(chunk.blocks + i, chunk.blocks + i + run, palette[index]);
+        i += (int)run;
+    }
+
+    i = 0;
+    while (i < CHUNK_VOLUME) {
+        if (pos >= size) return false;
+        uint8_t level = data[pos++];
+        uint32_t run;
+        if (!GetVarint(data, size, pos, run) || run == 0 || run > (uint32_t)(CHUNK_VOLUME - i)) return false;
+        std::fill(chunk.fluidLevel + i, chunk.fluidLevel + i + run, level);
+        i += (int)run;
+    }
+    return pos == size;
+}
+
+// ============================================================================
+// Stage 2: LZ byte coder
+// ============================================================================
+// A stream of sequences: token byte (high nibble literal count, low nibble match length - 4; 15 means
+// "more length bytes follow", each adding up to 255), the literals, then a uint16 LE back-reference
+// offset and the match. The final sequence has literals only.
+
+static void PutLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back((uint8_t)length);
+}
+
+static void EmitSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount,
+                         size_t offset, size_t matchLength) {
+    const size_t matchCode = (matchLength >= (size_t)LZ_MIN_MATCH) ? matchLength - LZ_MIN_MATCH : 0;
+    const uint8_t token = (uint8_t)((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchCode, 15));
+    out.push_back(token);
+    if (literalCount >= 15) PutLength(out, literalCount - 15);
+    out.insert(out.end(), literals, literals + literalCount);
+    if (matchLength == 0) {
+        return; // Last sequence
+    }
+    out.push_back((uint8_t)offset);
+    out.push_back((uint8_t)(offset >> 8));
+    if (matchCode >= 15) PutLength(out, matchCode - 15);
+}
+
+static uint32_t HashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+void LZCompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    thread_local std::vector<int32_t> table(1 << LZ_HASH_BITS);
+    std::fill(table.begin(), table.end(), -1);
+
+    size_t anchor = 0;
+    size_t pos = 0;
+    size_t misses = 0;
+    while (pos + LZ_MIN_MATCH <= size) {
+        const uint32_t sequence = Load32(data + pos);
+        const uint32_t hash = HashSequence(sequence);
+        const int32_t candidate = table[hash];
+        table[hash] = (int32_t)pos;
+
+        if (candidate < 0 || pos - (size_t)candidate > LZ_MAX_OFFSET || Load32(data + candidate) != sequence) {
+            pos += 1 + (misses++ >> 6); // Skip faster through incompressible data
+            continue;
+        }
+        misses = 0;
+
+        // Extend the match eight bytes at a time
+        size_t length = LZ_MIN_MATCH;
+        while (pos + length + 8 <= size) {
+            uint64_t diff = Load64(data + pos + length) ^ Load64(data + candidate + length);
+            if (diff != 0) {
+                length += (size_t)__builtin_ctzll(diff) >> 3; // Little-endian: lowest set byte is the first mismatch
+                break;
+            }
+            length += 8;
+        }
+        while (pos + length < size && data[pos + length] == data[candidate + length]) ++length; // Tail
+        EmitSequence(out, data + anchor, pos - anchor, pos - (size_t)candidate, length);
+        pos += length;
+        anchor = pos;
+        if (pos >= 2 && pos + LZ_MIN_MATCH <= size) {
+            table[HashSequence(Load32(data + pos - 2))] = (int32_t)(pos - 2);
+        }
+    }
+    EmitSequence(out, data + anchor, size - anchor, 0, 0);
+}
+
+static bool GetLength(const uint8_t* data, size_t size, size_t& pos, size_t& length) {
+    uint8_t byte;
+    do {
+        if (pos >= size) return false;
+        byte = data[pos++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+bool LZDecompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize) {
+    size_t pos = 0;
+    size_t written = 0;
+    while (pos < size) {
+        const uint8_t token = data[pos++];
+
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !GetLength(data, size, pos, literalCount)) return false;
+        if (literalCount > size - pos || literalCount > outSize - written) return false;
+        std::memcpy(out + written, data + pos, literalCount);
+        pos += literalCount;
+        written += literalCount;
+
+        if (pos == size) {
+            break; // Last sequence
+        }
+
+        if (pos + 2 > size) return false;
+        const size_t offset = (size_t)data[pos] | ((size_t)data[pos + 1] << 8);
+        pos += 2;
+        size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !GetLength(data, size, pos, matchLength)) return false;
+        matchLength += LZ_MIN_MATCH;
+        if (offset == 0 || offset > written || matchLength > outSize - written) return false;
+
+        // Byte by byte where the match overlaps the bytes it is copying
+        const uint8_t* from = out + written - offset;
+        uint8_t* to = out + written;
+        if (offset >= matchLength) {
+            std::memcpy(to, from, matchLength);
+        } else {
+            for (size_t i = 0; i < matchLength; ++i) to[i] = from[i];
+        }
+        written += matchLength;
+    }
+    return written == outSize;
+}
+
+// ============================================================================
+// Both stages
+// ============================================================================
+
+void EncodeChunkCompressed(const Chunk& chunk, std::vector<uint8_t>& out) {
+    thread_local std::vector<uint8_t> stage1;
+    EncodeChunkPalette(chunk, stage1);
+
+    out.clear();
+    const uint32_t rawSize = (uint32_t)stage1.size();
+    out.push_back((uint8_t)rawSize);
+    out.push_back((uint8_t)(rawSize >> 8));
+    out.push_back((uint8_t)(rawSize >> 16));
+    out.push_back((uint8_t)(rawSize >> 24));
+    LZCompress(stage1.data(), stage1.size(), out);
+}
+
+bool DecodeChunkCompressed(const uint8_t* data, size_t size, Chunk& chunk) {
+    if (size < 4) {
+        return false;
+    }
+    const uint32_t rawSize = (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+    // Stage 1 of a chunk is at most a few bytes per cell; anything larger is corrupt
+    if (rawSize > (uint32_t)CHUNK_VOLUME * 16) {
+        return false;
+    }
+    thread_local std::vector<uint8_t> stage1;
+    stage1.resize(rawSize);
+    return LZDecompress(data + 4, size - 4, stage1.data(), rawSize) &&
+           DecodeChunkPalette(stage1.data(), rawSize, chunk);
+}
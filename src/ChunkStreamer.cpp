@@ -0,0 +1,274 @@
+// src/ChunkStreamer.cpp
+
+#include "ChunkStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+
+ChunkStreamer::ChunkStreamer(const TerrainGenerator& generator, int viewDistance, int workerCount)
+    : generator(generator),
+      viewDistance(std::max(1, viewDistance)),
+      windowStart(std::chrono::steady_clock::now())
+{
+    for (int i = 0; i < std::max(1, workerCount); ++i) {
+        workers.emplace_back(&ChunkStreamer::WorkerLoop, this);
+    }
+}
+
+ChunkStreamer::~ChunkStreamer() {
+    Stop();
+}
+
+void ChunkStreamer::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+        queue.clear();
+    }
+    queueCondition.notify_all();
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers.clear();
+    finished.clear();
+}
+
+void ChunkStreamer::BuildChunk(Chunk& chunk) const {
+    if (!loader || !loader(chunk)) {
+        generator.GenerateChunk(chunk);
+    }
+}
+
+void ChunkStreamer::WorkerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) {
+                return;
+            }
+            std::pop_heap(queue.begin(), queue.end(), JobOrder);
+            job = queue.back();
+            queue.pop_back();
+            ++building;
+        }
+
+        // Built outside the lock, into a chunk no one else can see yet
+        std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+        chunk->chunkX = World::ChunkKeyX(job.key);
+        chunk->chunkZ = World::ChunkKeyZ(job.key);
+        BuildChunk(*chunk);
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        --building;
+        finished.push_back(std::move(chunk));
+    }
+}
+
+bool ChunkStreamer::JobOrder(const Job& a, const Job& b) {
+    return a.priority > b.priority; // Heap functions keep the largest on top; invert for a min-heap
+}
+
+float ChunkStreamer::Priority(int chunkX, int chunkZ) const {
+    glm::vec2 toChunk = (glm::vec2((float)chunkX, (float)chunkZ) + 0.5f) * (float)CHUNK_SIZE - cameraPosXZ;
+    float distance = std::sqrt(toChunk.x * toChunk.x + toChunk.y * toChunk.y);
+    float facing = (distance > 1e-3f) ? (toChunk.x * cameraDir.x + toChunk.y * cameraDir.y) / distance : 1.0f;
+
+    // Squared distance in chunks, doubled for chunks straight behind the camera
+    float chunks = distance / (float)CHUNK_SIZE;
+    return chunks * chunks * (1.5f - 0.5f * facing);
+}
+
+void ChunkStreamer::Reprioritise(const World& world) {
+    const int radiusSq = viewDistance * viewDistance;
+    auto inRange = [&](int64_t key) {
+        int dx = World::ChunkKeyX(key) - cameraChunk.x;
+        int dz = World::ChunkKeyZ(key) - cameraChunk.y;
+        return dx * dx + dz * dz <= radiusSq;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+
+        // Re-score queued chunks for the new camera, dropping those that left the radius
+        size_t kept = 0;
+        for (size_t i = 0; i < queue.size(); ++i) {
+            Job job = queue[i];
+            if (!inRange(job.key)) {
+                requested.erase(job.key);
+                continue;
+            }
+            job.priority = Priority(World::ChunkKeyX(job.key), World::ChunkKeyZ(job.key));
+            queue[kept++] = job;
+        }
+        queue.resize(kept);
+
+        // Queue every missing chunk inside the radius
+        for (int dx = -viewDistance; dx <= viewDistance; ++dx) {
+            for (int dz = -viewDistance; dz <= viewDistance; ++dz) {
+                if (dx * dx + dz * dz > radiusSq) continue;
+                int chunkX = cameraChunk.x + dx;
+                int chunkZ = cameraChunk.y + dz;
+                int64_t key = World::ChunkKey(chunkX, chunkZ);
+                if (requested.count(key) || world.IsChunkLoaded(chunkX, chunkZ)) continue;
+
+                requested.insert(key);
+                queue.push_back({ key, Priority(chunkX, chunkZ) });
+            }
+        }
+        std::make_heap(queue.begin(), queue.end(), JobOrder);
+    }
+    queueCondition.notify_all();
+}
+
+void ChunkStreamer::Evict(World& world, std::vector<int64_t>& evicted) {
+    const int evictRadius = viewDistance + EVICT_MARGIN;
+    world.GetChunkKeys(keyScratch);
+    for (int64_t key : keyScratch) {
+        int dx = World::ChunkKeyX(key) - cameraChunk.x;
+        int dz = World::ChunkKeyZ(key) - cameraChunk.y;
+        if (dx * dx + dz * dz > evictRadius * evictRadius) {
+            // Compact chunks have no unsaved edits (see World::CompactChunk), so only dense ones are offered
+            const Chunk* chunk = world.GetChunk(World::ChunkKeyX(key), World::ChunkKeyZ(key));
+            if (unloader && chunk) {
+                unloader(*chunk);
+            }
+            world.RemoveChunk(World::ChunkKeyX(key), World::ChunkKeyZ(key));
+            evicted.push_back(key);
+            ++totalEvicted;
+        }
+    }
+}
+
+void ChunkStreamer::Update(World& world, glm::vec3 cameraPos, glm::vec3 cameraForward, std::vector<int64_t>& evicted) {
+    evicted.clear();
+
+    // --- 1. Move a few finished chunks into the world ---
+    std::vector<std::unique_ptr<Chunk>>& ready = readyScratch;
+    ready.clear();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        while (!finished.empty() && ready.size() < (size_t)MAX_CHUNKS_INSERTED_PER_UPDATE) {
+            ready.push_back(std::move(finished.back()));
+            finished.pop_back();
+        }
+    }
+    const int evictRadius = viewDistance + EVICT_MARGIN;
+    for (std::unique_ptr<Chunk>& chunk : ready) {
+        requested.erase(World::ChunkKey(chunk->chunkX, chunk->chunkZ));
+        int dx = chunk->chunkX - cameraChunk.x;
+        int dz = chunk->chunkZ - cameraChunk.y;
+        if (dx * dx + dz * dz > evictRadius * evictRadius) {
+            // The camera moved away while it was being built. It is unloaded like an evicted
+            // chunk, since the loader may have changed it (e.g. replayed journal edits).
+            if (unloader) {
+                unloader(*chunk);
+            }
+            continue;
+        }
+        if (world.IsChunkLoaded(chunk->chunkX, chunk->chunkZ)) {
+            continue; // LoadNow built it meanwhile (and it may have been edited since)
+        }
+        world.InsertChunk(std::move(chunk));
+        ++totalLoaded;
+        ++loadedThisWindow;
+        compactPending = true;
+    }
+    ready.clear(); // Drops any chunk skipped above
+
+    // --- 2. Re-plan when the camera enters another chunk or turns noticeably ---
+    glm::ivec2 newCameraChunk(World::ToChunkCoord((int)std::floor(cameraPos.x)),
+                              World::ToChunkCoord((int)std::floor(cameraPos.z)));
+    glm::vec2 forward(cameraForward.x, cameraForward.z);
+    float forwardLength = std::sqrt(forward.x * forward.x + forward.y * forward.y);
+    forward = (forwardLength > 1e-4f) ? forward / forwardLength : cameraDir;
+
+    const bool moved = (newCameraChunk != cameraChunk);
+    const bool turned = (forward.x * cameraDir.x + forward.y * cameraDir.y) < 0.85f; // ~30 degrees
+    if (moved || turned) {
+        cameraChunk = newCameraChunk;
+        cameraPosXZ = glm::vec2(cameraPos.x, cameraPos.z);
+        cameraDir = forward;
+        Reprioritise(world);
+    }
+    if (moved) {
+        Evict(world, evicted);
+        compactPending = true;
+    }
+
+    // --- 3. Far chunks to brick maps, near ones back to dense ---
+    if (compactPending) {
+        compactPending = !UpdateCompaction(world);
+    }
+
+    // --- 4. Stats ---
+    residentChunks = world.ChunkCount();
+    compactChunks = world.CompactChunkCount();
+    residentBytes = world.ChunkMemoryBytes();
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - windowStart).count();
+    if (elapsed >= 1.0) {
+        loadRate = (double)loadedThisWindow / elapsed;
+        loadedThisWindow = 0;
+        windowStart = now;
+    }
+}
+
+bool ChunkStreamer::UpdateCompaction(World& world) {
+    // Hysteresis: compact past compactDistance, expand within compactDistance - 1
+    const int compactSq = compactDistance * compactDistance;
+    const int expandSq = (compactDistance - 1) * (compactDistance - 1);
+    int conversions = 0;
+    world.GetChunkKeys(keyScratch);
+    for (int64_t key : keyScratch) {
+        const int chunkX = World::ChunkKeyX(key), chunkZ = World::ChunkKeyZ(key);
+        const int dx = chunkX - cameraChunk.x;
+        const int dz = chunkZ - cameraChunk.y;
+        const int distanceSq = dx * dx + dz * dz;
+        const bool compact = world.IsCompact(chunkX, chunkZ);
+        if (compact && (compactDistance == 0 || distanceSq <= expandSq)) {
+            world.ExpandChunk(chunkX, chunkZ);
+        } else if (!compact && compactDistance > 0 && distanceSq > compactSq) {
+            // Chunks with unsaved edits stay dense until an autosave has written them
+            if (!world.CompactChunk(chunkX, chunkZ)) continue;
+        } else {
+            continue;
+        }
+        if (++conversions >= MAX_CHUNKS_COMPACTED_PER_UPDATE) {
+            return false; // More next frame
+        }
+    }
+    return true;
+}
+
+void ChunkStreamer::LoadNow(World& world, int chunkX, int chunkZ) {
+    if (world.IsChunkLoaded(chunkX, chunkZ)) {
+        return;
+    }
+    std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+    chunk->chunkX = chunkX;
+    chunk->chunkZ = chunkZ;
+    BuildChunk(*chunk);
+    world.InsertChunk(std::move(chunk));
+    residentChunks = world.ChunkCount();
+    residentBytes = world.ChunkMemoryBytes();
+    ++totalLoaded;
+}
+
+StreamerStats ChunkStreamer::GetStats() const {
+    StreamerStats stats;
+    stats.residentChunks = residentChunks;
+    stats.compactChunks = compactChunks;
+    stats.residentBytes = residentBytes;
+    stats.loadRate = loadRate;
+    stats.totalLoaded = totalLoaded;
+    stats.totalEvicted = totalEvicted;
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    stats.queuedChunks = queue.size();
+    stats.inFlightChunks = building + finished.size();
+    return stats;
+}
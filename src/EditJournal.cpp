@@ -0,0 +1,511 @@
+// src/EditJournal.cpp
+
+#include "EditJournal.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+// Segment header: magic + format version
+static const uint8_t JOURNAL_MAGIC[4] = { 'T', 'J', 'N', 'L' };
+static const uint32_t JOURNAL_FORMAT_VERSION = 1;
+static const int JOURNAL_HEADER_SIZE = 8;
+
+static void StoreU16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static uint16_t LoadU16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+static void StoreU32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t LoadU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint8_t RecordCheck(const uint8_t* p) {
+    uint8_t check = 0xA5;
+    for (int i = 0; i < JOURNAL_RECORD_SIZE - 1; ++i) {
+        check = (uint8_t)((check << 1 | check >> 7) ^ p[i]);
+    }
+    return check;
+}
+
+static bool WriteAll(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n <= 0) return false;
+        data += n; size -= (size_t)n;
+    }
+    return true;
+}
+
+void EditJournal::EncodeRecord(const JournalRecord& record, uint8_t* out) {
+    StoreU32(out + 0, (uint32_t)record.x);
+    StoreU16(out + 4, record.y);
+    StoreU32(out + 6, (uint32_t)record.z);
+    StoreU16(out + 10, record.oldID);
+    StoreU16(out + 12, record.newID);
+    StoreU32(out + 14, record.tick);
+    out[18] = RecordCheck(out);
+}
+
+bool EditJournal::DecodeRecord(const uint8_t* data, JournalRecord& record) {
+    if (data[18] != RecordCheck(data)) {
+        return false;
+    }
+    record.x = (int32_t)LoadU32(data + 0);
+    record.y = LoadU16(data + 4);
+    record.z = (int32_t)LoadU32(data + 6);
+    record.oldID = LoadU16(data + 10);
+    record.newID = LoadU16(data + 12);
+    record.tick = LoadU32(data + 14);
+    return record.y < CHUNK_HEIGHT;
+}
+
+EditJournal::~EditJournal() {
+    Close();
+}
+
+std::string EditJournal::SegmentPath(uint32_t sequence) const {
+    return directory + "/edits." + std::to_string(sequence) + ".journal";
+}
+
+// ============================================================================
+// Opening and replay
+// ============================================================================
+
+bool EditJournal::ReadSegment(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < (size_t)JOURNAL_HEADER_SIZE || std::memcmp(data.data(), JOURNAL_MAGIC, 4) != 0 ||
+        LoadU32(data.data() + 4) != JOURNAL_FORMAT_VERSION) {
+        std::cerr << "ERROR::JOURNAL: " << path << " is not a journal segment; leaving it in place" << std::endl;
+        return false;
+    }
+
+    size_t pos = JOURNAL_HEADER_SIZE;
+    JournalRecord record;
+    while (pos + JOURNAL_RECORD_SIZE <= data.size() && DecodeRecord(data.data() + pos, record)) {
+        int64_t key = World::ChunkKey(World::ToChunkCoord(record.x), World::ToChunkCoord(record.z));
+        replay[key].records.push_back(record);
+        ++stats.recordsReplayed;
+        pos += JOURNAL_RECORD_SIZE;
+    }
+    if (pos != data.size()) {
+        // A torn write at the end (crash mid-batch): everything before it is intact
+        std::cerr << "WARNING::JOURNAL: Ignoring " << data.size() - pos << " trailing bytes in " << path << std::endl;
+    }
+    return true;
+}
+
+bool EditJournal::OpenSegment(uint32_t sequence) {
+    const std::string path = SegmentPath(sequence);
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (fd < 0) {
+        std::cerr << "ERROR::JOURNAL: Cannot create " << path << std::endl;
+        return false;
+    }
+    uint8_t header[JOURNAL_HEADER_SIZE];
+    std::memcpy(header, JOURNAL_MAGIC, 4);
+    StoreU32(header + 4, JOURNAL_FORMAT_VERSION);
+    if (!WriteAll(fd, header, sizeof(header))) {
+        std::cerr << "ERROR::JOURNAL: Cannot write " << path << std::endl;
+        ::close(fd);
+        fd = -1;
+        std::remove(path.c_str());
+        return false;
+    }
+    activeSequence = sequence;
+    segmentBytes = JOURNAL_HEADER_SIZE;
+    return true;
+}
+
+bool EditJournal::Open(const std::string& journalDirectory, JournalSync sync, ChunkSource chunkSource, ChunkSink chunkSink,
+                       ChunkFlush chunkFlush) {
+    Close();
+    directory = journalDirectory;
+    syncPolicy = sync;
+    source = std::move(chunkSource);
+    sink = std::move(chunkSink);
+    flush = std::move(chunkFlush);
+    stopping = false;
+    stats = JournalStats();
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    // Leftover segments, oldest first
+    std::vector<std::pair<uint32_t, std::string>> segments;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        unsigned int sequence = 0;
+        char tail[16] = {};
+        const std::string name = entry.path().filename().string();
+        if (std::sscanf(name.c_str(), "edits.%u.%15s", &sequence, tail) == 2 && std::strcmp(tail, "journal") == 0) {
+            segments.push_back({ (uint32_t)sequence, entry.path().string() });
+        }
+    }
+    std::sort(segments.begin(), segments.end());
+
+    uint32_t nextSequence = 1;
+    {
+        std::lock_guard<std::mutex> lock(replayMutex);
+        compactionDone = false;
+        compactionFailed = false;
+        for (const auto& segment : segments) {
+            if (ReadSegment(segment.second)) {
+                replaySegments.push_back(segment.second);
+            }
+            nextSequence = std::max(nextSequence, segment.first + 1);
+        }
+        stats.chunksAwaitingReplay = replay.size();
+    }
+    if (stats.recordsReplayed > 0) {
+        std::cout << "Journal: replaying " << stats.recordsReplayed << " edits in " << replay.size()
+                  << " chunks from an unclean shutdown" << std::endl;
+    }
+
+    {
+        std::lock_guard<std::mutex> fileLock(fileMutex);
+        activeSequence = nextSequence - 1; // A failed open is retried at nextSequence, past the old segments
+        if (!OpenSegment(nextSequence)) {
+            return false;
+        }
+    }
+    writer = std::thread(&EditJournal::WriterLoop, this);
+    compactor = std::thread(&EditJournal::CompactLoop, this);
+    return true;
+}
+
+void EditJournal::ApplyRecord(const JournalRecord& record, Chunk& chunk) {
+    // Same effect on the chunk as World::setBlock
+    const int index = Chunk::Index(World::ToLocalCoord(record.x), record.y, World::ToLocalCoord(record.z));
+    chunk.blocks[index] = record.newID;
+    chunk.fluidLevel[index] = 0;
+}
+
+void EditJournal::LoadChunk(Chunk& chunk) {
+    const int64_t key = World::ChunkKey(chunk.chunkX, chunk.chunkZ);
+    std::unique_lock<std::mutex> lock(replayMutex);
+    auto it = replay.find(key);
+    if (it == replay.end() || it->second.loaded) {
+        // Loaded before: the source (saved or pending copy) already carries the edits
+        lock.unlock();
+        source(chunk);
+        return;
+    }
+
+    source(chunk);
+    for (const JournalRecord& record : it->second.records) {
+        ApplyRecord(record, chunk);
+    }
+    it->second.loaded = true;
+    chunk.version = chunk.savedVersion + 1; // The world copy now carries these edits to the next save
+}
+
+void EditJournal::ChunksSaved(const std::vector<int64_t>& keys) {
+    std::lock_guard<std::mutex> lock(replayMutex);
+    if (replay.empty()) {
+        return;
+    }
+    for (int64_t key : keys) {
+        auto it = replay.find(key);
+        if (it != replay.end() && it->second.loaded) {
+            replay.erase(it);
+        }
+    }
+    stats.chunksAwaitingReplay = replay.size();
+    RemoveReplaySegmentsIfDone();
+}
+
+void EditJournal::RemoveReplaySegmentsIfDone() {
+    if (!compactionDone || compactionFailed || !replay.empty()) {
+        return;
+    }
+    for (const std::string& path : replaySegments) {
+        std::remove(path.c_str());
+    }
+    replaySegments.clear();
+}
+
+void EditJournal::CompactLoop() {
+    std::vector<int64_t> keys;
+    {
+        std::lock_guard<std::mutex> lock(replayMutex);
+        for (const auto& pair : replay) keys.push_back(pair.first);
+    }
+
+    bool failed = false;
+    std::vector<int64_t> written;
+    std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+    for (int64_t key : keys) {
+        std::lock_guard<std::mutex> lock(replayMutex);
+        auto it = replay.find(key);
+        if (it == replay.end() || it->second.loaded) {
+            continue; // Streamed in first; the world copy carries these edits to its next save
+        }
+        *chunk = Chunk();
+        chunk->chunkX = World::ChunkKeyX(key);
+        chunk->chunkZ = World::ChunkKeyZ(key);
+        source(*chunk);
+        for (const JournalRecord& record : it->second.records) {
+            ApplyRecord(record, *chunk);
+        }
+        if (!sink(*chunk)) {
+            failed = true;
+            continue;
+        }
+        written.push_back(key);
+    }
+    // The records may only go once the chunks written above are on disk
+    if (!written.empty() && flush && !flush()) {
+        failed = true;
+        written.clear();
+    }
+
+    std::lock_guard<std::mutex> lock(replayMutex);
+    for (int64_t key : written) {
+        replay.erase(key);
+    }
+    stats.chunksAwaitingReplay = replay.size();
+    compactionDone = true;
+    compactionFailed = failed;
+    if (failed) {
+        // Keep the segments: they are replayed again next session
+        std::cerr << "ERROR::JOURNAL: Could not save every replayed chunk; keeping the old journal segments" << std::endl;
+        return;
+    }
+    RemoveReplaySegmentsIfDone();
+}
+
+// ============================================================================
+// Appending
+// ============================================================================
+
+uint64_t EditJournal::Append(int x, int y, int z, BlockID oldID, BlockID newID, uint64_t tick) {
+    JournalRecord record;
+    record.x = x;
+    record.y = (uint16_t)y;
+    record.z = z;
+    record.oldID = oldID;
+    record.newID = newID;
+    record.tick = (uint32_t)tick;
+
+    uint64_t ticket;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const size_t offset = batch.size();
+        batch.resize(offset + JOURNAL_RECORD_SIZE);
+        EncodeRecord(record, batch.data() + offset);
+        ticket = ++appendedTickets;
+        ++stats.recordsAppended;
+    }
+    if (syncPolicy == JournalSync::Edit) {
+        batchReady.notify_one();
+    }
+    return ticket;
+}
+
+bool EditJournal::WaitWritten(uint64_t ticket) {
+    if (syncPolicy != JournalSync::Edit) {
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    const uint64_t failures = stats.writeFailures;
+    batchWritten.wait(lock, [&] { return writtenTickets >= ticket || stopping || stats.writeFailures != failures; });
+    return writtenTickets >= ticket;
+}
+
+bool EditJournal::WriteBatch(const std::vector<uint8_t>& data, bool sync) {
+    if (data.empty()) {
+        return true;
+    }
+    if (fd < 0 && !OpenSegment(activeSequence + 1)) {
+        return FailBatch("No journal segment to write to");
+    }
+    if (!WriteAll(fd, data.data(), data.size())) {
+        return FailBatch("Write to " + SegmentPath(activeSequence) + " failed");
+    }
+    if (sync && ::fdatasync(fd) != 0) {
+        return FailBatch("fdatasync of " + SegmentPath(activeSequence) + " failed");
+    }
+    segmentBytes += data.size();
+    failing = false;
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.bytesWritten += data.size();
+    if (sync) ++stats.fsyncs;
+    return true;
+}
+
+bool EditJournal::FailBatch(const std::string& message) {
+    // Cut the torn batch off, so later batches are not appended behind bytes replay would stop at.
+    // If that fails too, keep the segment as it is (valid up to the tear) and start a new one.
+    if (fd >= 0 && ::ftruncate(fd, (off_t)segmentBytes) != 0) {
+        ::close(fd);
+        fd = -1;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sealed.push_back(activeSequence);
+        }
+        OpenSegment(activeSequence + 1);
+    }
+    if (!failing) {
+        std::cerr << "ERROR::JOURNAL: " << message << "; keeping the edits and retrying" << std::endl;
+    }
+    failing = true;
+    std::lock_guard<std::mutex> lock(mutex);
+    ++stats.writeFailures;
+    return false;
+}
+
+void EditJournal::WriterLoop() {
+    const auto interval = std::chrono::duration<double>(JOURNAL_BATCH_INTERVAL);
+    bool retry = false; // The last batch failed: wait a batch interval before trying it again
+    while (true) {
+        bool stop;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (syncPolicy == JournalSync::Edit && !retry) {
+                batchReady.wait(lock, [this] { return stopping || !batch.empty(); });
+            } else {
+                batchReady.wait_for(lock, interval, [this] { return stopping; });
+            }
+            stop = stopping;
+        }
+
+        std::lock_guard<std::mutex> fileLock(fileMutex);
+        uint64_t ticket;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            writeScratch.swap(batch);
+            batch.clear();
+            ticket = appendedTickets;
+        }
+        const bool written = WriteBatch(writeScratch, syncPolicy != JournalSync::None);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (written) {
+                writtenTickets = std::max(writtenTickets, ticket);
+            } else {
+                batch.insert(batch.begin(), writeScratch.begin(), writeScratch.end()); // Ahead of newer edits
+            }
+        }
+        writeScratch.clear();
+        retry = !written;
+        batchWritten.notify_all();
+
+        if (stop) {
+            if (!written) {
+                std::cerr << "ERROR::JOURNAL: The last edits could not be journaled; only the final save has them" << std::endl;
+            }
+            return;
+        }
+    }
+}
+
+uint32_t EditJournal::Seal() {
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    uint64_t ticket;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        writeScratch.swap(batch);
+        batch.clear();
+        ticket = appendedTickets;
+    }
+    const bool written = WriteBatch(writeScratch, syncPolicy != JournalSync::None);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (written) {
+            writtenTickets = std::max(writtenTickets, ticket);
+        } else {
+            // Retried in the next segment; the autosave sealing this one covers them anyway
+            batch.insert(batch.begin(), writeScratch.begin(), writeScratch.end());
+        }
+    }
+    writeScratch.clear();
+    batchWritten.notify_all();
+
+    if (fd < 0) {
+        // No segment could be created since the last seal (or failure), so there is nothing new to
+        // seal; activeSequence is already in sealed
+        return activeSequence;
+    }
+    const uint32_t sealedSequence = activeSequence;
+    ::close(fd);
+    fd = -1;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sealed.push_back(sealedSequence);
+    }
+    OpenSegment(sealedSequence + 1); // On failure the next write tries again
+    return sealedSequence;
+}
+
+void EditJournal::Discard(uint32_t sequence) {
+    {
+        // While older sessions' edits are not all on disk yet, every later segment is needed to
+        // replay on top of them after a crash
+        std::lock_guard<std::mutex> lock(replayMutex);
+        if (!replaySegments.empty()) {
+            return;
+        }
+    }
+
+    std::vector<uint32_t> discarded;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto end = std::upper_bound(sealed.begin(), sealed.end(), sequence);
+        discarded.assign(sealed.begin(), end);
+        sealed.erase(sealed.begin(), end);
+    }
+    for (uint32_t s : discarded) {
+        std::remove(SegmentPath(s).c_str());
+    }
+}
+
+void EditJournal::Close() {
+    if (compactor.joinable()) {
+        compactor.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    batchReady.notify_all();
+    if (writer.joinable()) {
+        writer.join();
+    }
+
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    if (fd >= 0) {
+        // An active segment holding only its header is dropped
+        const bool empty = ::lseek(fd, 0, SEEK_END) <= JOURNAL_HEADER_SIZE;
+        ::close(fd);
+        fd = -1;
+        if (empty) {
+            std::remove(SegmentPath(activeSequence).c_str());
+        }
+    }
+}
+
+JournalStats EditJournal::GetStats() const {
+    JournalStats result;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        result.recordsAppended = stats.recordsAppended;
+        result.bytesWritten = stats.bytesWritten;
+        result.fsyncs = stats.fsyncs;
+        result.writeFailures = stats.writeFailures;
+    }
+    std::lock_guard<std::mutex> lock(replayMutex);
+    result.recordsReplayed = stats.recordsReplayed;
+    result.chunksAwaitingReplay = stats.chunksAwaitingReplay;
+    return result;
+}
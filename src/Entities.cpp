@@ -0,0 +1,168 @@
+// src/Entities.cpp
+
+#include "Entities.h"
+#include "VoxelCollision.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+uint32_t EntityStore::Spawn(glm::vec3 position, glm::vec3 size, uint32_t entityFlags, glm::vec3 velocity) {
+    posX.push_back(position.x);
+    posY.push_back(position.y);
+    posZ.push_back(position.z);
+    velX.push_back(velocity.x);
+    velY.push_back(velocity.y);
+    velZ.push_back(velocity.z);
+    halfX.push_back(size.x * 0.5f);
+    halfY.push_back(size.y * 0.5f);
+    halfZ.push_back(size.z * 0.5f);
+    gravityScale.push_back(1.0f);
+    flags.push_back(entityFlags);
+    return Count() - 1;
+}
+
+void EntityStore::Despawn(uint32_t index) {
+    // Swap-remove keeps the arrays dense
+    auto removeAt = [index](auto& array) {
+        array[index] = array.back();
+        array.pop_back();
+    };
+    removeAt(posX); removeAt(posY); removeAt(posZ);
+    removeAt(velX); removeAt(velY); removeAt(velZ);
+    removeAt(halfX); removeAt(halfY); removeAt(halfZ);
+    removeAt(gravityScale);
+    removeAt(flags);
+}
+
+void EntityStore::Clear() {
+    posX.clear(); posY.clear(); posZ.clear();
+    velX.clear(); velY.clear(); velZ.clear();
+    halfX.clear(); halfY.clear(); halfZ.clear();
+    gravityScale.clear();
+    flags.clear();
+}
+
+// --- Physics Passes ---
+
+static void GravityPass(EntityStore& e, float dt) {
+    const uint32_t count = e.Count();
+    float* __restrict velY = e.velY.data();
+    const float* __restrict scale = e.gravityScale.data();
+    const float gravityStep = GRAVITY * dt;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        float v = velY[i] + gravityStep * scale[i];
+        velY[i] = (v < TERMINAL_VELOCITY) ? TERMINAL_VELOCITY : v;
+    }
+}
+
+// Collision for the entities listed in order[begin, end) (indices in the low 32 bits)
+static void CollisionRange(EntityStore& e, const World& world, float dt, const uint64_t* order, size_t begin, size_t end) {
+    for (size_t k = begin; k < end; ++k) {
+        const uint32_t i = (uint32_t)order[k];
+
+        AABBSweepResult sweep = SweepAABB(world,
+            glm::vec3(e.posX[i], e.posY[i], e.posZ[i]),
+            glm::vec3(e.halfX[i], e.halfY[i], e.halfZ[i]),
+            glm::vec3(e.velX[i], e.velY[i], e.velZ[i]),
+            dt);
+
+        e.posX[i] = sweep.position.x;
+        e.posY[i] = sweep.position.y;
+        e.posZ[i] = sweep.position.z;
+        e.velX[i] = sweep.velocity.x;
+        e.velY[i] = sweep.velocity.y;
+        e.velZ[i] = sweep.velocity.z;
+
+        if (sweep.grounded()) {
+            e.flags[i] |= ENTITY_GROUNDED;
+        } else {
+            e.flags[i] &= ~(uint32_t)ENTITY_GROUNDED;
+        }
+    }
+}
+
+static void FrictionPass(EntityStore& e) {
+    const uint32_t count = e.Count();
+    float* __restrict velX = e.velX.data();
+    float* __restrict velZ = e.velZ.data();
+    const uint32_t* __restrict flags = e.flags.data();
+    const float stopSpeedSq = GROUND_STOP_SPEED * GROUND_STOP_SPEED;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const bool grounded = (flags[i] & ENTITY_GROUNDED) != 0;
+        float vx = velX[i] * (grounded ? GROUND_FRICTION : 1.0f);
+        float vz = velZ[i] * (grounded ? GROUND_FRICTION : 1.0f);
+
+        // Stop movement if below a threshold
+        const bool stop = grounded && (vx * vx + vz * vz) < stopSpeedSq;
+        velX[i] = stop ? 0.0f : vx;
+        velZ[i] = stop ? 0.0f : vz;
+    }
+}
+
+// Sorts entity indices by the chunk column they are in. Each entry packs
+// (chunkX:16, chunkZ:16, index:32) so a single integer sort groups entities by chunk.
+static void SortByChunk(EntityStore& e) {
+    const uint32_t count = e.Count();
+    e.chunkOrder.resize(count);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint64_t cx = (uint16_t)World::ToChunkCoord((int)std::floor(e.posX[i]));
+        const uint64_t cz = (uint16_t)World::ToChunkCoord((int)std::floor(e.posZ[i]));
+        e.chunkOrder[i] = (cx << 48) | (cz << 32) | i;
+    }
+    std::sort(e.chunkOrder.begin(), e.chunkOrder.end());
+}
+
+void StepEntities(EntityStore& entities, const World& world, float dt, int threadCount, JobSystem* jobs) {
+    const uint32_t count = entities.Count();
+    if (count == 0) {
+        return;
+    }
+
+    GravityPass(entities, dt);
+
+    SortByChunk(entities);
+    const uint64_t* order = entities.chunkOrder.data();
+
+    // Split the sorted list into roughly equal ranges, moving each split point forward to the
+    // next chunk boundary so no chunk is shared between threads.
+    if (threadCount < 1) threadCount = 1;
+    if ((uint32_t)threadCount > count) threadCount = (int)count;
+
+    std::vector<size_t> splits;
+    splits.push_back(0);
+    for (int t = 1; t < threadCount; ++t) {
+        size_t split = std::max(splits.back(), (size_t)count * t / threadCount);
+        while (split > 0 && split < count && (order[split] >> 32) == (order[split - 1] >> 32)) {
+            ++split;
+        }
+        splits.push_back(split);
+    }
+    splits.push_back(count);
+
+    if (jobs != nullptr) {
+        jobs->ParallelFor(0, (uint32_t)threadCount, 1, [&](uint32_t first, uint32_t last) {
+            for (uint32_t t = first; t < last; ++t) {
+                CollisionRange(entities, world, dt, order, splits[t], splits[t + 1]);
+            }
+        });
+        FrictionPass(entities);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threadCount; ++t) {
+        if (splits[t] < splits[t + 1]) {
+            workers.emplace_back(CollisionRange, std::ref(entities), std::cref(world), dt, order, splits[t], splits[t + 1]);
+        }
+    }
+    CollisionRange(entities, world, dt, order, splits[0], splits[1]);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    FrictionPass(entities);
+}
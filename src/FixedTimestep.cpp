@@ -0,0 +1,87 @@
+// src/FixedTimestep.cpp
+
+#include "FixedTimestep.h"
+
+#include <chrono>
+
+FixedTimestep::FixedTimestep(double tickDt)
+    : TickDt(tickDt), TickCount(0), accumulator(0.0) {}
+
+int FixedTimestep::Advance(double frameTime) {
+    if (frameTime < 0.0) frameTime = 0.0;
+    if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+
+    accumulator += frameTime;
+
+    int ticks = 0;
+    while (accumulator >= TickDt) {
+        accumulator -= TickDt;
+        ++ticks;
+    }
+    TickCount += ticks;
+    return ticks;
+}
+
+float FixedTimestep::Alpha() const {
+    return (float)(accumulator / TickDt);
+}
+
+// --- SimStateBuffer ---
+
+void SimStateBuffer::Publish(const SimState& state) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // Overwrite the older slot and make it the current one; the previous current becomes "previous"
+    currentIndex ^= 1;
+    states[currentIndex] = state;
+}
+
+void SimStateBuffer::Read(SimState& previous, SimState& current) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    current = states[currentIndex];
+    previous = states[currentIndex ^ 1];
+}
+
+// --- SimulationThread ---
+
+SimulationThread::~SimulationThread() {
+    Stop();
+}
+
+void SimulationThread::Start(std::function<void(float)> tickFn, double tickDt) {
+    Stop();
+    tick = std::move(tickFn);
+    running = true;
+    worker = std::thread(&SimulationThread::run, this, tickDt);
+}
+
+void SimulationThread::Stop() {
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void SimulationThread::run(double tickDt) {
+    using clock = std::chrono::steady_clock;
+    const auto tickDuration = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(tickDt));
+
+    FixedTimestep timestep(tickDt);
+    auto last = clock::now();
+
+    while (running) {
+        auto now = clock::now();
+        double frameTime = std::chrono::duration<double>(now - last).count();
+        last = now;
+
+        int ticks = timestep.Advance(frameTime);
+        for (int i = 0; i < ticks && running; ++i) {
+            tick((float)tickDt);
+        }
+
+        // Sleep until the next tick is due instead of spinning
+        double remaining = (1.0 - timestep.Alpha()) * tickDt;
+        auto wake = now + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(remaining));
+        if (wake > now + tickDuration) wake = now + tickDuration;
+        std::this_thread::sleep_until(wake);
+    }
+}
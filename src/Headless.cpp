@@ -0,0 +1,195 @@
+// src/Headless.cpp
+
+#include "Headless.h"
+#include "Checksum.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef TERRARIS_EGL
+// No X11 types in the EGL headers: the surfaceless platform has no native windows
+#define EGL_NO_X11
+#define MESA_EGL_NO_X11_HEADERS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+HeadlessContext::~HeadlessContext() {
+    Destroy();
+}
+
+#ifdef TERRARIS_EGL
+
+bool HeadlessContext::Create(int w, int h) {
+    // Mesa's surfaceless platform needs no display server; other drivers get the default display
+    EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (clientExtensions && std::strstr(clientExtensions, "EGL_MESA_platform_surfaceless") && getPlatformDisplay) {
+        eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (eglDisplay == EGL_NO_DISPLAY) {
+        eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    EGLint major = 0, minor = 0;
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor)) {
+        std::cerr << "ERROR::HEADLESS: No EGL display" << std::endl;
+        return false;
+    }
+    display = eglDisplay;
+    const char* displayExtensions = eglQueryString(eglDisplay, EGL_EXTENSIONS);
+    if (!displayExtensions || !std::strstr(displayExtensions, "EGL_KHR_surfaceless_context")) {
+        std::cerr << "ERROR::HEADLESS: EGL " << major << "." << minor << " cannot make a context current without a surface" << std::endl;
+        Destroy();
+        return false;
+    }
+
+    // Any surface type: nothing is ever drawn to an EGL surface
+    const EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, 0,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(eglDisplay, configAttributes, &config, 1, &configCount) ||
+        configCount == 0) {
+        std::cerr << "ERROR::HEADLESS: No EGL config for desktop OpenGL" << std::endl;
+        Destroy();
+        return false;
+    }
+    // 4.5 core: the newest llvmpipe offers (the shaders need 4.3)
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 4,
+        EGL_CONTEXT_MINOR_VERSION, 5,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+    if (eglContext == EGL_NO_CONTEXT) {
+        std::cerr << "ERROR::HEADLESS: Failed to create an OpenGL 4.5 core context (EGL error 0x" << std::hex
+                  << eglGetError() << std::dec << ")" << std::endl;
+        Destroy();
+        return false;
+    }
+    context = eglContext;
+    if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext) ||
+        !gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+        std::cerr << "ERROR::HEADLESS: Failed to load OpenGL through EGL" << std::endl;
+        Destroy();
+        return false;
+    }
+
+    // The render target: colour and depth at the window size
+    width = w;
+    height = h;
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "ERROR::HEADLESS: Framebuffer incomplete" << std::endl;
+        Destroy();
+        return false;
+    }
+    glViewport(0, 0, width, height);
+
+    std::cout << "Headless: " << glGetString(GL_RENDERER) << ", OpenGL " << glGetString(GL_VERSION) << ", "
+              << width << "x" << height << " framebuffer" << std::endl;
+    return true;
+}
+
+void HeadlessContext::Destroy() {
+    if (context != nullptr) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (framebuffer != 0) glDeleteFramebuffers(1, &framebuffer);
+        if (colorBuffer != 0) glDeleteRenderbuffers(1, &colorBuffer);
+        if (depthBuffer != 0) glDeleteRenderbuffers(1, &depthBuffer);
+        framebuffer = colorBuffer = depthBuffer = 0;
+        eglMakeCurrent((EGLDisplay)display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext((EGLDisplay)display, (EGLContext)context);
+        context = nullptr;
+    }
+    if (display != nullptr) {
+        eglTerminate((EGLDisplay)display);
+        display = nullptr;
+    }
+}
+
+#else
+
+bool HeadlessContext::Create(int, int) {
+    std::cerr << "ERROR::HEADLESS: Built without EGL (install the EGL development files and reconfigure)" << std::endl;
+    return false;
+}
+
+void HeadlessContext::Destroy() {
+}
+
+#endif
+
+void HeadlessContext::ReadPixels(std::vector<uint8_t>& pixels) const {
+    pixels.resize((size_t)width * height * 4);
+    glFinish();
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+}
+
+FrameTimeStats SummarizeFrameTimes(std::vector<double> milliseconds) {
+    FrameTimeStats stats;
+    stats.frames = milliseconds.size();
+    if (milliseconds.empty()) {
+        return stats;
+    }
+    std::sort(milliseconds.begin(), milliseconds.end());
+    double sum = 0.0;
+    for (double ms : milliseconds) sum += ms;
+    stats.mean = sum / milliseconds.size();
+    // Nearest rank: the smallest time at least p percent of the frames are no slower than
+    auto percentile = [&](double p) {
+        size_t rank = (size_t)std::ceil(p / 100.0 * milliseconds.size());
+        return milliseconds[std::min(std::max(rank, (size_t)1), milliseconds.size()) - 1];
+    };
+    stats.p50 = percentile(50.0);
+    stats.p95 = percentile(95.0);
+    stats.p99 = percentile(99.0);
+    stats.max = milliseconds.back();
+    return stats;
+}
+
+uint64_t HashPixels(const std::vector<uint8_t>& pixels) {
+    return ChecksumBytes(CHECKSUM_BASIS, pixels.data(), pixels.size());
+}
+
+bool WritePPM(const std::string& path, int width, int height, const std::vector<uint8_t>& pixels) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "ERROR::HEADLESS: Cannot write " << path << std::endl;
+        return false;
+    }
+    file << "P6\n" << width << " " << height << "\n255\n";
+    // Top row first, without alpha
+    std::vector<char> row((size_t)width * 3);
+    for (int y = height - 1; y >= 0; --y) {
+        const uint8_t* source = &pixels[(size_t)y * width * 4];
+        for (int x = 0; x < width; ++x) {
+            row[x * 3 + 0] = (char)source[x * 4 + 0];
+            row[x * 3 + 1] = (char)source[x * 4 + 1];
+            row[x * 3 + 2] = (char)source[x * 4 + 2];
+        }
+        file.write(row.data(), row.size());
+    }
+    return (bool)file;
+}
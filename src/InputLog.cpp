@@ -0,0 +1,250 @@
+// src/InputLog.cpp
+
+#include "InputLog.h"
+#include <cstring>
+#include <iostream>
+
+// Log header: magic + format version + seed
+static const uint8_t INPUT_LOG_MAGIC[4] = { 'T', 'I', 'N', 'P' };
+static const uint32_t INPUT_LOG_FORMAT_VERSION = 1;
+static const size_t INPUT_LOG_HEADER_SIZE = 12;
+static const uint8_t INPUT_LOG_END = 0xFF;         // Type byte of the end record
+static const size_t INPUT_LOG_FLUSH_BYTES = 1 << 16;
+
+// Little-endian whatever the host byte order; floats go through their bit pattern
+static void PutU16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back((uint8_t)v);
+    out.push_back((uint8_t)(v >> 8));
+}
+
+static void PutU32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int shift = 0; shift < 32; shift += 8) out.push_back((uint8_t)(v >> shift));
+}
+
+static void PutU64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int shift = 0; shift < 64; shift += 8) out.push_back((uint8_t)(v >> shift));
+}
+
+static void PutFloat(std::vector<uint8_t>& out, float v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, 4);
+    PutU32(out, bits);
+}
+
+static uint64_t LoadLE(const uint8_t* p, int size) {
+    uint64_t v = 0;
+    for (int i = 0; i < size; ++i) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+static bool GetU16(const std::vector<uint8_t>& data, size_t& pos, uint16_t& v) {
+    if (data.size() - pos < 2) return false;
+    v = (uint16_t)LoadLE(&data[pos], 2);
+    pos += 2;
+    return true;
+}
+
+static bool GetU64(const std::vector<uint8_t>& data, size_t& pos, uint64_t& v) {
+    if (data.size() - pos < 8) return false;
+    v = LoadLE(&data[pos], 8);
+    pos += 8;
+    return true;
+}
+
+static bool GetFloat(const std::vector<uint8_t>& data, size_t& pos, float& v) {
+    if (data.size() - pos < 4) return false;
+    const uint32_t bits = (uint32_t)LoadLE(&data[pos], 4);
+    std::memcpy(&v, &bits, 4);
+    pos += 4;
+    return true;
+}
+
+static bool GetVarint(const std::vector<uint8_t>& data, size_t& pos, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= data.size()) return false;
+        uint8_t byte = data[pos++];
+        v |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// --- InputQueue ---
+
+void InputQueue::Push(const InputEvent& event) {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.push_back(event);
+}
+
+void InputQueue::Drain(std::vector<InputEvent>& events) {
+    events.clear();
+    std::lock_guard<std::mutex> lock(mutex);
+    events.swap(pending);
+}
+
+// --- InputRecorder ---
+
+InputRecorder::~InputRecorder() {
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+}
+
+bool InputRecorder::Open(const std::string& path, uint32_t seed) {
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        std::cerr << "ERROR::INPUT_LOG: Cannot create " << path << std::endl;
+        return false;
+    }
+    buffer.clear();
+    for (uint8_t byte : INPUT_LOG_MAGIC) buffer.push_back(byte);
+    PutU32(buffer, INPUT_LOG_FORMAT_VERSION);
+    PutU32(buffer, seed);
+    lastTick = 0;
+    eventCount = 0;
+    byteCount = 0;
+    failed = false;
+    return true;
+}
+
+void InputRecorder::PutTick(uint64_t tick) {
+    uint64_t delta = tick - lastTick;
+    lastTick = tick;
+    while (delta >= 0x80) {
+        buffer.push_back((uint8_t)(delta | 0x80));
+        delta >>= 7;
+    }
+    buffer.push_back((uint8_t)delta);
+}
+
+void InputRecorder::Write(const InputEvent& event) {
+    if (file == nullptr) {
+        return;
+    }
+    PutTick(event.tick);
+    buffer.push_back((uint8_t)event.type);
+    switch (event.type) {
+    case InputEventType::Keys:
+        PutU16(buffer, event.keys);
+        break;
+    case InputEventType::MouseMove:
+        PutFloat(buffer, event.dx);
+        PutFloat(buffer, event.dy);
+        break;
+    case InputEventType::Click:
+        buffer.push_back(event.button);
+        PutFloat(buffer, event.eye.x);
+        PutFloat(buffer, event.eye.y);
+        PutFloat(buffer, event.eye.z);
+        break;
+    }
+    ++eventCount;
+    if (buffer.size() >= INPUT_LOG_FLUSH_BYTES) {
+        Flush();
+    }
+}
+
+bool InputRecorder::Flush() {
+    if (!buffer.empty() && std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+        failed = true;
+    }
+    byteCount += buffer.size();
+    buffer.clear();
+    return !failed;
+}
+
+bool InputRecorder::Close(uint64_t tick, uint64_t checksum) {
+    if (file == nullptr) {
+        return false;
+    }
+    PutTick(tick);
+    buffer.push_back(INPUT_LOG_END);
+    PutU64(buffer, checksum);
+    Flush();
+    if (std::fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+    if (failed) {
+        std::cerr << "ERROR::INPUT_LOG: Failed to write the input log" << std::endl;
+    }
+    return !failed;
+}
+
+// --- InputReplay ---
+
+bool InputReplay::Open(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        std::cerr << "ERROR::INPUT_LOG: Cannot open " << path << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t chunk[1 << 16];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+    std::fclose(file);
+
+    if (data.size() < INPUT_LOG_HEADER_SIZE || std::memcmp(data.data(), INPUT_LOG_MAGIC, 4) != 0) {
+        std::cerr << "ERROR::INPUT_LOG: " << path << " is not an input log" << std::endl;
+        return false;
+    }
+    const uint32_t version = (uint32_t)LoadLE(&data[4], 4);
+    seed = (uint32_t)LoadLE(&data[8], 4);
+    if (version != INPUT_LOG_FORMAT_VERSION) {
+        std::cerr << "ERROR::INPUT_LOG: " << path << " has format version " << version << ", expected "
+                  << INPUT_LOG_FORMAT_VERSION << std::endl;
+        return false;
+    }
+
+    events.clear();
+    next = 0;
+    size_t pos = INPUT_LOG_HEADER_SIZE;
+    uint64_t tick = 0;
+    while (true) {
+        uint64_t delta = 0;
+        if (!GetVarint(data, pos, delta) || pos >= data.size()) break;
+        tick += delta;
+        const uint8_t type = data[pos++];
+        if (type == INPUT_LOG_END) {
+            endTick = tick;
+            if (GetU64(data, pos, endChecksum)) {
+                return true;
+            }
+            break;
+        }
+        InputEvent event;
+        event.tick = tick;
+        event.type = (InputEventType)type;
+        bool ok = false;
+        switch (event.type) {
+        case InputEventType::Keys:
+            ok = GetU16(data, pos, event.keys);
+            break;
+        case InputEventType::MouseMove:
+            ok = GetFloat(data, pos, event.dx) && GetFloat(data, pos, event.dy);
+            break;
+        case InputEventType::Click:
+            ok = pos < data.size();
+            if (ok) event.button = data[pos++];
+            ok = ok && GetFloat(data, pos, event.eye.x) && GetFloat(data, pos, event.eye.y) &&
+                 GetFloat(data, pos, event.eye.z);
+            break;
+        }
+        if (!ok) break;
+        events.push_back(event);
+    }
+    std::cerr << "ERROR::INPUT_LOG: " << path << " is truncated or damaged (after " << events.size() << " events)" << std::endl;
+    return false;
+}
+
+bool InputReplay::Next(uint64_t tick, InputEvent& event) {
+    if (next == events.size() || events[next].tick > tick) {
+        return false;
+    }
+    event = events[next++];
+    return true;
+}
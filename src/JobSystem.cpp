@@ -0,0 +1,296 @@
+// src/JobSystem.cpp
+
+#include "JobSystem.h"
+#include <iostream>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#define JOB_PAUSE() _mm_pause()
+#else
+#define JOB_PAUSE() std::this_thread::yield()
+#endif
+
+// Empty polls before an idle worker goes to sleep (a few microseconds)
+static const int IDLE_SPINS = 256;
+
+// Which worker of which system the calling thread is
+static thread_local const JobSystem* currentSystem = nullptr;
+static thread_local int currentWorker = -1;
+static thread_local uint32_t stealRandom = 0x9E3779B9u; // Picks the first steal victim
+
+// --- JobDeque ---
+
+bool JobDeque::Push(Job* job) {
+    const int64_t b = bottom.load(std::memory_order_relaxed);
+    const int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= (int64_t)JOB_DEQUE_SIZE) {
+        return false;
+    }
+    buffer[b & (JOB_DEQUE_SIZE - 1)].store(job, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+Job* JobDeque::Pop() {
+    const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_seq_cst);
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed); // Was empty
+        return nullptr;
+    }
+    Job* job = buffer[b & (JOB_DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+    if (t == b) {
+        // The last job: a thief may be taking it too
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            job = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* JobDeque::Steal() {
+    int64_t t = top.load(std::memory_order_seq_cst);
+    const int64_t b = bottom.load(std::memory_order_seq_cst);
+    if (t >= b) {
+        return nullptr;
+    }
+    Job* job = buffer[t & (JOB_DEQUE_SIZE - 1)].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return job;
+}
+
+// --- JobSystem ---
+
+JobSystem::JobSystem(int workerCount)
+    : mainThread(std::this_thread::get_id()) {
+    workerCount = std::max(0, workerCount);
+    for (int i = 0; i <= workerCount; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+        workers.back()->pool.reset(new Job[JOB_POOL_SIZE]);
+    }
+    sharedPool.reset(new Job[JOB_POOL_SIZE]);
+    currentSystem = this;
+    currentWorker = 0;
+    for (int i = 1; i <= workerCount; ++i) {
+        workers[i]->thread = std::thread(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wake.notify_all();
+    for (size_t i = 1; i < workers.size(); ++i) {
+        workers[i]->thread.join();
+    }
+    if (currentSystem == this) {
+        currentSystem = nullptr;
+        currentWorker = -1;
+    }
+}
+
+int JobSystem::DefaultWorkerCount() {
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? (int)hardwareThreads - 1 : 0;
+}
+
+int JobSystem::WorkerIndex() const {
+    if (currentSystem == this) {
+        return currentWorker;
+    }
+    // The main thread may have created another JobSystem since (thread_local holds the last one)
+    return std::this_thread::get_id() == mainThread ? 0 : -1;
+}
+
+Job* JobSystem::Allocate() {
+    const int worker = WorkerIndex();
+    Job* job;
+    if (worker >= 0) {
+        Worker& self = *workers[worker];
+        job = &self.pool[self.nextJob++ & (JOB_POOL_SIZE - 1)];
+    } else {
+        std::lock_guard<std::mutex> lock(sharedMutex);
+        job = &sharedPool[nextSharedJob++ & (JOB_POOL_SIZE - 1)];
+    }
+    // The pool wrapped around onto a job still in flight: help until it is done
+    while (!job->done.load(std::memory_order_acquire)) {
+        if (!RunOne(worker)) {
+            JOB_PAUSE();
+        }
+    }
+    job->parent = nullptr;
+    job->unfinished.store(1, std::memory_order_relaxed);
+    job->blockers.store(1, std::memory_order_relaxed);
+    job->done.store(false, std::memory_order_relaxed);
+    job->continuationCount = 0;
+    job->affinity = JobAffinity::Any;
+    return job;
+}
+
+bool JobSystem::Depend(Job* job, Job* prerequisite) {
+    if (prerequisite->continuationCount == MAX_JOB_CONTINUATIONS) {
+        std::cerr << "ERROR::JOBS: A job has more than " << MAX_JOB_CONTINUATIONS << " dependent jobs" << std::endl;
+        return false;
+    }
+    job->blockers.fetch_add(1, std::memory_order_relaxed);
+    prerequisite->continuations[prerequisite->continuationCount++] = job;
+    return true;
+}
+
+void JobSystem::Run(Job* job, JobAffinity affinity) {
+    job->affinity = affinity;
+    if (job->blockers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        Schedule(job);
+    }
+}
+
+void JobSystem::Schedule(Job* job) {
+    if (job->affinity == JobAffinity::MainThread) {
+        std::lock_guard<std::mutex> lock(mainMutex);
+        mainQueue.push_back(job);
+        mainQueued.fetch_add(1, std::memory_order_release);
+        return;
+    }
+    const int worker = WorkerIndex();
+    if (worker >= 0) {
+        if (!workers[worker]->deque.Push(job)) {
+            Execute(job); // Deque full: run it now rather than lose it
+            return;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(sharedMutex);
+        sharedQueue.push_back(job);
+        sharedQueued.fetch_add(1, std::memory_order_relaxed);
+    }
+    // Wake a sleeping worker (see WorkerLoop for why this cannot miss one)
+    queuedJobs.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wake.notify_one();
+    }
+}
+
+Job* JobSystem::Take(int worker) {
+    Job* job = nullptr;
+    if (worker >= 0) {
+        job = workers[worker]->deque.Pop();
+    }
+    if (job == nullptr && sharedQueued.load(std::memory_order_relaxed) > 0) { // A stale count only delays the job
+        std::lock_guard<std::mutex> lock(sharedMutex);
+        if (!sharedQueue.empty()) {
+            job = sharedQueue.back();
+            sharedQueue.pop_back();
+            sharedQueued.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+    if (job == nullptr && (workers.size() > 1 || worker < 0)) {
+        // Steal, starting from a random victim so thieves spread out
+        stealRandom = stealRandom * 1664525u + 1013904223u;
+        const size_t count = workers.size();
+        const size_t first = (stealRandom >> 16) % count;
+        for (size_t i = 0; i < count && job == nullptr; ++i) {
+            const size_t victim = (first + i) % count;
+            if ((int)victim != worker) {
+                job = workers[victim]->deque.Steal();
+            }
+        }
+    }
+    if (job != nullptr) {
+        queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+bool JobSystem::RunOne(int worker) {
+    if (worker == 0 && mainQueued.load(std::memory_order_acquire) > 0 && RunMainThreadJobs() > 0) {
+        return true;
+    }
+    Job* job = Take(worker);
+    if (job == nullptr) {
+        return false;
+    }
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Execute(Job* job) {
+    job->invoke(*job);
+    Finish(job);
+}
+
+void JobSystem::Finish(Job* job) {
+    if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return; // Children still running; the last one finishes this job
+    }
+    Job* parent = job->parent;
+    for (int i = 0; i < job->continuationCount; ++i) {
+        Job* continuation = job->continuations[i];
+        if (continuation->blockers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Schedule(continuation);
+        }
+    }
+    job->done.store(true, std::memory_order_release); // The slot may be reused from here on
+    if (parent != nullptr) {
+        Finish(parent);
+    }
+}
+
+void JobSystem::Wait(const Job* job) {
+    const int worker = WorkerIndex();
+    while (!job->done.load(std::memory_order_acquire)) {
+        if (!RunOne(worker)) {
+            JOB_PAUSE();
+        }
+    }
+}
+
+int JobSystem::RunMainThreadJobs() {
+    if (mainQueued.load(std::memory_order_acquire) == 0) {
+        return 0;
+    }
+    // In the order they were queued, one at a time (a job may wait, and so run this again);
+    // jobs queued meanwhile run next time
+    size_t count = mainQueued.load(std::memory_order_acquire);
+    int ran = 0;
+    for (; count > 0; --count, ++ran) {
+        Job* job;
+        {
+            std::lock_guard<std::mutex> lock(mainMutex);
+            if (mainQueue.empty()) break;
+            job = mainQueue.front();
+            mainQueue.pop_front();
+            mainQueued.fetch_sub(1, std::memory_order_relaxed);
+        }
+        Execute(job);
+    }
+    return ran;
+}
+
+void JobSystem::WorkerLoop(int worker) {
+    currentSystem = this;
+    currentWorker = worker;
+    int idle = 0;
+    while (!stopping.load(std::memory_order_relaxed)) {
+        if (RunOne(worker)) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < IDLE_SPINS) {
+            JOB_PAUSE();
+            continue;
+        }
+        // Sleep until a job is queued. Schedule() bumps queuedJobs before it reads sleepers, and this
+        // bumps sleepers before it reads queuedJobs: at least one of them sees the other's write.
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        wake.wait(lock, [this] { return stopping.load() || queuedJobs.load(std::memory_order_seq_cst) > 0; });
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+        idle = 0;
+    }
+}
@@ -0,0 +1,205 @@
+// src/MappedWorld.cpp
+
+#include "MappedWorld.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<Chunk>::value, "Baked maps store Chunk records verbatim");
+
+static const char MAPPED_MAGIC[4] = { 'T', 'M', 'A', 'P' };
+static const uint32_t MAPPED_FORMAT_VERSION = 1;
+static const uint32_t MAPPED_BYTE_ORDER = 0x01020304;
+
+// Page 0 of a baked map (native byte order, checked through byteOrder)
+struct MappedHeader {
+    char magic[4];
+    uint32_t formatVersion;
+    uint32_t byteOrder;
+    // Chunk layout the records were written with
+    uint32_t chunkSize;
+    uint32_t chunkHeight;
+    uint32_t chunkBytes;
+    uint32_t blocksOffset;
+    uint32_t fluidOffset;
+    uint32_t recordStride;
+    // Rectangle covered by the index
+    int32_t minChunkX;
+    int32_t minChunkZ;
+    uint32_t width;
+    uint32_t depth;
+    uint32_t chunkCount;
+    uint64_t chunksOffset;
+};
+
+static size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static MappedHeader CurrentLayout() {
+    MappedHeader header = {};
+    std::memcpy(header.magic, MAPPED_MAGIC, 4);
+    header.formatVersion = MAPPED_FORMAT_VERSION;
+    header.byteOrder = MAPPED_BYTE_ORDER;
+    header.chunkSize = CHUNK_SIZE;
+    header.chunkHeight = CHUNK_HEIGHT;
+    header.chunkBytes = (uint32_t)sizeof(Chunk);
+    header.blocksOffset = (uint32_t)offsetof(Chunk, blocks);
+    header.fluidOffset = (uint32_t)offsetof(Chunk, fluidLevel);
+    header.recordStride = (uint32_t)AlignUp(sizeof(Chunk), MAPPED_RECORD_ALIGN);
+    return header;
+}
+
+MappedWorld::~MappedWorld() {
+    Close();
+}
+
+bool MappedWorld::Open(const std::string& path) {
+    Close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "ERROR::MAP: Cannot open " << path << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < MAPPED_PAGE_SIZE) {
+        std::cerr << "ERROR::MAP: " << path << " is too small to be a baked map" << std::endl;
+        ::close(fd);
+        return false;
+    }
+    const size_t size = (size_t)info.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // The mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        std::cerr << "ERROR::MAP: Cannot map " << path << std::endl;
+        return false;
+    }
+
+    MappedHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    const MappedHeader expected = CurrentLayout();
+    const bool layoutMatches = std::memcmp(header.magic, expected.magic, 4) == 0 &&
+        header.formatVersion == expected.formatVersion && header.byteOrder == expected.byteOrder &&
+        header.chunkSize == expected.chunkSize && header.chunkHeight == expected.chunkHeight &&
+        header.chunkBytes == expected.chunkBytes && header.blocksOffset == expected.blocksOffset &&
+        header.fluidOffset == expected.fluidOffset && header.recordStride == expected.recordStride;
+    const size_t indexBytes = (size_t)header.width * header.depth * sizeof(uint32_t);
+    const bool sizesMatch = header.chunksOffset >= MAPPED_PAGE_SIZE + indexBytes &&
+        header.chunksOffset + (uint64_t)header.chunkCount * header.recordStride <= size;
+    if (!layoutMatches || !sizesMatch) {
+        std::cerr << "ERROR::MAP: " << path << " was baked for a different format or chunk layout" << std::endl;
+        munmap(mapping, size);
+        return false;
+    }
+
+    base = (const uint8_t*)mapping;
+    mappedSize = size;
+    index = (const uint32_t*)(base + MAPPED_PAGE_SIZE);
+    chunksOffset = (size_t)header.chunksOffset;
+    recordStride = header.recordStride;
+    chunkCount = header.chunkCount;
+    minChunkX = header.minChunkX;
+    minChunkZ = header.minChunkZ;
+    width = (int)header.width;
+    depth = (int)header.depth;
+
+    // Reject index entries pointing past the records, so GetChunk() never needs to check
+    for (size_t i = 0; i < (size_t)width * depth; ++i) {
+        if (index[i] > chunkCount) {
+            std::cerr << "ERROR::MAP: " << path << " has a corrupt chunk index" << std::endl;
+            Close();
+            return false;
+        }
+    }
+
+    // The index is touched on every lookup; the records are paged in as they are used
+    madvise((void*)base, chunksOffset, MADV_WILLNEED);
+    return true;
+}
+
+void MappedWorld::Close() {
+    if (base) {
+        munmap((void*)base, mappedSize);
+    }
+    base = nullptr;
+    mappedSize = 0;
+    index = nullptr;
+    chunkCount = 0;
+    width = depth = 0;
+}
+
+void MappedWorld::GetChunkKeys(std::vector<int64_t>& out) const {
+    out.clear();
+    out.reserve(chunkCount);
+    for (int dz = 0; dz < depth; ++dz) {
+        for (int dx = 0; dx < width; ++dx) {
+            if (index[(size_t)dz * width + dx]) {
+                out.push_back(World::ChunkKey(minChunkX + dx, minChunkZ + dz));
+            }
+        }
+    }
+}
+
+bool MappedWorld::Bake(const std::string& path, int minChunkX, int minChunkZ, int width, int depth,
+                       const std::function<bool(Chunk& chunk)>& source) {
+    if (width <= 0 || depth <= 0) {
+        return false;
+    }
+    const std::string tempPath = path + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        std::cerr << "ERROR::MAP: Cannot create " << tempPath << std::endl;
+        return false;
+    }
+
+    MappedHeader header = CurrentLayout();
+    header.minChunkX = minChunkX;
+    header.minChunkZ = minChunkZ;
+    header.width = (uint32_t)width;
+    header.depth = (uint32_t)depth;
+    const size_t indexBytes = (size_t)width * depth * sizeof(uint32_t);
+    header.chunksOffset = AlignUp(MAPPED_PAGE_SIZE + indexBytes, MAPPED_PAGE_SIZE);
+
+    // Records first (the index is only known afterwards), then page 0 and the index
+    std::vector<uint32_t> slots((size_t)width * depth, 0);
+    std::vector<uint8_t> record(header.recordStride, 0);
+    std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+    bool ok = std::fseek(file, (long)header.chunksOffset, SEEK_SET) == 0;
+    for (int dz = 0; dz < depth && ok; ++dz) {
+        for (int dx = 0; dx < width && ok; ++dx) {
+            *chunk = Chunk();
+            chunk->chunkX = minChunkX + dx;
+            chunk->chunkZ = minChunkZ + dz;
+            if (!source(*chunk)) continue;
+            chunk->version = chunk->savedVersion = 0;
+            std::memcpy(record.data(), chunk.get(), sizeof(Chunk));
+            ok = std::fwrite(record.data(), 1, record.size(), file) == record.size();
+            slots[(size_t)dz * width + dx] = ++header.chunkCount;
+        }
+    }
+
+    uint8_t page[MAPPED_PAGE_SIZE] = {};
+    std::memcpy(page, &header, sizeof(header));
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0 &&
+         std::fwrite(page, 1, sizeof(page), file) == sizeof(page) &&
+         std::fwrite(slots.data(), 1, indexBytes, file) == indexBytes;
+    ok = (std::fclose(file) == 0) && ok;
+
+    // Replace the old map in one step, so processes that have it mapped keep a consistent file
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "ERROR::MAP: Failed to write " << path << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
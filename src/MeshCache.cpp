@@ -0,0 +1,362 @@
+// src/MeshCache.cpp
+
+#include "MeshCache.h"
+#include "ChunkCodec.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+static const size_t MESH_HEADER_SIZE = 16 + 2 * SECTIONS;
+static const size_t FACE_RECORD_SIZE = 8;
+
+// ============================================================================
+// Hashing
+// ============================================================================
+// 64-bit multiply-rotate mixing over 8-byte words, with a final avalanche (MurmurHash3 fmix64).
+// Only used to detect change, not for security.
+
+static uint64_t Mix(uint64_t h, uint64_t v) {
+    h ^= v * 0x9E3779B97F4A7C15ull;
+    h = (h << 31) | (h >> 33);
+    return h * 0xBF58476D1CE4E5B9ull;
+}
+
+static uint64_t HashBytes(uint64_t h, const void* data, size_t size) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (; size >= 8; p += 8, size -= 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        h = Mix(h, v);
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, p, size);
+    return Mix(h, tail ^ ((uint64_t)size << 56));
+}
+
+static uint64_t Finalize(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+// --- Little-endian helpers ---
+static void StoreU16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static uint16_t LoadU16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+static void StoreU32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint32_t LoadU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void StoreU64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint64_t LoadU64(const uint8_t* p) {
+    return (uint64_t)LoadU32(p) | ((uint64_t)LoadU32(p + 4) << 32);
+}
+
+// ============================================================================
+// Face records
+// ============================================================================
+
+// Recovers the face records from a vertex buffer built with AppendFace(). Returns false for a
+// face outside chunk (chunkX, chunkZ) or that is not a full-detail mesher face.
+static bool AppendFaceRecords(const std::vector<float>& vertices, int chunkX, int chunkZ, std::vector<uint8_t>& records) {
+    const int baseX = chunkX * CHUNK_SIZE;
+    const int baseZ = chunkZ * CHUNK_SIZE;
+    const size_t faceCount = vertices.size() / FACE_FLOATS;
+    size_t at = records.size();
+    records.resize(at + faceCount * FACE_RECORD_SIZE);
+    for (size_t f = 0; f < faceCount; ++f, at += FACE_RECORD_SIZE) {
+        int face, x, y, z, scale;
+        BlockID blockId;
+        unsigned int texIndex;
+        if (!ReadFace(vertices.data() + f * FACE_FLOATS, face, x, y, z, scale, blockId, texIndex) || scale != 1) {
+            return false;
+        }
+        const int lx = x - baseX;
+        const int lz = z - baseZ;
+        if (lx < 0 || lx >= CHUNK_SIZE || y < 0 || y >= CHUNK_HEIGHT || lz < 0 || lz >= CHUNK_SIZE) {
+            return false;
+        }
+
+        uint8_t* record = records.data() + at;
+        StoreU16(record, (uint16_t)Chunk::Index(lx, y, lz));
+        record[2] = (uint8_t)face;
+        record[3] = 0;
+        StoreU16(record + 4, blockId);
+        StoreU16(record + 6, (uint16_t)texIndex);
+    }
+    return true;
+}
+
+// Header + compressed records
+static void CompressFaces(const std::vector<uint8_t>& records, uint32_t opaqueFaces, const uint16_t visibility[SECTIONS],
+                          uint64_t key, std::vector<uint8_t>& out) {
+    out.assign(MESH_HEADER_SIZE, 0);
+    StoreU64(out.data(), key);
+    StoreU32(out.data() + 8, opaqueFaces);
+    StoreU32(out.data() + 12, (uint32_t)(records.size() / FACE_RECORD_SIZE) - opaqueFaces);
+    for (int s = 0; s < SECTIONS; ++s) {
+        StoreU16(out.data() + 16 + 2 * s, visibility[s]);
+    }
+    LZCompress(records.data(), records.size(), out);
+}
+
+bool MeshCache::EncodeMesh(const ChunkMesh& mesh, int chunkX, int chunkZ, uint64_t key, std::vector<uint8_t>& out) {
+    thread_local std::vector<uint8_t> records;
+    records.clear();
+    if (!AppendFaceRecords(mesh.vertices, chunkX, chunkZ, records)) {
+        return false;
+    }
+    const uint32_t opaqueFaces = (uint32_t)(records.size() / FACE_RECORD_SIZE);
+    if (!AppendFaceRecords(mesh.translucentVertices, chunkX, chunkZ, records)) {
+        return false;
+    }
+    CompressFaces(records, opaqueFaces, mesh.sectionVisibility, key, out);
+    return true;
+}
+
+bool MeshCache::DecodeMesh(const uint8_t* data, size_t size, int chunkX, int chunkZ, uint64_t key, ChunkMesh& mesh) {
+    if (size < MESH_HEADER_SIZE || LoadU64(data) != key) {
+        return false;
+    }
+    const uint32_t opaqueFaces = LoadU32(data + 8);
+    const uint32_t translucentFaces = LoadU32(data + 12);
+    // Every cell has at most 6 faces
+    if (opaqueFaces > (uint32_t)CHUNK_VOLUME * 6 || translucentFaces > (uint32_t)CHUNK_VOLUME * 6) {
+        return false;
+    }
+    const size_t faceCount = (size_t)opaqueFaces + translucentFaces;
+    thread_local std::vector<uint8_t> records;
+    records.resize(faceCount * FACE_RECORD_SIZE);
+    if (!LZDecompress(data + MESH_HEADER_SIZE, size - MESH_HEADER_SIZE, records.data(), records.size())) {
+        return false;
+    }
+
+    mesh.vertices.clear();
+    mesh.translucentVertices.clear();
+    mesh.translucentFaceCenters.clear();
+    for (int s = 0; s < SECTIONS; ++s) {
+        mesh.sectionVisibility[s] = LoadU16(data + 16 + 2 * s);
+    }
+    mesh.vertices.reserve((size_t)opaqueFaces * FACE_FLOATS);
+    mesh.translucentVertices.reserve((size_t)translucentFaces * FACE_FLOATS);
+    mesh.translucentFaceCenters.reserve(translucentFaces);
+
+    const int baseX = chunkX * CHUNK_SIZE;
+    const int baseZ = chunkZ * CHUNK_SIZE;
+    int section = 0; // Opaque records are in mesher order, bottom to top
+    mesh.sectionVertexStart[0] = 0;
+    for (size_t i = 0; i < faceCount; ++i) {
+        const uint8_t* record = records.data() + i * FACE_RECORD_SIZE;
+        const int cell = LoadU16(record);
+        const int face = record[2];
+        if (cell >= CHUNK_VOLUME || face >= 6) {
+            return false;
+        }
+        // Chunk::Index is (y * CHUNK_SIZE + x) * CHUNK_SIZE + z
+        const int x = baseX + (cell / CHUNK_SIZE) % CHUNK_SIZE;
+        const int y = cell / (CHUNK_SIZE * CHUNK_SIZE);
+        const int z = baseZ + cell % CHUNK_SIZE;
+        const float blockId = (float)LoadU16(record + 4);
+        const unsigned int texIndex = LoadU16(record + 6);
+        if (i < opaqueFaces) {
+            if (y / SECTION_HEIGHT < section) {
+                return false;
+            }
+            while (section < y / SECTION_HEIGHT) {
+                mesh.sectionVertexStart[++section] = (int)(mesh.vertices.size() / VERTEX_ATTRIBUTES);
+            }
+            AppendFace(mesh.vertices, face, x, y, z, blockId, texIndex);
+        } else {
+            AppendFace(mesh.translucentVertices, face, x, y, z, blockId, texIndex);
+            mesh.translucentFaceCenters.push_back(FaceCenter(face, x, y, z));
+        }
+    }
+    mesh.opaqueVertexCount = (int)(mesh.vertices.size() / VERTEX_ATTRIBUTES);
+    mesh.translucentVertexCount = (int)(mesh.translucentVertices.size() / VERTEX_ATTRIBUTES);
+    while (section < SECTIONS) {
+        mesh.sectionVertexStart[++section] = mesh.opaqueVertexCount;
+    }
+    return true;
+}
+
+// ============================================================================
+// MeshCache
+// ============================================================================
+
+MeshCache::~MeshCache() {
+    Close();
+}
+
+void MeshCache::Open(const std::string& directory, const World& world) {
+    Close();
+
+    // Everything the mesher looks up per block ID, for every ID blocks can hold
+    uint64_t h = Mix(0x6D657368ull, ((uint64_t)MESHER_VERSION << 32) | (uint32_t)VERTEX_ATTRIBUTES);
+    std::vector<uint32_t> table(65536);
+    for (uint32_t id = 0; id < table.size(); ++id) {
+        table[id] = (world.GetTextureIndex((BlockID)id) << 1) | (world.isOpaqueID((BlockID)id) ? 1u : 0u);
+    }
+    tableHash = HashBytes(h, table.data(), table.size() * sizeof(uint32_t));
+
+    store = std::make_unique<RegionStore>(directory, false); // A lost mesh is only a cache miss
+    stopping = false;
+    ioThread = std::thread(&MeshCache::IOLoop, this);
+}
+
+void MeshCache::Close() {
+    if (!store) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    if (ioThread.joinable()) {
+        ioThread.join();
+    }
+    store.reset();
+}
+
+uint64_t MeshCache::MeshKey(const World& world, int chunkX, int chunkZ) const {
+    if (!world.IsChunkLoaded(chunkX - 1, chunkZ) || !world.IsChunkLoaded(chunkX + 1, chunkZ) ||
+        !world.IsChunkLoaded(chunkX, chunkZ - 1) || !world.IsChunkLoaded(chunkX, chunkZ + 1)) {
+        return 0;
+    }
+    // Compact chunks are expanded one at a time into the scratch chunk
+    thread_local std::unique_ptr<Chunk> scratch = std::make_unique<Chunk>();
+    const Chunk* chunk = world.ReadChunk(chunkX, chunkZ, *scratch);
+    if (!chunk) {
+        return 0;
+    }
+    uint64_t h = HashBytes(tableHash, chunk->blocks, sizeof(chunk->blocks));
+
+    // The neighbour cells the mesher reads: the facing border plane of each neighbour
+    static const int NEIGHBOURS[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+    BlockID border[CHUNK_HEIGHT * CHUNK_SIZE];
+    for (const int* offset : NEIGHBOURS) {
+        const Chunk* neighbour = world.ReadChunk(chunkX + offset[0], chunkZ + offset[1], *scratch);
+        const int fixed = (offset[0] + offset[1] < 0) ? CHUNK_SIZE - 1 : 0; // The plane facing this chunk
+        for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+            for (int i = 0; i < CHUNK_SIZE; ++i) {
+                border[y * CHUNK_SIZE + i] = (offset[0] != 0) ? neighbour->blocks[Chunk::Index(fixed, y, i)]
+                                                              : neighbour->blocks[Chunk::Index(i, y, fixed)];
+            }
+        }
+        h = HashBytes(h, border, sizeof(border));
+    }
+
+    h = Finalize(h);
+    return h ? h : 1; // 0 is reserved for "not cacheable"
+}
+
+bool MeshCache::Load(int chunkX, int chunkZ, uint64_t key, ChunkMesh& mesh) {
+    if (!store || key == 0) {
+        return false;
+    }
+    thread_local std::vector<uint8_t> payload;
+    uint8_t codec = 0;
+    const bool hit = store->LoadPayload(chunkX, chunkZ, payload, codec) && codec == REGION_CODEC_MESH_FACES &&
+                     DecodeMesh(payload.data(), payload.size(), chunkX, chunkZ, key, mesh);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (hit) {
+        ++hits;
+    } else {
+        ++misses;
+    }
+    return hit;
+}
+
+void MeshCache::Store(int chunkX, int chunkZ, uint64_t key, const ChunkMesh& mesh) {
+    if (!store || key == 0) {
+        return;
+    }
+    const int64_t chunkKey = World::ChunkKey(chunkX, chunkZ);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending.size() >= MESH_CACHE_MAX_PENDING && pending.find(chunkKey) == pending.end()) {
+            ++dropped;
+            return;
+        }
+    }
+
+    // The records are a few KB; turning the vertices back into them is cheap next to meshing
+    PendingStore entry;
+    entry.chunkX = chunkX;
+    entry.chunkZ = chunkZ;
+    entry.key = key;
+    if (!AppendFaceRecords(mesh.vertices, chunkX, chunkZ, entry.records)) {
+        return;
+    }
+    entry.opaqueFaces = (uint32_t)(entry.records.size() / FACE_RECORD_SIZE);
+    std::copy(mesh.sectionVisibility, mesh.sectionVisibility + SECTIONS, entry.sectionVisibility);
+    if (!AppendFaceRecords(mesh.translucentVertices, chunkX, chunkZ, entry.records)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending[chunkKey] = std::move(entry);
+    }
+    workAvailable.notify_one();
+}
+
+void MeshCache::IOLoop() {
+    std::vector<uint8_t> payload;
+    while (true) {
+        PendingStore next;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workAvailable.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) {
+                return; // Stopping, and everything queued has been written
+            }
+            auto it = pending.begin();
+            next = std::move(it->second);
+            pending.erase(it);
+            writing = true;
+        }
+
+        CompressFaces(next.records, next.opaqueFaces, next.sectionVisibility, next.key, payload);
+        const bool saved = store->SavePayload(next.chunkX, next.chunkZ, payload.data(), payload.size(), REGION_CODEC_MESH_FACES);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (saved) {
+            ++stored;
+        } else {
+            std::cerr << "ERROR::MESH_CACHE: Failed to store the mesh of chunk " << next.chunkX << "," << next.chunkZ << std::endl;
+        }
+        writing = false;
+        if (pending.empty()) {
+            queueDrained.notify_all();
+        }
+    }
+}
+
+void MeshCache::Flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    queueDrained.wait(lock, [this] { return pending.empty() && !writing; });
+}
+
+MeshCacheStats MeshCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    MeshCacheStats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    stats.stored = stored;
+    stats.dropped = dropped;
+    stats.pendingStores = pending.size() + (writing ? 1 : 0);
+    return stats;
+}
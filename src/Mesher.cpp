@@ -0,0 +1,653 @@
+// src/Mesher.cpp
+
+#include "Mesher.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+// 8 floats per vertex: (X, Y, Z), (Nx, Ny, Nz), (U, V)
+// Each face is 6 vertices (2 triangles)
+// The standard unit cube is positioned at (0, 0, 0)
+// This structure is designed to be easily translated later.
+const float FACE_VERTICES[6 * 48] = {
+    // --- TOP FACE (+Y) ---
+    // Normals: 0.0f, 1.0f, 0.0f
+    -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f, // Top-left
+     0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f, // Top-right
+     0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f, // Bottom-right
+
+     0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f, // Bottom-right
+    -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f, // Bottom-left
+    -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f, // Top-left
+
+    // --- BOTTOM FACE (-Y) ---
+    // Normals: 0.0f, -1.0f, 0.0f
+    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+     0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
+     
+    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+    -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
+     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+
+    // --- FRONT FACE (+Z) ---
+    // Normals: 0.0f, 0.0f, 1.0f
+    -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+     0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
+     0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+
+     0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+    -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
+    -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+
+    // --- BACK FACE (-Z) ---
+    // Normals: 0.0f, 0.0f, -1.0f
+    -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+     0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+     0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
+
+    -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+    -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
+     0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+
+    // --- LEFT FACE (-X) ---
+    // Normals: -1.0f, 0.0f, 0.0f
+    // Vertices run: Top-Front, Top-Back, Bottom-Back (Triangle 1)
+    -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f, // (U=1.0, V=1.0) Top-Front (+Z)
+    -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f, // (U=0.0, V=1.0) Top-Back (-Z)
+    -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f, // (U=0.0, V=0.0) Bottom-Back (-Z)
+
+    // Vertices run: Bottom-Back, Bottom-Front, Top-Front (Triangle 2)
+    -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f, // (U=0.0, V=0.0) Bottom-Back (-Z)
+    -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f, // (U=1.0, V=0.0) Bottom-Front (+Z)
+    -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f, // (U=1.0, V=1.0) Top-Front (+Z)
+
+    // --- RIGHT FACE (+X) ---
+    // Normals: 1.0f, 0.0f, 0.0f
+    // Vertices run: Top-Front, Bottom-Back, Top-Back (Triangle 1)
+     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f, // (U=0.0, V=1.0) Top-Front (+Z)
+     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f, // (U=1.0, V=0.0) Bottom-Back (-Z)
+     0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f, // (U=1.0, V=1.0) Top-Back (-Z)
+
+    // Vertices run: Top-Front, Bottom-Front, Bottom-Back (Triangle 2)
+     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f, // (U=0.0, V=1.0) Top-Front (+Z)
+     0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f, // (U=0.0, V=0.0) Bottom-Front (+Z)
+     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f  // (U=1.0, V=0.0) Bottom-Back (-Z)
+};
+
+// Offsets for checking neighbors (Top, Bottom, Front, Back, Left, Right)
+const int FACE_OFFSETS[6][3] = {
+    {0, 1, 0},   // +Y (Top)
+    {0, -1, 0},  // -Y (Bottom)
+    {0, 0, 1},   // +Z (Front)
+    {0, 0, -1},  // -Z (Back)
+    {-1, 0, 0},  // -X (Left)
+    {1, 0, 0}    // +X (Right)
+};
+
+void AppendFace(std::vector<float>& finalMesh, int face, int x, int y, int z, float blockId, unsigned int texIndex, int scale) {
+    // Grow once and write in place (a push_back per float dominated meshing)
+    const size_t start = finalMesh.size();
+    finalMesh.resize(start + FACE_FLOATS);
+    WriteFace(finalMesh.data() + start, face, x, y, z, blockId, texIndex, scale);
+}
+
+float* WriteFace(float* out, int face, int x, int y, int z, float blockId, unsigned int texIndex, int scale) {
+    // FACE_VERTICES currently contains 8 floats per vertex (Pos(3), Normal(3), TexCoord(2))
+    // 6 vertices * 8 floats/vertex = 48 floats per face.
+    const int FACE_FLOATS_OLD = 6 * (VERTEX_ATTRIBUTES - 2); // 48
+    const float* source = FACE_VERTICES + face * FACE_FLOATS_OLD;
+
+    // A scale^3 cell spans blocks x .. x + scale - 1: the unit cube scaled about its centre
+    const float size = (float)scale;
+    const float offset = 0.5f * (scale - 1);
+
+    // Loop for the 6 vertices in this face
+    // The stride for the data in FACE_VERTICES is 8 (VERTEX_ATTRIBUTES - 2)
+    for (int v = 0; v < 6; ++v, source += VERTEX_ATTRIBUTES - 2, out += VERTEX_ATTRIBUTES) {
+        // Position (x, y, z)
+        out[0] = source[0] * size + ((float)x + offset);
+        out[1] = source[1] * size + ((float)y + offset);
+        out[2] = source[2] * size + ((float)z + offset);
+
+        // Normal and Texture Coords (the texture array repeats, so one texture per block)
+        out[3] = source[3];
+        out[4] = source[4];
+        out[5] = source[5];
+        out[6] = source[6] * size;
+        out[7] = source[7] * size;
+
+        // Block ID (9th float) and texture index (10th float)
+        out[VERTEX_ATTRIBUTES - 2] = blockId;
+        out[VERTEX_ATTRIBUTES - 1] = (float)texIndex;
+    }
+    return out;
+}
+
+// Opacity of one column of cells: bit y is set if the block at height y is opaque
+typedef uint64_t ColumnMask;
+static_assert(CHUNK_HEIGHT <= 64, "A chunk column must fit one ColumnMask");
+
+// Columns of a chunk plus the border columns of its neighbours, indexed [x + 1][z + 1]
+// (the four corner columns are never read)
+const int MASK_SIZE = CHUNK_SIZE + 2;
+
+static ColumnMask BlockColumnMask(const World& world, const BlockID* blocks, int column) {
+    ColumnMask mask = 0;
+    for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+        mask |= (ColumnMask)world.isOpaqueID(blocks[y * CHUNK_SIZE * CHUNK_SIZE + column]) << y;
+    }
+    return mask;
+}
+
+static int CountBits(ColumnMask mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(mask);
+#else
+    int count = 0;
+    for (; mask; mask &= mask - 1) ++count;
+    return count;
+#endif
+}
+
+// Border column (x, z) in world coordinates. Dense neighbours are read in place; compact or
+// unloaded ones through getBlock (unloaded terrain reads as air).
+static ColumnMask BorderColumnMask(const World& world, int x, int z) {
+    const Chunk* neighbour = world.GetChunk(World::ToChunkCoord(x), World::ToChunkCoord(z));
+    if (neighbour) {
+        return BlockColumnMask(world, neighbour->blocks, World::ToLocalCoord(x) * CHUNK_SIZE + World::ToLocalCoord(z));
+    }
+    ColumnMask mask = 0;
+    for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+        mask |= (ColumnMask)world.isOpaque(x, y, z) << y;
+    }
+    return mask;
+}
+
+// Function Generates the mesh for one chunk column based on visible faces.
+// Opacity is gathered once into 64-bit column masks; the visible faces of a whole column then come
+// from a shift and an AND per face instead of six getBlock() lookups per block.
+void GenerateChunkMesh(const World& world, int chunkX, int chunkZ, ChunkMesh& mesh) {
+    mesh.vertices.clear();
+    mesh.translucentVertices.clear();
+    mesh.translucentFaceCenters.clear();
+    mesh.opaqueVertexCount = 0;
+    mesh.translucentVertexCount = 0;
+    std::fill(mesh.sectionVertexStart, mesh.sectionVertexStart + SECTIONS + 1, 0);
+    std::fill(mesh.sectionVisibility, mesh.sectionVisibility + SECTIONS, (uint16_t)0);
+
+    // Compact (far) chunks are expanded into a scratch chunk; neighbours are read through the world
+    thread_local std::unique_ptr<Chunk> scratch = std::make_unique<Chunk>();
+    const Chunk* chunk = world.ReadChunk(chunkX, chunkZ, *scratch);
+    if (!chunk) {
+        return;
+    }
+
+    const int baseX = chunkX * CHUNK_SIZE;
+    const int baseZ = chunkZ * CHUNK_SIZE;
+    ComputeSectionVisibility(world, *chunk, mesh.sectionVisibility);
+
+    // 1. OPACITY MASKS: the chunk's own columns, then one column into each neighbour
+    ColumnMask opaque[MASK_SIZE][MASK_SIZE];
+    ColumnMask solid[CHUNK_SIZE][CHUNK_SIZE]; // Any block (ID != 0)
+    for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+        for (int lz = 0; lz < CHUNK_SIZE; ++lz) {
+            const BlockID* column = chunk->blocks + lx * CHUNK_SIZE + lz;
+            ColumnMask opaqueColumn = 0, solidColumn = 0;
+            for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+                const BlockID id = column[y * CHUNK_SIZE * CHUNK_SIZE];
+                opaqueColumn |= (ColumnMask)world.isOpaqueID(id) << y;
+                solidColumn |= (ColumnMask)(id != 0) << y;
+            }
+            opaque[lx + 1][lz + 1] = opaqueColumn;
+            solid[lx][lz] = solidColumn;
+        }
+    }
+    for (int i = 0; i < CHUNK_SIZE; ++i) {
+        opaque[0][i + 1] = BorderColumnMask(world, baseX - 1, baseZ + i);
+        opaque[MASK_SIZE - 1][i + 1] = BorderColumnMask(world, baseX + CHUNK_SIZE, baseZ + i);
+        opaque[i + 1][0] = BorderColumnMask(world, baseX + i, baseZ - 1);
+        opaque[i + 1][MASK_SIZE - 1] = BorderColumnMask(world, baseX + i, baseZ + CHUNK_SIZE);
+    }
+
+    // 2. FACE MASKS: bit y of faces[face] is set where the neighbour across that face is not opaque
+    // (above and below the world reads as air). Opaque blocks draw exactly those faces.
+    ColumnMask faces[CHUNK_SIZE][CHUNK_SIZE][6];
+    ColumnMask pending[CHUNK_SIZE][CHUNK_SIZE]; // Blocks with at least one face to emit
+    ColumnMask pendingLayers = 0;
+    size_t opaqueFaces = 0, translucentFaces = 0; // The latter before same-material culling
+    for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+        for (int lz = 0; lz < CHUNK_SIZE; ++lz) {
+            const ColumnMask column = opaque[lx + 1][lz + 1];
+            ColumnMask open[6];
+            open[0] = ~(column >> 1);
+            open[1] = ~(column << 1);
+            for (int face = 2; face < 6; ++face) {
+                open[face] = ~opaque[lx + 1 + FACE_OFFSETS[face][0]][lz + 1 + FACE_OFFSETS[face][2]];
+            }
+            ColumnMask any = 0;
+            for (int face = 0; face < 6; ++face) {
+                faces[lx][lz][face] = solid[lx][lz] & open[face];
+                any |= faces[lx][lz][face];
+                opaqueFaces += CountBits(faces[lx][lz][face] & column);
+                translucentFaces += CountBits(faces[lx][lz][face] & ~column);
+            }
+            pending[lx][lz] = any;
+            pendingLayers |= any;
+        }
+    }
+
+    // 3. EMIT bottom to top (sections stay contiguous) in the same order as a per-block scan.
+    // The buffers are sized from the counts once (no growth, and no allocation once they have the
+    // capacity) and the faces written in place; the translucent ones are trimmed afterwards.
+    mesh.vertices.resize(opaqueFaces * FACE_FLOATS);
+    mesh.translucentVertices.resize(translucentFaces * FACE_FLOATS);
+    mesh.translucentFaceCenters.resize(translucentFaces);
+    float* const opaqueBegin = mesh.vertices.data();
+    float* opaqueOut = opaqueBegin;
+    float* translucentOut = mesh.translucentVertices.data();
+    glm::vec3* centerOut = mesh.translucentFaceCenters.data();
+    for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+        if (y % SECTION_HEIGHT == 0) {
+            mesh.sectionVertexStart[y / SECTION_HEIGHT] = (int)((opaqueOut - opaqueBegin) / VERTEX_ATTRIBUTES);
+        }
+        const ColumnMask bit = (ColumnMask)1 << y;
+        if (!(pendingLayers & bit)) {
+            continue; // Buried or empty layer
+        }
+        for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+            for (int lz = 0; lz < CHUNK_SIZE; ++lz) {
+                if (!(pending[lx][lz] & bit)) {
+                    continue;
+                }
+
+                const BlockID id = chunk->blocks[Chunk::Index(lx, y, lz)];
+                const int x = baseX + lx;
+                const int z = baseZ + lz;
+                const float blockId = (float)id;
+                const unsigned int texIndex = world.GetTextureIndex(id);
+                const bool isOpaque = (opaque[lx + 1][lz + 1] & bit) != 0;
+
+                for (int face = 0; face < 6; ++face) {
+                    if (!(faces[lx][lz][face] & bit)) {
+                        continue;
+                    }
+                    if (isOpaque) {
+                        opaqueOut = WriteFace(opaqueOut, face, x, y, z, blockId, texIndex);
+                        continue;
+                    }
+                    // Translucent faces are only needed where the material changes
+                    const int nlx = lx + FACE_OFFSETS[face][0];
+                    const int ny = y + FACE_OFFSETS[face][1];
+                    const int nlz = lz + FACE_OFFSETS[face][2];
+                    BlockID neighbourId;
+                    if (nlx >= 0 && nlx < CHUNK_SIZE && nlz >= 0 && nlz < CHUNK_SIZE) {
+                        neighbourId = (ny >= 0 && ny < CHUNK_HEIGHT) ? chunk->blocks[Chunk::Index(nlx, ny, nlz)] : 0;
+                    } else {
+                        neighbourId = world.getBlock(baseX + nlx, ny, baseZ + nlz);
+                    }
+                    if (neighbourId != id) {
+                        translucentOut = WriteFace(translucentOut, face, x, y, z, blockId, texIndex);
+                        *centerOut++ = FaceCenter(face, x, y, z);
+                    }
+                }
+            }
+        }
+    }
+    mesh.translucentFaceCenters.resize(centerOut - mesh.translucentFaceCenters.data());
+    mesh.translucentVertices.resize(mesh.translucentFaceCenters.size() * FACE_FLOATS);
+
+    mesh.opaqueVertexCount = (int)(mesh.vertices.size() / VERTEX_ATTRIBUTES);
+    mesh.translucentVertexCount = (int)(mesh.translucentVertices.size() / VERTEX_ATTRIBUTES);
+    mesh.sectionVertexStart[SECTIONS] = mesh.opaqueVertexCount;
+}
+
+int ChunkLod(int chunkX, int chunkZ, glm::ivec2 cameraChunk, int lodDistance) {
+    if (lodDistance <= 0) {
+        return 0;
+    }
+    const int dx = chunkX - cameraChunk.x;
+    const int dz = chunkZ - cameraChunk.y;
+    const int distanceSq = dx * dx + dz * dz;
+    int lod = 0;
+    while (lod < MAX_LOD && distanceSq >= (lodDistance << lod) * (lodDistance << lod)) {
+        ++lod;
+    }
+    return lod;
+}
+
+// Blocks in one layer of the largest LOD cell
+static const int MAX_LOD_LAYER = (1 << MAX_LOD) * (1 << MAX_LOD);
+
+BlockID DownsampleCell(const Chunk& chunk, int lod, int cellX, int cellY, int cellZ) {
+    const int scale = 1 << lod;
+    const int x0 = cellX * scale, y0 = cellY * scale, z0 = cellZ * scale;
+    if (lod == 0) {
+        return chunk.blocks[Chunk::Index(x0, y0, z0)];
+    }
+
+    // Top layer down: the first non-empty layer picks the block, the count decides if there is one
+    const int half = (scale * scale * scale) / 2;
+    int solid = 0;
+    BlockID top = 0;
+    for (int y = y0 + scale - 1; y >= y0; --y) {
+        // Most common block of the layer (at most 64 blocks: a linear tally is fine)
+        BlockID ids[MAX_LOD_LAYER];
+        int counts[MAX_LOD_LAYER];
+        int distinct = 0, layerSolid = 0;
+        for (int x = x0; x < x0 + scale; ++x) {
+            const BlockID* row = chunk.blocks + Chunk::Index(x, y, z0);
+            for (int z = 0; z < scale; ++z) {
+                const BlockID id = row[z];
+                if (id == 0) continue;
+                ++layerSolid;
+                if (top != 0) continue; // Layer already chosen; only counting
+                int i = 0;
+                while (i < distinct && ids[i] != id) ++i;
+                if (i == distinct) {
+                    ids[distinct] = id;
+                    counts[distinct++] = 0;
+                }
+                ++counts[i];
+            }
+        }
+        if (top == 0 && distinct > 0) {
+            int best = 0;
+            for (int i = 1; i < distinct; ++i) {
+                if (counts[i] > counts[best]) best = i;
+            }
+            top = ids[best];
+        }
+        solid += layerSolid;
+    }
+    return (solid >= half) ? top : 0;
+}
+
+void GenerateLodChunkMesh(const World& world, int chunkX, int chunkZ, int lod, const int neighbourLods[4], ChunkMesh& mesh) {
+    if (lod == 0 && neighbourLods[0] == 0 && neighbourLods[1] == 0 && neighbourLods[2] == 0 && neighbourLods[3] == 0) {
+        GenerateChunkMesh(world, chunkX, chunkZ, mesh);
+        return;
+    }
+    mesh.vertices.clear();
+    mesh.translucentVertices.clear();
+    mesh.translucentFaceCenters.clear();
+    mesh.opaqueVertexCount = 0;
+    mesh.translucentVertexCount = 0;
+    std::fill(mesh.sectionVertexStart, mesh.sectionVertexStart + SECTIONS + 1, 0);
+    std::fill(mesh.sectionVisibility, mesh.sectionVisibility + SECTIONS, (uint16_t)0);
+
+    thread_local std::unique_ptr<Chunk> scratch = std::make_unique<Chunk>();
+    thread_local std::unique_ptr<Chunk> neighbourScratch = std::make_unique<Chunk>();
+    const Chunk* chunk = world.ReadChunk(chunkX, chunkZ, *scratch);
+    if (!chunk) {
+        return;
+    }
+
+    const int scale = 1 << lod;
+    const int cellsXZ = CHUNK_SIZE >> lod;
+    const int cellsY = CHUNK_HEIGHT >> lod;
+    auto cellIndex = [cellsXZ](int x, int y, int z) { return (y * cellsXZ + x) * cellsXZ + z; };
+    thread_local std::vector<BlockID> cells;
+    cells.resize((size_t)cellsXZ * cellsY * cellsXZ);
+    for (int y = 0; y < cellsY; ++y) {
+        for (int x = 0; x < cellsXZ; ++x) {
+            for (int z = 0; z < cellsXZ; ++z) {
+                cells[cellIndex(x, y, z)] = DownsampleCell(*chunk, lod, x, y, z);
+            }
+        }
+    }
+
+    // The neighbours' cell planes touching this chunk, each at the neighbour's LOD, indexed
+    // [y * cells across + position along the border]. An unloaded neighbour reads as air.
+    thread_local std::vector<BlockID> borders[4];
+    int borderLods[4];
+    for (int n = 0; n < 4; ++n) {
+        const int face = 2 + n;
+        const int lodN = std::min(std::max(neighbourLods[n], 0), MAX_LOD);
+        const int acrossN = CHUNK_SIZE >> lodN;
+        borderLods[n] = lodN;
+        borders[n].assign((size_t)(CHUNK_HEIGHT >> lodN) * acrossN, 0);
+        const Chunk* neighbour = world.ReadChunk(chunkX + FACE_OFFSETS[face][0], chunkZ + FACE_OFFSETS[face][2], *neighbourScratch);
+        if (!neighbour) continue;
+        // The plane on the neighbour's side facing us: its first cells for +Z / +X, last for -Z / -X
+        const int plane = (FACE_OFFSETS[face][0] + FACE_OFFSETS[face][2] > 0) ? 0 : acrossN - 1;
+        const bool alongX = (FACE_OFFSETS[face][0] == 0);
+        for (int y = 0; y < (CHUNK_HEIGHT >> lodN); ++y) {
+            for (int i = 0; i < acrossN; ++i) {
+                borders[n][y * acrossN + i] = alongX ? DownsampleCell(*neighbour, lodN, i, y, plane)
+                                                     : DownsampleCell(*neighbour, lodN, plane, y, i);
+            }
+        }
+    }
+
+    const int baseX = chunkX * CHUNK_SIZE;
+    const int baseZ = chunkZ * CHUNK_SIZE;
+    // Visibility comes from the full resolution blocks: it decides what is drawn, not how
+    ComputeSectionVisibility(world, *chunk, mesh.sectionVisibility);
+    for (int cy = 0; cy < cellsY; ++cy) {
+        if ((cy * scale) % SECTION_HEIGHT == 0) {
+            mesh.sectionVertexStart[cy * scale / SECTION_HEIGHT] = (int)(mesh.vertices.size() / VERTEX_ATTRIBUTES);
+        }
+        for (int cx = 0; cx < cellsXZ; ++cx) {
+            for (int cz = 0; cz < cellsXZ; ++cz) {
+                const BlockID id = cells[cellIndex(cx, cy, cz)];
+                if (id == 0) continue;
+
+                const int x = baseX + cx * scale;
+                const int y = cy * scale;
+                const int z = baseZ + cz * scale;
+                const float blockId = (float)id;
+                const bool opaque = world.isOpaqueID(id);
+                const unsigned int texIndex = world.GetTextureIndex(id);
+                // Same culling rule as GenerateChunkMesh: hidden behind opaque blocks, and
+                // translucent faces only where the material changes
+                auto hides = [&](BlockID neighborId) { return world.isOpaqueID(neighborId) || (!opaque && neighborId == id); };
+
+                for (int face = 0; face < 6; ++face) {
+                    const int nx = cx + FACE_OFFSETS[face][0];
+                    const int ny = cy + FACE_OFFSETS[face][1];
+                    const int nz = cz + FACE_OFFSETS[face][2];
+                    bool hidden;
+                    if (ny < 0 || ny >= cellsY) {
+                        hidden = false; // Above / below the world is air
+                    } else if (nx >= 0 && nx < cellsXZ && nz >= 0 && nz < cellsXZ) {
+                        hidden = hides(cells[cellIndex(nx, ny, nz)]);
+                    } else {
+                        // Across the chunk border: hidden only if the neighbour's cells cover the
+                        // whole face. Block ranges [along, along + scale) x [y, y + scale).
+                        const int n = face - 2;
+                        const int lodN = borderLods[n];
+                        const int acrossN = CHUNK_SIZE >> lodN;
+                        const int along = (FACE_OFFSETS[face][0] == 0) ? cx * scale : cz * scale;
+                        const int first = along >> lodN, last = (along + scale - 1) >> lodN;
+                        const int firstY = y >> lodN, lastY = (y + scale - 1) >> lodN;
+                        hidden = true;
+                        for (int by = firstY; by <= lastY && hidden; ++by) {
+                            for (int i = first; i <= last && hidden; ++i) {
+                                hidden = hides(borders[n][by * acrossN + i]);
+                            }
+                        }
+                    }
+                    if (hidden) continue;
+
+                    if (opaque) {
+                        AppendFace(mesh.vertices, face, x, y, z, blockId, texIndex, scale);
+                    } else {
+                        AppendFace(mesh.translucentVertices, face, x, y, z, blockId, texIndex, scale);
+                        mesh.translucentFaceCenters.push_back(FaceCenter(face, x, y, z, scale));
+                    }
+                }
+            }
+        }
+    }
+
+    mesh.opaqueVertexCount = (int)(mesh.vertices.size() / VERTEX_ATTRIBUTES);
+    mesh.translucentVertexCount = (int)(mesh.translucentVertices.size() / VERTEX_ATTRIBUTES);
+    mesh.sectionVertexStart[SECTIONS] = mesh.opaqueVertexCount;
+}
+
+void ComputeSectionVisibility(const World& world, const Chunk& chunk, uint16_t visibility[SECTIONS]) {
+    const int SECTION_VOLUME = CHUNK_SIZE * SECTION_HEIGHT * CHUNK_SIZE;
+    // Section cells use the Chunk::Index layout, so a section is one contiguous run of the chunk
+    thread_local std::vector<uint8_t> open;    // Non-opaque and not yet flooded
+    thread_local std::vector<uint16_t> stack;
+    open.resize(SECTION_VOLUME);
+    stack.reserve(SECTION_VOLUME);
+
+    for (int section = 0; section < SECTIONS; ++section) {
+        const BlockID* blocks = chunk.blocks + section * SECTION_VOLUME;
+        int openCells = 0;
+        for (int i = 0; i < SECTION_VOLUME; ++i) {
+            open[i] = world.isOpaqueID(blocks[i]) ? 0 : 1;
+            openCells += open[i];
+        }
+        if (openCells == SECTION_VOLUME) {
+            visibility[section] = (1u << 15) - 1; // All air: every face sees every other
+            continue;
+        }
+
+        uint16_t connected = 0;
+        for (int seed = 0; seed < SECTION_VOLUME && openCells > 0; ++seed) {
+            if (!open[seed]) continue;
+            // Flood one region, noting the section faces it touches (FACE_OFFSETS order)
+            int faces = 0;
+            open[seed] = 0;
+            --openCells;
+            stack.clear();
+            stack.push_back((uint16_t)seed);
+            while (!stack.empty()) {
+                const int cell = stack.back();
+                stack.pop_back();
+                const int y = cell / (CHUNK_SIZE * CHUNK_SIZE);
+                const int x = (cell / CHUNK_SIZE) % CHUNK_SIZE;
+                const int z = cell % CHUNK_SIZE;
+                if (y == SECTION_HEIGHT - 1) faces |= 1 << 0;
+                if (y == 0)                  faces |= 1 << 1;
+                if (z == CHUNK_SIZE - 1)     faces |= 1 << 2;
+                if (z == 0)                  faces |= 1 << 3;
+                if (x == 0)                  faces |= 1 << 4;
+                if (x == CHUNK_SIZE - 1)     faces |= 1 << 5;
+
+                const int neighbours[6] = {
+                    (y < SECTION_HEIGHT - 1) ? cell + CHUNK_SIZE * CHUNK_SIZE : -1, (y > 0) ? cell - CHUNK_SIZE * CHUNK_SIZE : -1,
+                    (z < CHUNK_SIZE - 1) ? cell + 1 : -1,                         (z > 0) ? cell - 1 : -1,
+                    (x > 0) ? cell - CHUNK_SIZE : -1,                              (x < CHUNK_SIZE - 1) ? cell + CHUNK_SIZE : -1
+                };
+                for (int neighbour : neighbours) {
+                    if (neighbour >= 0 && open[neighbour]) {
+                        open[neighbour] = 0;
+                        --openCells;
+                        stack.push_back((uint16_t)neighbour);
+                    }
+                }
+            }
+            for (int a = 0; a < 6; ++a) {
+                if (!(faces & (1 << a))) continue;
+                for (int b = a + 1; b < 6; ++b) {
+                    if (faces & (1 << b)) connected |= (uint16_t)(1u << FacePairBit(a, b));
+                }
+            }
+        }
+        visibility[section] = connected;
+    }
+}
+
+bool ReadFace(const float* faceVertices, int& face, int& x, int& y, int& z, int& scale, BlockID& blockId, unsigned int& texIndex) {
+    const float* v = faceVertices;
+    face = 0;
+    while (face < 6 && !(v[3] == FACE_OFFSETS[face][0] && v[4] == FACE_OFFSETS[face][1] && v[5] == FACE_OFFSETS[face][2])) {
+        ++face;
+    }
+    if (face == 6) {
+        return false;
+    }
+    // Texture coordinates run from 0 to the scale (see WriteFace)
+    float maxU = 0.0f;
+    for (int i = 0; i < 6; ++i) {
+        maxU = std::max(maxU, v[i * VERTEX_ATTRIBUTES + 6]);
+    }
+    scale = (int)maxU;
+    if ((float)scale != maxU || scale < 1 || (scale & (scale - 1)) != 0) {
+        return false;
+    }
+    // The first vertex is the face's corner scaled about the cell centre, exact in float
+    const float* corner = FACE_VERTICES + face * 6 * (VERTEX_ATTRIBUTES - 2);
+    const float offset = 0.5f * (scale - 1);
+    x = (int)std::floor(v[0] - corner[0] * scale - offset + 0.5f);
+    y = (int)std::floor(v[1] - corner[1] * scale - offset + 0.5f);
+    z = (int)std::floor(v[2] - corner[2] * scale - offset + 0.5f);
+    blockId = (BlockID)v[VERTEX_ATTRIBUTES - 2];
+    texIndex = (unsigned int)v[VERTEX_ATTRIBUTES - 1];
+    return true;
+}
+
+bool PackFaceRecords(const std::vector<float>& vertices, int chunkX, int chunkZ, std::vector<uint32_t>& records) {
+    const int baseX = chunkX * CHUNK_SIZE;
+    const int baseZ = chunkZ * CHUNK_SIZE;
+    const size_t faceCount = vertices.size() / FACE_FLOATS;
+    records.resize(FACE_RECORD_HEADER_WORDS + faceCount * FACE_RECORD_WORDS);
+    records[0] = (uint32_t)baseX;
+    records[1] = (uint32_t)baseZ;
+    uint32_t* out = records.data() + FACE_RECORD_HEADER_WORDS;
+    for (size_t f = 0; f < faceCount; ++f, out += FACE_RECORD_WORDS) {
+        int face, x, y, z, scale;
+        BlockID blockId;
+        unsigned int texIndex;
+        if (!ReadFace(vertices.data() + f * FACE_FLOATS, face, x, y, z, scale, blockId, texIndex)) {
+            return false;
+        }
+        x -= baseX;
+        z -= baseZ;
+        if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_HEIGHT || z < 0 || z >= CHUNK_SIZE || scale > 8 || texIndex > 0xFFFF) {
+            return false;
+        }
+        const uint32_t scaleLog2 = (scale >= 8) ? 3 : (scale >= 4) ? 2 : (scale >= 2) ? 1 : 0;
+        out[0] = (uint32_t)x | ((uint32_t)z << 4) | ((uint32_t)y << 8) | ((uint32_t)face << 14) | (scaleLog2 << 17);
+        out[1] = (uint32_t)blockId | ((uint32_t)texIndex << 16);
+    }
+    return true;
+}
+
+void TranslucentOrder::Reset(const std::vector<glm::vec3>& faceCenters) {
+    centers = faceCenters;
+    faces.resize(centers.size());
+    for (uint32_t i = 0; i < faces.size(); ++i) {
+        faces[i] = i;
+    }
+    distances.resize(centers.size());
+    indices.clear();
+}
+
+bool TranslucentOrder::Sort(glm::vec3 cameraPos) {
+    for (size_t i = 0; i < centers.size(); ++i) {
+        glm::vec3 d = centers[i] - cameraPos;
+        distances[i] = d.x * d.x + d.y * d.y + d.z * d.z;
+    }
+
+    // Insertion sort, farthest first. The previous order is nearly right after a small camera
+    // move, so most faces are not moved at all.
+    bool changed = indices.empty();
+    for (size_t i = 1; i < faces.size(); ++i) {
+        uint32_t face = faces[i];
+        float distance = distances[face];
+        size_t j = i;
+        while (j > 0 && distances[faces[j - 1]] < distance) {
+            faces[j] = faces[j - 1];
+            --j;
+        }
+        if (j != i) {
+            faces[j] = face;
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        indices.resize(faces.size() * 6);
+        for (size_t i = 0; i < faces.size(); ++i) {
+            for (uint32_t v = 0; v < 6; ++v) {
+                indices[i * 6 + v] = faces[i] * 6 + v;
+            }
+        }
+    }
+    return changed;
+}
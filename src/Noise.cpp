@@ -0,0 +1,301 @@
+// src/Noise.cpp
+
+#include "Noise.h"
+
+#include <cmath>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NOISE_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define NOISE_X86_SIMD 0
+#endif
+
+// --- Hash Constants ---
+static const uint32_t HASH_X = 0x8da6b343u;
+static const uint32_t HASH_Y = 0xd8163841u;
+static const uint32_t HASH_Z = 0xcb1ab31fu;
+static const uint32_t HASH_MIX_1 = 0x2c1b3c6du;
+static const uint32_t HASH_MIX_2 = 0x297a2d39u;
+static const uint32_t OCTAVE_SEED_STEP = 0x9e3779b9u; // Each octave gets its own lattice
+
+// ============================================================================
+// Scalar reference. The SIMD kernels in NoiseKernel.inl follow these step for step.
+// ============================================================================
+
+static inline uint32_t Hash2(int x, int z, uint32_t seed) {
+    uint32_t h = ((uint32_t)x * HASH_X) ^ ((uint32_t)z * HASH_Z) ^ seed;
+    h *= HASH_MIX_1;
+    h ^= h >> 15;
+    h *= HASH_MIX_2;
+    return h ^ (h >> 15);
+}
+
+static inline uint32_t Hash3(int x, int y, int z, uint32_t seed) {
+    uint32_t h = ((uint32_t)x * HASH_X) ^ ((uint32_t)y * HASH_Y) ^ ((uint32_t)z * HASH_Z) ^ seed;
+    h *= HASH_MIX_1;
+    h ^= h >> 15;
+    h *= HASH_MIX_2;
+    return h ^ (h >> 15);
+}
+
+static inline float Grad2(uint32_t h, float x, float z) {
+    float u = (h & 0x80000000u) ? z : x;
+    float v = (h & 0x80000000u) ? x : z;
+    if (h & 0x20000000u) u = -u;
+    if (h & 0x40000000u) v = -v;
+    return u + v * 0.5f;
+}
+
+static inline float Grad3(uint32_t h, float x, float y, float z) {
+    uint32_t hb = h >> 28;
+    float u = (hb < 8) ? x : y;
+    float v = (hb < 4) ? y : ((hb == 12 || hb == 14) ? x : z);
+    if (hb & 1) u = -u;
+    if (hb & 2) v = -v;
+    return u + v;
+}
+
+static inline float Fade(float t) {
+    float a = t * 6.0f;
+    a = a - 15.0f;
+    a = a * t;
+    a = a + 10.0f;
+    return a * ((t * t) * t);
+}
+
+static inline float Lerp(float a, float b, float t) {
+    return a + t * (b - a);
+}
+
+static float ScalarNoise2(float x, float z, uint32_t seed) {
+    float fx = std::floor(x), fz = std::floor(z);
+    int ix = (int)fx, iz = (int)fz;
+    float tx = x - fx, tz = z - fz;
+    float tx1 = tx - 1.0f, tz1 = tz - 1.0f;
+
+    float g00 = Grad2(Hash2(ix, iz, seed), tx, tz);
+    float g10 = Grad2(Hash2(ix + 1, iz, seed), tx1, tz);
+    float g01 = Grad2(Hash2(ix, iz + 1, seed), tx, tz1);
+    float g11 = Grad2(Hash2(ix + 1, iz + 1, seed), tx1, tz1);
+
+    float u = Fade(tx), v = Fade(tz);
+    return Lerp(Lerp(g00, g10, u), Lerp(g01, g11, u), v);
+}
+
+static float ScalarNoise3(float x, float y, float z, uint32_t seed) {
+    float fx = std::floor(x), fy = std::floor(y), fz = std::floor(z);
+    int ix = (int)fx, iy = (int)fy, iz = (int)fz;
+    float tx = x - fx, ty = y - fy, tz = z - fz;
+    float tx1 = tx - 1.0f, ty1 = ty - 1.0f, tz1 = tz - 1.0f;
+
+    float g000 = Grad3(Hash3(ix, iy, iz, seed), tx, ty, tz);
+    float g100 = Grad3(Hash3(ix + 1, iy, iz, seed), tx1, ty, tz);
+    float g010 = Grad3(Hash3(ix, iy + 1, iz, seed), tx, ty1, tz);
+    float g110 = Grad3(Hash3(ix + 1, iy + 1, iz, seed), tx1, ty1, tz);
+    float g001 = Grad3(Hash3(ix, iy, iz + 1, seed), tx, ty, tz1);
+    float g101 = Grad3(Hash3(ix + 1, iy, iz + 1, seed), tx1, ty, tz1);
+    float g011 = Grad3(Hash3(ix, iy + 1, iz + 1, seed), tx, ty1, tz1);
+    float g111 = Grad3(Hash3(ix + 1, iy + 1, iz + 1, seed), tx1, ty1, tz1);
+
+    float u = Fade(tx), v = Fade(ty), w = Fade(tz);
+    float a = Lerp(Lerp(g000, g100, u), Lerp(g010, g110, u), v);
+    float b = Lerp(Lerp(g001, g101, u), Lerp(g011, g111, u), v);
+    return Lerp(a, b, w);
+}
+
+// 1 / (sum of octave amplitudes)
+static float FractalNorm(const FractalParams& params) {
+    float total = 0.0f, amplitude = 1.0f;
+    for (int octave = 0; octave < params.octaves; ++octave) {
+        total += amplitude;
+        amplitude *= params.gain;
+    }
+    return (total > 0.0f) ? 1.0f / total : 0.0f;
+}
+
+static float ScalarFractal2D(uint32_t seed, float x, float z, const FractalParams& params, float invNorm) {
+    float sum = 0.0f;
+    float frequency = params.frequency, amplitude = 1.0f;
+    for (int octave = 0; octave < params.octaves; ++octave) {
+        float n = ScalarNoise2(x * frequency, z * frequency, seed + (uint32_t)octave * OCTAVE_SEED_STEP);
+        sum = sum + n * amplitude;
+        frequency *= params.lacunarity;
+        amplitude *= params.gain;
+    }
+    return sum * invNorm;
+}
+
+static float ScalarFractal3D(uint32_t seed, float x, float y, float z, const FractalParams& params, float invNorm) {
+    float sum = 0.0f;
+    float frequency = params.frequency, amplitude = 1.0f;
+    for (int octave = 0; octave < params.octaves; ++octave) {
+        float n = ScalarNoise3(x * frequency, y * frequency, z * frequency, seed + (uint32_t)octave * OCTAVE_SEED_STEP);
+        sum = sum + n * amplitude;
+        frequency *= params.lacunarity;
+        amplitude *= params.gain;
+    }
+    return sum * invNorm;
+}
+
+// ============================================================================
+// SIMD kernels: NoiseKernel.inl compiled once per instruction set.
+// Target attributes (rather than -mavx2 for the whole build) keep the binary runnable on any
+// x86-64 CPU; DetectNoiseISA() decides at runtime which kernel is safe to call.
+// ============================================================================
+
+#if NOISE_X86_SIMD
+
+#define NOISE_SSE41 __attribute__((target("sse4.1")))
+#define NOISE_AVX2 __attribute__((target("avx2")))
+
+namespace sse41 {
+typedef __m128 F;
+typedef __m128i I;
+const int LANES = 4;
+
+NOISE_SSE41 static inline F Set(float v) { return _mm_set1_ps(v); }
+NOISE_SSE41 static inline I SetI(uint32_t v) { return _mm_set1_epi32((int)v); }
+NOISE_SSE41 static inline I Iota() { return _mm_setr_epi32(0, 1, 2, 3); }
+NOISE_SSE41 static inline F Add(F a, F b) { return _mm_add_ps(a, b); }
+NOISE_SSE41 static inline F Sub(F a, F b) { return _mm_sub_ps(a, b); }
+NOISE_SSE41 static inline F Mul(F a, F b) { return _mm_mul_ps(a, b); }
+NOISE_SSE41 static inline F Floor(F a) { return _mm_floor_ps(a); }
+NOISE_SSE41 static inline F FXor(F a, F b) { return _mm_xor_ps(a, b); }
+NOISE_SSE41 static inline F Select(F mask, F a, F b) { return _mm_blendv_ps(a, b, mask); } // b where mask sign bit set
+NOISE_SSE41 static inline I FToI(F a) { return _mm_cvttps_epi32(a); }
+NOISE_SSE41 static inline F IToF(I a) { return _mm_cvtepi32_ps(a); }
+NOISE_SSE41 static inline F CastF(I a) { return _mm_castsi128_ps(a); }
+NOISE_SSE41 static inline I IAdd(I a, I b) { return _mm_add_epi32(a, b); }
+NOISE_SSE41 static inline I IMul(I a, I b) { return _mm_mullo_epi32(a, b); }
+NOISE_SSE41 static inline I IXor(I a, I b) { return _mm_xor_si128(a, b); }
+NOISE_SSE41 static inline I IAnd(I a, I b) { return _mm_and_si128(a, b); }
+NOISE_SSE41 static inline I ICmpEq(I a, I b) { return _mm_cmpeq_epi32(a, b); }
+template <int N> NOISE_SSE41 static inline I ISrl(I a) { return _mm_srli_epi32(a, N); }
+template <int N> NOISE_SSE41 static inline I ISll(I a) { return _mm_slli_epi32(a, N); }
+NOISE_SSE41 static inline void Store(float* out, F a) { _mm_storeu_ps(out, a); }
+
+#define NOISE_FN NOISE_SSE41 static inline
+#include "NoiseKernel.inl"
+#undef NOISE_FN
+} // namespace sse41
+
+namespace avx2 {
+typedef __m256 F;
+typedef __m256i I;
+const int LANES = 8;
+
+NOISE_AVX2 static inline F Set(float v) { return _mm256_set1_ps(v); }
+NOISE_AVX2 static inline I SetI(uint32_t v) { return _mm256_set1_epi32((int)v); }
+NOISE_AVX2 static inline I Iota() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+NOISE_AVX2 static inline F Add(F a, F b) { return _mm256_add_ps(a, b); }
+NOISE_AVX2 static inline F Sub(F a, F b) { return _mm256_sub_ps(a, b); }
+NOISE_AVX2 static inline F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+NOISE_AVX2 static inline F Floor(F a) { return _mm256_floor_ps(a); }
+NOISE_AVX2 static inline F FXor(F a, F b) { return _mm256_xor_ps(a, b); }
+NOISE_AVX2 static inline F Select(F mask, F a, F b) { return _mm256_blendv_ps(a, b, mask); } // b where mask sign bit set
+NOISE_AVX2 static inline I FToI(F a) { return _mm256_cvttps_epi32(a); }
+NOISE_AVX2 static inline F IToF(I a) { return _mm256_cvtepi32_ps(a); }
+NOISE_AVX2 static inline F CastF(I a) { return _mm256_castsi256_ps(a); }
+NOISE_AVX2 static inline I IAdd(I a, I b) { return _mm256_add_epi32(a, b); }
+NOISE_AVX2 static inline I IMul(I a, I b) { return _mm256_mullo_epi32(a, b); }
+NOISE_AVX2 static inline I IXor(I a, I b) { return _mm256_xor_si256(a, b); }
+NOISE_AVX2 static inline I IAnd(I a, I b) { return _mm256_and_si256(a, b); }
+NOISE_AVX2 static inline I ICmpEq(I a, I b) { return _mm256_cmpeq_epi32(a, b); }
+template <int N> NOISE_AVX2 static inline I ISrl(I a) { return _mm256_srli_epi32(a, N); }
+template <int N> NOISE_AVX2 static inline I ISll(I a) { return _mm256_slli_epi32(a, N); }
+NOISE_AVX2 static inline void Store(float* out, F a) { _mm256_storeu_ps(out, a); }
+
+#define NOISE_FN NOISE_AVX2 static inline
+#include "NoiseKernel.inl"
+#undef NOISE_FN
+} // namespace avx2
+
+#endif
+
+// ============================================================================
+// Instruction set selection
+// ============================================================================
+
+NoiseISA DetectNoiseISA() {
+#if NOISE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return NoiseISA::AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return NoiseISA::SSE41;
+#endif
+    return NoiseISA::Scalar;
+}
+
+static NoiseISA& ActiveISASlot() {
+    static NoiseISA isa = DetectNoiseISA();
+    return isa;
+}
+
+NoiseISA ActiveNoiseISA() {
+    return ActiveISASlot();
+}
+
+void SetNoiseISA(NoiseISA isa) {
+    NoiseISA best = DetectNoiseISA();
+    ActiveISASlot() = ((int)isa <= (int)best) ? isa : best;
+}
+
+const char* NoiseISAName(NoiseISA isa) {
+    switch (isa) {
+        case NoiseISA::AVX2:  return "AVX2";
+        case NoiseISA::SSE41: return "SSE4.1";
+        default:              return "Scalar";
+    }
+}
+
+// ============================================================================
+// GradientNoise
+// ============================================================================
+
+GradientNoise::GradientNoise(uint32_t seed) : seed(seed) {}
+
+float GradientNoise::Noise2D(float x, float z) const {
+    return ScalarNoise2(x, z, seed);
+}
+
+float GradientNoise::Noise3D(float x, float y, float z) const {
+    return ScalarNoise3(x, y, z, seed);
+}
+
+float GradientNoise::Fractal2D(float x, float z, const FractalParams& params) const {
+    return ScalarFractal2D(seed, x, z, params, FractalNorm(params));
+}
+
+float GradientNoise::Fractal3D(float x, float y, float z, const FractalParams& params) const {
+    return ScalarFractal3D(seed, x, y, z, params, FractalNorm(params));
+}
+
+void GradientNoise::Fractal2DRow(float x, float z0, float step, int count, const FractalParams& params, float* out) const {
+    const float invNorm = FractalNorm(params);
+    int done = 0;
+#if NOISE_X86_SIMD
+    switch (ActiveNoiseISA()) {
+        case NoiseISA::AVX2:  done = avx2::Fractal2DRow(seed, x, z0, step, count, params, invNorm, out); break;
+        case NoiseISA::SSE41: done = sse41::Fractal2DRow(seed, x, z0, step, count, params, invNorm, out); break;
+        default: break;
+    }
+#endif
+    for (int i = done; i < count; ++i) {
+        out[i] = ScalarFractal2D(seed, x, (float)i * step + z0, params, invNorm);
+    }
+}
+
+void GradientNoise::Fractal3DRow(float x, float y, float z0, float step, int count, const FractalParams& params, float* out) const {
+    const float invNorm = FractalNorm(params);
+    int done = 0;
+#if NOISE_X86_SIMD
+    switch (ActiveNoiseISA()) {
+        case NoiseISA::AVX2:  done = avx2::Fractal3DRow(seed, x, y, z0, step, count, params, invNorm, out); break;
+        case NoiseISA::SSE41: done = sse41::Fractal3DRow(seed, x, y, z0, step, count, params, invNorm, out); break;
+        default: break;
+    }
+#endif
+    for (int i = done; i < count; ++i) {
+        out[i] = ScalarFractal3D(seed, x, y, (float)i * step + z0, params, invNorm);
+    }
+}
@@ -0,0 +1,132 @@
+// src/NoiseKernel.inl
+// Gradient noise kernel shared by the SSE4.1 and AVX2 paths of Noise.cpp.
+//
+// Included once per instruction set, inside a namespace that provides the vector types F (float
+// lanes) and I (int32 lanes), LANES, and the thin intrinsic wrappers used below. NOISE_FN carries
+// the matching target attribute. Every step mirrors the scalar code in Noise.cpp operation for
+// operation (no FMA, same evaluation order): the SIMD and scalar results must match bit for bit.
+
+NOISE_FN I Hash2(I x, I z, I seed) {
+    I h = IXor(IXor(IMul(x, SetI(HASH_X)), IMul(z, SetI(HASH_Z))), seed);
+    h = IMul(h, SetI(HASH_MIX_1));
+    h = IXor(h, ISrl<15>(h));
+    h = IMul(h, SetI(HASH_MIX_2));
+    return IXor(h, ISrl<15>(h));
+}
+
+NOISE_FN I Hash3(I x, I y, I z, I seed) {
+    I h = IXor(IXor(IMul(x, SetI(HASH_X)), IMul(y, SetI(HASH_Y))), IXor(IMul(z, SetI(HASH_Z)), seed));
+    h = IMul(h, SetI(HASH_MIX_1));
+    h = IXor(h, ISrl<15>(h));
+    h = IMul(h, SetI(HASH_MIX_2));
+    return IXor(h, ISrl<15>(h));
+}
+
+// Top hash bits: 31 swaps the axes, 30/29 flip the signs -> 8 gradients (+-1, +-0.5) and (+-0.5, +-1)
+NOISE_FN F Grad2(I h, F x, F z) {
+    F u = Select(CastF(h), x, z);
+    F v = Select(CastF(h), z, x);
+    u = FXor(u, CastF(ISll<2>(IAnd(h, SetI(0x20000000u)))));
+    v = FXor(v, CastF(ISll<1>(IAnd(h, SetI(0x40000000u)))));
+    return Add(u, Mul(v, Set(0.5f)));
+}
+
+// Perlin's 12 cube-edge gradients, picked by the top 4 hash bits (see Grad3 in Noise.cpp)
+NOISE_FN F Grad3(I h, F x, F y, F z) {
+    F u = Select(CastF(h), x, y);
+    F v = Select(CastF(ICmpEq(IAnd(h, SetI(0xD0000000u)), SetI(0xC0000000u))), z, x);
+    v = Select(CastF(ICmpEq(IAnd(h, SetI(0xC0000000u)), SetI(0u))), v, y);
+    u = FXor(u, CastF(ISll<3>(IAnd(h, SetI(0x10000000u)))));
+    v = FXor(v, CastF(ISll<2>(IAnd(h, SetI(0x20000000u)))));
+    return Add(u, v);
+}
+
+NOISE_FN F Fade(F t) {
+    F a = Mul(t, Set(6.0f));
+    a = Sub(a, Set(15.0f));
+    a = Mul(a, t);
+    a = Add(a, Set(10.0f));
+    return Mul(a, Mul(Mul(t, t), t));
+}
+
+NOISE_FN F Lerp(F a, F b, F t) {
+    return Add(a, Mul(t, Sub(b, a)));
+}
+
+NOISE_FN F Noise2(F x, F z, I seed) {
+    F fx = Floor(x), fz = Floor(z);
+    I ix = FToI(fx), iz = FToI(fz);
+    I ix1 = IAdd(ix, SetI(1u)), iz1 = IAdd(iz, SetI(1u));
+    F tx = Sub(x, fx), tz = Sub(z, fz);
+    F tx1 = Sub(tx, Set(1.0f)), tz1 = Sub(tz, Set(1.0f));
+
+    F g00 = Grad2(Hash2(ix, iz, seed), tx, tz);
+    F g10 = Grad2(Hash2(ix1, iz, seed), tx1, tz);
+    F g01 = Grad2(Hash2(ix, iz1, seed), tx, tz1);
+    F g11 = Grad2(Hash2(ix1, iz1, seed), tx1, tz1);
+
+    F u = Fade(tx), v = Fade(tz);
+    return Lerp(Lerp(g00, g10, u), Lerp(g01, g11, u), v);
+}
+
+NOISE_FN F Noise3(F x, F y, F z, I seed) {
+    F fx = Floor(x), fy = Floor(y), fz = Floor(z);
+    I ix = FToI(fx), iy = FToI(fy), iz = FToI(fz);
+    I ix1 = IAdd(ix, SetI(1u)), iy1 = IAdd(iy, SetI(1u)), iz1 = IAdd(iz, SetI(1u));
+    F tx = Sub(x, fx), ty = Sub(y, fy), tz = Sub(z, fz);
+    F tx1 = Sub(tx, Set(1.0f)), ty1 = Sub(ty, Set(1.0f)), tz1 = Sub(tz, Set(1.0f));
+
+    F g000 = Grad3(Hash3(ix, iy, iz, seed), tx, ty, tz);
+    F g100 = Grad3(Hash3(ix1, iy, iz, seed), tx1, ty, tz);
+    F g010 = Grad3(Hash3(ix, iy1, iz, seed), tx, ty1, tz);
+    F g110 = Grad3(Hash3(ix1, iy1, iz, seed), tx1, ty1, tz);
+    F g001 = Grad3(Hash3(ix, iy, iz1, seed), tx, ty, tz1);
+    F g101 = Grad3(Hash3(ix1, iy, iz1, seed), tx1, ty, tz1);
+    F g011 = Grad3(Hash3(ix, iy1, iz1, seed), tx, ty1, tz1);
+    F g111 = Grad3(Hash3(ix1, iy1, iz1, seed), tx1, ty1, tz1);
+
+    F u = Fade(tx), v = Fade(ty), w = Fade(tz);
+    F a = Lerp(Lerp(g000, g100, u), Lerp(g010, g110, u), v);
+    F b = Lerp(Lerp(g001, g101, u), Lerp(g011, g111, u), v);
+    return Lerp(a, b, w);
+}
+
+// Both row functions fill whole vectors only and return how many samples they wrote;
+// the caller finishes the tail with the scalar code.
+NOISE_FN int Fractal2DRow(uint32_t seed, float x, float z0, float step, int count,
+                          const FractalParams& params, float invNorm, float* out) {
+    int i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        F z = Add(Mul(IToF(IAdd(SetI((uint32_t)i), Iota())), Set(step)), Set(z0));
+        F sum = Set(0.0f);
+        float frequency = params.frequency, amplitude = 1.0f;
+        for (int octave = 0; octave < params.octaves; ++octave) {
+            I octaveSeed = SetI(seed + (uint32_t)octave * OCTAVE_SEED_STEP);
+            F n = Noise2(Mul(Set(x), Set(frequency)), Mul(z, Set(frequency)), octaveSeed);
+            sum = Add(sum, Mul(n, Set(amplitude)));
+            frequency *= params.lacunarity;
+            amplitude *= params.gain;
+        }
+        Store(out + i, Mul(sum, Set(invNorm)));
+    }
+    return i;
+}
+
+NOISE_FN int Fractal3DRow(uint32_t seed, float x, float y, float z0, float step, int count,
+                          const FractalParams& params, float invNorm, float* out) {
+    int i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        F z = Add(Mul(IToF(IAdd(SetI((uint32_t)i), Iota())), Set(step)), Set(z0));
+        F sum = Set(0.0f);
+        float frequency = params.frequency, amplitude = 1.0f;
+        for (int octave = 0; octave < params.octaves; ++octave) {
+            I octaveSeed = SetI(seed + (uint32_t)octave * OCTAVE_SEED_STEP);
+            F n = Noise3(Mul(Set(x), Set(frequency)), Mul(Set(y), Set(frequency)), Mul(z, Set(frequency)), octaveSeed);
+            sum = Add(sum, Mul(n, Set(amplitude)));
+            frequency *= params.lacunarity;
+            amplitude *= params.gain;
+        }
+        Store(out + i, Mul(sum, Set(invNorm)));
+    }
+    return i;
+}
@@ -0,0 +1,185 @@
+// src/OcclusionCuller.cpp
+
+#include "OcclusionCuller.h"
+#include "Mesher.h" // FACE_VERTICES: the box is the unit cube
+
+// Chunks whose box is this close to the camera are always drawn: the near plane would clip
+// their box, and a query on a clipped box can report a visible chunk as occluded
+const float OCCLUSION_NEAR_MARGIN = 1.0f;
+
+void Frustum::Extract(const glm::mat4& m) {
+    // Rows of the (column-major) matrix
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; ++i) {
+        rows[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+    }
+    planes[0] = rows[3] + rows[0]; // Left
+    planes[1] = rows[3] - rows[0]; // Right
+    planes[2] = rows[3] + rows[1]; // Bottom
+    planes[3] = rows[3] - rows[1]; // Top
+    planes[4] = rows[3] + rows[2]; // Near
+    planes[5] = rows[3] - rows[2]; // Far
+}
+
+bool Frustum::Intersects(glm::vec3 boxMin, glm::vec3 boxMax) const {
+    for (const glm::vec4& p : planes) {
+        // The box corner furthest along the plane normal
+        const float x = (p.x >= 0.0f) ? boxMax.x : boxMin.x;
+        const float y = (p.y >= 0.0f) ? boxMax.y : boxMin.y;
+        const float z = (p.z >= 0.0f) ? boxMax.z : boxMin.z;
+        if (p.x * x + p.y * y + p.z * z + p.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+OcclusionCuller::~OcclusionCuller() {
+    Shutdown();
+}
+
+void OcclusionCuller::Init(const char* vertexPath, const char* fragmentPath) {
+    boxShader = std::make_unique<Shader>(vertexPath, fragmentPath);
+    centerLocation = glGetUniformLocation(boxShader->ID, "boxCenter");
+    sizeLocation = glGetUniformLocation(boxShader->ID, "boxSize");
+
+    // Position only, taken from the unit cube faces (36 vertices, 8 floats each)
+    glGenVertexArrays(1, &boxVAO);
+    glGenBuffers(1, &boxVBO);
+    glBindVertexArray(boxVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, boxVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(FACE_VERTICES), FACE_VERTICES, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void OcclusionCuller::Shutdown() {
+    if (!boxShader) {
+        return;
+    }
+    for (auto& pair : states) {
+        if (pair.second.query != 0) freeQueries.push_back(pair.second.query);
+    }
+    if (!freeQueries.empty()) {
+        glDeleteQueries((GLsizei)freeQueries.size(), freeQueries.data());
+    }
+    states.clear();
+    freeQueries.clear();
+    glDeleteVertexArrays(1, &boxVAO);
+    glDeleteBuffers(1, &boxVBO);
+    glDeleteProgram(boxShader->ID);
+    boxShader.reset();
+    boxVAO = boxVBO = 0;
+}
+
+void OcclusionCuller::BeginFrame(const glm::mat4& frameViewProjection, glm::vec3 frameCameraPos) {
+    viewProjection = frameViewProjection;
+    cameraPos = frameCameraPos;
+    frustum.Extract(viewProjection);
+    boxes.clear();
+    stats = OcclusionStats();
+
+    // Last frame's answers; a query still in flight keeps its chunk's old state for now
+    for (auto& pair : states) {
+        ChunkState& state = pair.second;
+        state.queued = false;
+        if (!state.pending) continue;
+        unsigned int available = 0;
+        glGetQueryObjectuiv(state.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            unsigned int anySamples = 0;
+            glGetQueryObjectuiv(state.query, GL_QUERY_RESULT, &anySamples);
+            state.visible = (anySamples != 0);
+            state.pending = false;
+        }
+    }
+}
+
+ChunkVisibility OcclusionCuller::Classify(int64_t key, glm::vec3 boxMin, glm::vec3 boxMax) {
+    ++stats.chunks;
+    if (!frustum.Intersects(boxMin, boxMax)) {
+        return ChunkVisibility::Culled;
+    }
+    ++stats.inFrustum;
+    const glm::vec3 margin(OCCLUSION_NEAR_MARGIN);
+    const glm::vec3 nearMin = boxMin - margin, nearMax = boxMax + margin;
+    const bool cameraInside = cameraPos.x >= nearMin.x && cameraPos.x <= nearMax.x &&
+                              cameraPos.y >= nearMin.y && cameraPos.y <= nearMax.y &&
+                              cameraPos.z >= nearMin.z && cameraPos.z <= nearMax.z;
+    if (!enabled || cameraInside) {
+        ++stats.visible;
+        return ChunkVisibility::Visible;
+    }
+
+    ChunkState& state = states[key];
+    if (!state.pending) {
+        // Visible chunks are re-tested too, to find out when they become hidden
+        state.queued = true;
+        boxes.push_back({ key, (boxMin + boxMax) * 0.5f, boxMax - boxMin });
+    }
+    if (state.visible) {
+        ++stats.visible;
+        return ChunkVisibility::Visible;
+    }
+    ++stats.occluded;
+    return ChunkVisibility::Tested;
+}
+
+void OcclusionCuller::IssueQueries() {
+    if (boxes.empty()) {
+        return;
+    }
+    boxShader->use();
+    boxShader->setMat4("viewProjection", viewProjection);
+    glBindVertexArray(boxVAO);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    for (const QueuedBox& box : boxes) {
+        ChunkState& state = states[box.key];
+        if (state.query == 0) {
+            if (!freeQueries.empty()) {
+                state.query = freeQueries.back();
+                freeQueries.pop_back();
+            } else {
+                glGenQueries(1, &state.query);
+            }
+        }
+        glUniform3f(centerLocation, box.center.x, box.center.y, box.center.z);
+        glUniform3f(sizeLocation, box.size.x, box.size.y, box.size.z);
+        glBeginQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE, state.query);
+        glDrawArrays(GL_TRIANGLES, 0, 36);
+        glEndQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+        state.pending = true;
+        ++stats.queries;
+    }
+    glDepthMask(GL_TRUE);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glBindVertexArray(0);
+}
+
+void OcclusionCuller::BeginConditional(int64_t key) const {
+    auto it = states.find(key);
+    if (it == states.end() || it->second.query == 0) {
+        return;
+    }
+    // A fresh query: let the GPU wait for its own answer. An older one still in flight: draw unless
+    // it has already come back occluded (conservative, never a CPU stall).
+    glBeginConditionalRender(it->second.query, it->second.queued ? GL_QUERY_WAIT : GL_QUERY_NO_WAIT);
+}
+
+void OcclusionCuller::EndConditional() const {
+    glEndConditionalRender();
+}
+
+void OcclusionCuller::Release(int64_t key) {
+    auto it = states.find(key);
+    if (it == states.end()) {
+        return;
+    }
+    if (it->second.query != 0) {
+        freeQueries.push_back(it->second.query);
+    }
+    states.erase(it);
+}
@@ -0,0 +1,449 @@
+// src/RegionFile.cpp
+
+#include "RegionFile.h"
+#include "ChunkCodec.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+// --- Little-endian helpers (files are portable between machines) ---
+static void PutU16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back((uint8_t)v);
+    out.push_back((uint8_t)(v >> 8));
+}
+
+static uint16_t GetU16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+static void StoreU32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t LoadU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Full-length pread/pwrite (retry on short transfers)
+static bool ReadAt(int fd, void* data, size_t size, off_t offset) {
+    uint8_t* p = (uint8_t*)data;
+    while (size > 0) {
+        ssize_t n = pread(fd, p, size, offset);
+        if (n <= 0) return false;
+        p += n; size -= (size_t)n; offset += n;
+    }
+    return true;
+}
+
+static bool WriteAt(int fd, const void* data, size_t size, off_t offset) {
+    const uint8_t* p = (const uint8_t*)data;
+    while (size > 0) {
+        ssize_t n = pwrite(fd, p, size, offset);
+        if (n <= 0) return false;
+        p += n; size -= (size_t)n; offset += n;
+    }
+    return true;
+}
+
+// ============================================================================
+// Chunk payload encoding
+// ============================================================================
+
+void EncodeChunkRLE(const Chunk& chunk, std::vector<uint8_t>& out) {
+    out.clear();
+
+    // Block IDs: (uint16 id, uint16 run length) pairs
+    int i = 0;
+    while (i < CHUNK_VOLUME) {
+        BlockID id = chunk.blocks[i];
+        int run = 1;
+        while (i + run < CHUNK_VOLUME && chunk.blocks[i + run] == id && run < 0xFFFF) ++run;
+        PutU16(out, id);
+        PutU16(out, (uint16_t)run);
+        i += run;
+    }
+
+    // Fluid levels: (uint8 level, uint16 run length) triples
+    i = 0;
+    while (i < CHUNK_VOLUME) {
+        uint8_t level = chunk.fluidLevel[i];
+        int run = 1;
+        while (i + run < CHUNK_VOLUME && chunk.fluidLevel[i + run] == level && run < 0xFFFF) ++run;
+        out.push_back(level);
+        PutU16(out, (uint16_t)run);
+        i += run;
+    }
+}
+
+bool DecodeChunkRLE(const uint8_t* data, size_t size, Chunk& chunk) {
+    size_t pos = 0;
+
+    int i = 0;
+    while (i < CHUNK_VOLUME) {
+        if (pos + 4 > size) return false;
+        BlockID id = GetU16(data + pos);
+        int run = GetU16(data + pos + 2);
+        pos += 4;
+        if (run == 0 || i + run > CHUNK_VOLUME) return false;
+        std::fill(chunk.blocks + i, chunk.blocks + i + run, id);
+        i += run;
+    }
+
+    i = 0;
+    while (i < CHUNK_VOLUME) {
+        if (pos + 3 > size) return false;
+        uint8_t level = data[pos];
+        int run = GetU16(data + pos + 1);
+        pos += 3;
+        if (run == 0 || i + run > CHUNK_VOLUME) return false;
+        std::fill(chunk.fluidLevel + i, chunk.fluidLevel + i + run, level);
+        i += run;
+    }
+    return pos == size;
+}
+
+// ============================================================================
+// RegionFile
+// ============================================================================
+
+RegionFile::~RegionFile() {
+    Close();
+}
+
+bool RegionFile::Open(const std::string& path, bool create, bool durable) {
+    Close();
+    this->durable = durable;
+    retiredEntries.clear();
+
+    fd = ::open(path.c_str(), O_RDWR | (create ? O_CREAT : 0), 0644);
+    if (fd < 0) {
+        if (create) std::cerr << "ERROR::REGION: Cannot open " << path << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        Close();
+        return false;
+    }
+
+    uint8_t table[REGION_SECTOR_SIZE] = {};
+    if (info.st_size == 0) {
+        // New file: write an empty offset table
+        if (!WriteAt(fd, table, sizeof(table), 0)) {
+            std::cerr << "ERROR::REGION: Cannot initialise " << path << std::endl;
+            Close();
+            return false;
+        }
+        info.st_size = REGION_SECTOR_SIZE;
+    } else if (info.st_size < REGION_SECTOR_SIZE || !ReadAt(fd, table, sizeof(table), 0)) {
+        std::cerr << "ERROR::REGION: " << path << " has no valid offset table" << std::endl;
+        Close();
+        return false;
+    }
+
+    // Rebuild the sector map from the offset table
+    const size_t fileSectors = (size_t)((info.st_size + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE);
+    sectorUsed.assign(fileSectors, false);
+    sectorUsed[0] = true;
+    for (int i = 0; i < REGION_CHUNKS; ++i) {
+        uint32_t entry = LoadU32(table + i * 4);
+        uint32_t first = entry >> 8, count = entry & 0xFF;
+        if (entry != 0 && (first == 0 || count == 0 || first + count > fileSectors)) {
+            std::cerr << "WARNING::REGION: Dropping bad table entry " << i << " in " << path << std::endl;
+            entry = 0;
+        }
+        // Two chunks in the same sectors: freeing one would free the other's data
+        if (entry != 0 && std::any_of(sectorUsed.begin() + first, sectorUsed.begin() + first + count, [](bool used) { return used; })) {
+            std::cerr << "WARNING::REGION: Dropping table entry " << i << " overlapping another chunk in " << path << std::endl;
+            entry = 0;
+        }
+        offsets[i] = entry;
+        if (entry != 0) {
+            SetSectors(first, count, true);
+        }
+    }
+    return true;
+}
+
+void RegionFile::Close() {
+    if (fd >= 0) {
+        if (durable) {
+            Sync();
+        }
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+bool RegionFile::HasChunk(int localX, int localZ) const {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    return offsets[TableIndex(localX, localZ)] != 0;
+}
+
+bool RegionFile::ReadChunk(int localX, int localZ, Chunk& chunk) const {
+    thread_local std::vector<uint8_t> payload;
+    uint8_t codec;
+    if (!ReadPayload(localX, localZ, payload, codec)) {
+        return false;
+    }
+    if (codec == REGION_CODEC_RLE) {
+        return DecodeChunkRLE(payload.data(), payload.size(), chunk);
+    }
+    if (codec == REGION_CODEC_PALETTE_LZ) {
+        return DecodeChunkCompressed(payload.data(), payload.size(), chunk);
+    }
+    std::cerr << "ERROR::REGION: Unknown codec " << (int)codec << " for chunk " << chunk.chunkX << "," << chunk.chunkZ << std::endl;
+    return false;
+}
+
+bool RegionFile::WriteChunk(int localX, int localZ, const Chunk& chunk) {
+    thread_local std::vector<uint8_t> payload;
+
+    // Encode outside the lock
+    EncodeChunkCompressed(chunk, payload);
+    if (payload.size() > REGION_MAX_PAYLOAD) {
+        std::cerr << "ERROR::REGION: Chunk " << chunk.chunkX << "," << chunk.chunkZ << " too large to save" << std::endl;
+        return false;
+    }
+    return WritePayload(localX, localZ, payload.data(), payload.size(), REGION_CODEC_PALETTE_LZ);
+}
+
+bool RegionFile::ReadPayload(int localX, int localZ, std::vector<uint8_t>& payload, uint8_t& codec) const {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    const uint32_t entry = offsets[TableIndex(localX, localZ)];
+    if (entry == 0) {
+        return false;
+    }
+    const uint32_t first = entry >> 8, count = entry & 0xFF;
+    payload.resize((size_t)count * REGION_SECTOR_SIZE);
+    if (!ReadAt(fd, payload.data(), payload.size(), (off_t)first * REGION_SECTOR_SIZE)) {
+        return false;
+    }
+    guard.unlock(); // The payload is in memory; writers may move the chunk now
+
+    const uint32_t length = LoadU32(payload.data());
+    codec = payload[4];
+    if ((size_t)length + 5 > payload.size()) {
+        std::cerr << "ERROR::REGION: Bad payload header in slot " << localX << "," << localZ << std::endl;
+        return false;
+    }
+    payload.erase(payload.begin(), payload.begin() + 5);
+    payload.resize(length);
+    return true;
+}
+
+bool RegionFile::WritePayload(int localX, int localZ, const uint8_t* payload, size_t size, uint8_t codec) {
+    thread_local std::vector<uint8_t> buffer;
+
+    if (size > REGION_MAX_PAYLOAD) {
+        return false;
+    }
+    const size_t total = size + 5;
+    const uint32_t count = (uint32_t)((total + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE);
+    buffer.assign((size_t)count * REGION_SECTOR_SIZE, 0); // Padded to whole sectors
+    StoreU32(buffer.data(), (uint32_t)size);
+    buffer[4] = codec;
+    std::copy(payload, payload + size, buffer.begin() + 5);
+
+    std::unique_lock<std::shared_mutex> guard(lock);
+    const int index = TableIndex(localX, localZ);
+    const uint32_t oldEntry = offsets[index];
+
+    // Copy-on-write: new sectors first, then switch the table entry, then free the old sectors
+    const uint32_t first = AllocateSectors(count);
+    if (!WriteAt(fd, buffer.data(), buffer.size(), (off_t)first * REGION_SECTOR_SIZE)) {
+        SetSectors(first, count, false);
+        return false;
+    }
+    if (durable) {
+        // The payload must be on disk before an entry points at it. This also flushes the entries
+        // of earlier writes, so the sectors they replaced can be reused now.
+        if (::fdatasync(fd) != 0) {
+            SetSectors(first, count, false);
+            return false;
+        }
+        FreeRetiredSectors();
+    }
+    const uint32_t entry = (first << 8) | count;
+    uint8_t entryBytes[4];
+    StoreU32(entryBytes, entry);
+    if (!WriteAt(fd, entryBytes, sizeof(entryBytes), (off_t)index * 4)) {
+        SetSectors(first, count, false);
+        return false;
+    }
+    offsets[index] = entry;
+    if (oldEntry != 0) {
+        if (durable) {
+            retiredEntries.push_back(oldEntry); // Until the new entry is flushed
+        } else {
+            SetSectors(oldEntry >> 8, oldEntry & 0xFF, false);
+        }
+    }
+    return true;
+}
+
+bool RegionFile::Sync() {
+    std::unique_lock<std::shared_mutex> guard(lock);
+    if (fd < 0) {
+        return false;
+    }
+    if (::fdatasync(fd) != 0) {
+        std::cerr << "ERROR::REGION: fdatasync failed" << std::endl;
+        return false;
+    }
+    FreeRetiredSectors();
+    return true;
+}
+
+void RegionFile::FreeRetiredSectors() {
+    for (uint32_t entry : retiredEntries) {
+        SetSectors(entry >> 8, entry & 0xFF, false);
+    }
+    retiredEntries.clear();
+}
+
+uint32_t RegionFile::AllocateSectors(uint32_t count) {
+    // First fit among the gaps
+    uint32_t runStart = 0, runLength = 0;
+    for (uint32_t s = 1; s < sectorUsed.size(); ++s) {
+        if (sectorUsed[s]) {
+            runLength = 0;
+            continue;
+        }
+        if (runLength == 0) runStart = s;
+        if (++runLength == count) {
+            SetSectors(runStart, count, true);
+            return runStart;
+        }
+    }
+
+    // No gap large enough: append, reusing a free run at the end of the file
+    uint32_t first = (uint32_t)sectorUsed.size();
+    while (first > 1 && !sectorUsed[first - 1]) {
+        --first;
+    }
+    if (sectorUsed.size() < first + count) {
+        sectorUsed.resize(first + count, false);
+    }
+    SetSectors(first, count, true);
+    return first;
+}
+
+void RegionFile::SetSectors(uint32_t first, uint32_t count, bool used) {
+    for (uint32_t s = first; s < first + count && s < sectorUsed.size(); ++s) {
+        sectorUsed[s] = used;
+    }
+}
+
+size_t RegionFile::SectorCount() const {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    return sectorUsed.size();
+}
+
+size_t RegionFile::FreeSectorCount() const {
+    std::shared_lock<std::shared_mutex> guard(lock);
+    size_t free = 0;
+    for (bool used : sectorUsed) {
+        if (!used) ++free;
+    }
+    return free;
+}
+
+// ============================================================================
+// RegionStore
+// ============================================================================
+
+RegionStore::RegionStore(const std::string& directory, bool durable) : directory(directory), durable(durable) {}
+
+RegionFile* RegionStore::GetRegion(int regionX, int regionZ, bool create) {
+    std::lock_guard<std::mutex> guard(regionsMutex);
+    const int64_t key = World::ChunkKey(regionX, regionZ);
+    auto it = regions.find(key);
+    if (it != regions.end()) {
+        return it->second.get();
+    }
+
+    const std::string path = directory + "/r." + std::to_string(regionX) + "." + std::to_string(regionZ) + ".region";
+    std::error_code error;
+    if (!create && !std::filesystem::exists(path, error)) {
+        return nullptr; // Nothing saved here yet; not cached so a later save can create it
+    }
+    if (create) {
+        std::filesystem::create_directories(directory, error);
+    }
+
+    std::unique_ptr<RegionFile> region = std::make_unique<RegionFile>();
+    if (!region->Open(path, create, durable)) {
+        return nullptr;
+    }
+    RegionFile* result = region.get();
+    regions.emplace(key, std::move(region));
+    return result;
+}
+
+bool RegionStore::LoadChunk(Chunk& chunk) {
+    const int regionX = ToRegionCoord(chunk.chunkX);
+    const int regionZ = ToRegionCoord(chunk.chunkZ);
+    RegionFile* region = GetRegion(regionX, regionZ, false);
+    if (!region) {
+        return false;
+    }
+    return region->ReadChunk(chunk.chunkX - regionX * REGION_SIZE, chunk.chunkZ - regionZ * REGION_SIZE, chunk);
+}
+
+bool RegionStore::SaveChunk(const Chunk& chunk) {
+    const int regionX = ToRegionCoord(chunk.chunkX);
+    const int regionZ = ToRegionCoord(chunk.chunkZ);
+    RegionFile* region = GetRegion(regionX, regionZ, true);
+    if (!region) {
+        return false;
+    }
+    const bool saved = region->WriteChunk(chunk.chunkX - regionX * REGION_SIZE, chunk.chunkZ - regionZ * REGION_SIZE, chunk);
+    std::lock_guard<std::mutex> guard(regionsMutex);
+    unsynced.insert(region);
+    return saved;
+}
+
+bool RegionStore::LoadPayload(int chunkX, int chunkZ, std::vector<uint8_t>& payload, uint8_t& codec) {
+    const int regionX = ToRegionCoord(chunkX);
+    const int regionZ = ToRegionCoord(chunkZ);
+    RegionFile* region = GetRegion(regionX, regionZ, false);
+    if (!region) {
+        return false;
+    }
+    return region->ReadPayload(chunkX - regionX * REGION_SIZE, chunkZ - regionZ * REGION_SIZE, payload, codec);
+}
+
+bool RegionStore::SavePayload(int chunkX, int chunkZ, const uint8_t* payload, size_t size, uint8_t codec) {
+    const int regionX = ToRegionCoord(chunkX);
+    const int regionZ = ToRegionCoord(chunkZ);
+    RegionFile* region = GetRegion(regionX, regionZ, true);
+    if (!region) {
+        return false;
+    }
+    const bool saved = region->WritePayload(chunkX - regionX * REGION_SIZE, chunkZ - regionZ * REGION_SIZE, payload, size, codec);
+    std::lock_guard<std::mutex> guard(regionsMutex);
+    unsynced.insert(region);
+    return saved;
+}
+
+bool RegionStore::Sync() {
+    std::unordered_set<RegionFile*> written;
+    {
+        std::lock_guard<std::mutex> guard(regionsMutex);
+        written.swap(unsynced);
+    }
+    bool synced = true;
+    for (RegionFile* region : written) {
+        if (!region->Sync()) {
+            synced = false;
+            std::lock_guard<std::mutex> guard(regionsMutex);
+            unsynced.insert(region); // Tried again next time
+        }
+    }
+    return synced;
+}
@@ -0,0 +1,70 @@
+// src/RenderPacket.cpp
+
+#include "RenderPacket.h"
+
+void RenderPacket::Clear() {
+    releases.clear();
+    uploadCount = 0;
+    indexUpdateCount = 0;
+    draws.clear();
+    translucentOrder.clear();
+    updateTitle = false;
+}
+
+ChunkUpload& RenderPacket::NextUpload() {
+    if (uploadCount == uploads.size()) {
+        uploads.emplace_back();
+    }
+    return uploads[uploadCount];
+}
+
+TranslucentIndexUpdate& RenderPacket::AddIndexUpdate() {
+    if (indexUpdateCount == indexUpdates.size()) {
+        indexUpdates.emplace_back();
+    }
+    return indexUpdates[indexUpdateCount++];
+}
+
+// --- RenderPacketQueue ---
+
+RenderPacket* RenderPacketQueue::BeginWrite() {
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this] { return stopped || written - read < RENDER_PACKET_COUNT; });
+    if (stopped) {
+        return nullptr;
+    }
+    return &packets[written % RENDER_PACKET_COUNT];
+}
+
+void RenderPacketQueue::EndWrite() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++written;
+    }
+    condition.notify_all();
+}
+
+RenderPacket* RenderPacketQueue::BeginRead() {
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this] { return stopped || written > read; });
+    if (stopped) {
+        return nullptr;
+    }
+    return &packets[read % RENDER_PACKET_COUNT];
+}
+
+void RenderPacketQueue::EndRead() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++read;
+    }
+    condition.notify_all();
+}
+
+void RenderPacketQueue::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+    condition.notify_all();
+}
@@ -0,0 +1,125 @@
+// src/SpatialHash.cpp
+
+#include "SpatialHash.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float cellSize)
+    : cellSize(cellSize), invCellSize(1.0f / cellSize) {}
+
+uint32_t SpatialHash::HashCell(int x, int y, int z) {
+    // Large primes from "Optimized Spatial Hashing for Collision Detection of Deformable Objects"
+    return ((uint32_t)x * 73856093u) ^ ((uint32_t)y * 19349663u) ^ ((uint32_t)z * 83492791u);
+}
+
+void SpatialHash::Build(const EntityStore& entities) {
+    const uint32_t count = entities.Count();
+
+    // Table size: next power of two >= 2x the entity count (min 1024). Only ever grows.
+    uint32_t tableSize = 1024;
+    while (tableSize < count * 2) tableSize <<= 1;
+    if (tableSize - 1 > bucketMask) {
+        bucketMask = tableSize - 1;
+        bucketStart.resize((size_t)tableSize + 1);
+    }
+
+    entries.resize(count);
+    scratchBucket.resize(count);
+    scratchCell.resize(count);
+
+    // 1. Bin every entity and count bucket sizes
+    std::fill(bucketStart.begin(), bucketStart.end(), 0);
+    maxHalfExtent = glm::vec3(0.0f);
+    for (uint32_t i = 0; i < count; ++i) {
+        glm::ivec3 cell((int)std::floor(entities.posX[i] * invCellSize),
+                        (int)std::floor(entities.posY[i] * invCellSize),
+                        (int)std::floor(entities.posZ[i] * invCellSize));
+        uint32_t bucket = HashCell(cell.x, cell.y, cell.z) & bucketMask;
+        scratchCell[i] = cell;
+        scratchBucket[i] = bucket;
+        bucketStart[bucket + 1]++;
+
+        maxHalfExtent.x = std::max(maxHalfExtent.x, entities.halfX[i]);
+        maxHalfExtent.y = std::max(maxHalfExtent.y, entities.halfY[i]);
+        maxHalfExtent.z = std::max(maxHalfExtent.z, entities.halfZ[i]);
+    }
+
+    // 2. Prefix sum -> first entry of each bucket
+    for (uint32_t b = 0; b <= bucketMask; ++b) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+
+    // 3. Scatter entries into place (bucketStart[b] is used as a write cursor, then restored)
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t slot = bucketStart[scratchBucket[i]]++;
+        glm::vec3 pos(entities.posX[i], entities.posY[i], entities.posZ[i]);
+        glm::vec3 half(entities.halfX[i], entities.halfY[i], entities.halfZ[i]);
+        Entry& entry = entries[slot];
+        entry.boxMin = pos - half;
+        entry.boxMax = pos + half;
+        entry.cell = scratchCell[i];
+        entry.index = i;
+    }
+    for (uint32_t b = bucketMask + 1; b > 0; --b) {
+        bucketStart[b] = bucketStart[b - 1];
+    }
+    bucketStart[0] = 0;
+}
+
+uint32_t SpatialHash::QueryCells(glm::vec3 boxMin, glm::vec3 boxMax, glm::vec3 center, float radiusSq, bool useRadius,
+                                 uint32_t* out, uint32_t maxResults) const {
+    if (entries.empty()) {
+        return 0;
+    }
+
+    // Entities are binned by center, so widen the cell range by the largest half extent
+    glm::ivec3 cellMin = glm::floor((boxMin - maxHalfExtent) * invCellSize);
+    glm::ivec3 cellMax = glm::floor((boxMax + maxHalfExtent) * invCellSize);
+
+    uint32_t found = 0;
+    for (int x = cellMin.x; x <= cellMax.x; ++x) {
+        for (int y = cellMin.y; y <= cellMax.y; ++y) {
+            for (int z = cellMin.z; z <= cellMax.z; ++z) {
+                const uint32_t bucket = HashCell(x, y, z) & bucketMask;
+                const glm::ivec3 cell(x, y, z);
+
+                for (uint32_t e = bucketStart[bucket]; e < bucketStart[bucket + 1]; ++e) {
+                    const Entry& entry = entries[e];
+
+                    // Skip entries from other cells that share this bucket (also prevents duplicates)
+                    if (entry.cell != cell) continue;
+
+                    const glm::vec3& eMin = entry.boxMin;
+                    const glm::vec3& eMax = entry.boxMax;
+                    bool hit;
+                    if (useRadius) {
+                        // Distance from the sphere center to the closest point of the AABB
+                        glm::vec3 closest = glm::clamp(center, eMin, eMax);
+                        glm::vec3 d = closest - center;
+                        hit = glm::dot(d, d) <= radiusSq;
+                    } else {
+                        hit = eMin.x <= boxMax.x && eMax.x >= boxMin.x &&
+                              eMin.y <= boxMax.y && eMax.y >= boxMin.y &&
+                              eMin.z <= boxMax.z && eMax.z >= boxMin.z;
+                    }
+
+                    if (hit) {
+                        if (found < maxResults) out[found] = entry.index;
+                        ++found;
+                    }
+                }
+            }
+        }
+    }
+    return found;
+}
+
+uint32_t SpatialHash::QueryAABB(glm::vec3 boxMin, glm::vec3 boxMax, uint32_t* out, uint32_t maxResults) const {
+    return QueryCells(boxMin, boxMax, glm::vec3(0.0f), 0.0f, false, out, maxResults);
+}
+
+uint32_t SpatialHash::QueryRadius(glm::vec3 center, float radius, uint32_t* out, uint32_t maxResults) const {
+    glm::vec3 r(radius);
+    return QueryCells(center - r, center + r, center, radius * radius, true, out, maxResults);
+}
@@ -0,0 +1,81 @@
+// src/TerrainGen.cpp
+
+#include "TerrainGen.h"
+
+#include <algorithm>
+#include <cmath>
+
+TerrainGenerator::TerrainGenerator(const TerrainSettings& settings)
+    : settings(settings),
+      heightNoise(settings.seed),
+      caveNoise(settings.seed ^ 0x5bd1e995u) // Independent lattice for the caves
+{}
+
+int TerrainGenerator::HeightFromNoise(float n) const {
+    int height = settings.baseHeight + (int)std::floor(n * settings.heightAmplitude);
+    return std::clamp(height, 1, CHUNK_HEIGHT - 2);
+}
+
+int TerrainGenerator::SurfaceHeight(int x, int z) const {
+    return HeightFromNoise(heightNoise.Fractal2D((float)x, (float)z, settings.heightNoise));
+}
+
+void TerrainGenerator::GenerateChunk(Chunk& chunk) const {
+    const int baseX = chunk.chunkX * CHUNK_SIZE;
+    const int baseZ = chunk.chunkZ * CHUNK_SIZE;
+
+    // --- 1. Height field: one noise row per X slice (rows run along Z) ---
+    int heights[CHUNK_SIZE][CHUNK_SIZE]; // [x][z]
+    int sliceMaxHeight[CHUNK_SIZE];
+    float row[CHUNK_SIZE];
+    for (int x = 0; x < CHUNK_SIZE; ++x) {
+        heightNoise.Fractal2DRow((float)(baseX + x), (float)baseZ, 1.0f, CHUNK_SIZE, settings.heightNoise, row);
+        sliceMaxHeight[x] = 0;
+        for (int z = 0; z < CHUNK_SIZE; ++z) {
+            heights[x][z] = HeightFromNoise(row[z]);
+            sliceMaxHeight[x] = std::max(sliceMaxHeight[x], heights[x][z]);
+        }
+    }
+
+    // --- 2. Layers: stone, dirt, grass (dirt under water), water up to sea level ---
+    std::fill(std::begin(chunk.fluidLevel), std::end(chunk.fluidLevel), (uint8_t)0);
+    for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            BlockID* column = &chunk.blocks[Chunk::Index(x, y, 0)];
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                const int height = heights[x][z];
+                BlockID id = 0;
+                if (y < height - settings.dirtDepth) {
+                    id = settings.stoneID;
+                } else if (y < height) {
+                    id = settings.dirtID;
+                } else if (y == height) {
+                    id = (height > settings.seaLevel) ? settings.grassID : settings.dirtID;
+                } else if (y <= settings.seaLevel) {
+                    id = settings.waterID;
+                }
+                column[z] = id;
+            }
+        }
+    }
+
+    // --- 3. Caves: carve where the 3D noise is high, only in slices that have ground ---
+    // y = 0 is never carved so nothing can fall out of the world.
+    for (int x = 0; x < CHUNK_SIZE; ++x) {
+        for (int y = 1; y <= sliceMaxHeight[x]; ++y) {
+            caveNoise.Fractal3DRow((float)(baseX + x), (float)y, (float)baseZ, 1.0f, CHUNK_SIZE, settings.caveNoise, row);
+            BlockID* column = &chunk.blocks[Chunk::Index(x, y, 0)];
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                const int height = heights[x][z];
+                if (y > height || row[z] <= settings.caveThreshold) {
+                    continue;
+                }
+                // Keep a roof under the sea so caves do not open into (static) water
+                if (height <= settings.seaLevel && y > height - 3) {
+                    continue;
+                }
+                column[z] = 0;
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+// src/VoxelCollision.cpp
+
+#include "VoxelCollision.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Tolerance used when converting box faces to cell indices, so a face lying exactly on a
+// block boundary does not count as overlapping the block on the other side.
+static const float SWEEP_EPSILON = 1e-4f;
+
+// Sweeps the box along a single axis. boxMin/boxMax are updated in place; returns the distance
+// actually travelled (equal to delta when nothing was hit).
+static float SweepAxis(const World& world, int axis, float delta, glm::vec3& boxMin, glm::vec3& boxMax, int& lookups, bool& hit) {
+    hit = false;
+    if (delta == 0.0f) {
+        return 0.0f;
+    }
+
+    // Cross-section of the box on the two other axes (shrunk by epsilon so touching faces don't count)
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+    const int uMin = (int)std::floor(boxMin[u] + SWEEP_EPSILON);
+    const int uMax = (int)std::floor(boxMax[u] - SWEEP_EPSILON);
+    const int vMin = (int)std::floor(boxMin[v] + SWEEP_EPSILON);
+    const int vMax = (int)std::floor(boxMax[v] - SWEEP_EPSILON);
+
+    // Range of cell slabs crossed by the leading face, nearest first.
+    // Slabs the box already overlaps are skipped.
+    int first, last, step;
+    if (delta > 0.0f) {
+        first = (int)std::floor(boxMax[axis] - SWEEP_EPSILON) + 1;
+        last  = (int)std::floor(boxMax[axis] + delta - SWEEP_EPSILON);
+        step  = 1;
+    } else {
+        first = (int)std::floor(boxMin[axis] + SWEEP_EPSILON) - 1;
+        last  = (int)std::floor(boxMin[axis] + delta + SWEEP_EPSILON);
+        step  = -1;
+    }
+
+    for (int c = first; (step > 0) ? (c <= last) : (c >= last); c += step) {
+        for (int a = uMin; a <= uMax; ++a) {
+            for (int b = vMin; b <= vMax; ++b) {
+                int cell[3];
+                cell[axis] = c;
+                cell[u] = a;
+                cell[v] = b;
+
+                ++lookups;
+                if (world.isOpaque(cell[0], cell[1], cell[2])) {
+                    // Stop flush against the slab we just reached
+                    float travelled = (step > 0) ? ((float)c - boxMax[axis]) : ((float)(c + 1) - boxMin[axis]);
+                    boxMin[axis] += travelled;
+                    boxMax[axis] += travelled;
+                    hit = true;
+                    return travelled;
+                }
+            }
+        }
+    }
+
+    boxMin[axis] += delta;
+    boxMax[axis] += delta;
+    return delta;
+}
+
+AABBSweepResult SweepAABB(const World& world, glm::vec3 center, glm::vec3 halfSize, glm::vec3 velocity, float dt) {
+    AABBSweepResult result;
+    result.velocity = velocity;
+
+    glm::vec3 delta = velocity * dt;
+    glm::vec3 boxMin = center - halfSize;
+    glm::vec3 boxMax = center + halfSize;
+
+    // Y first so a body landing on the ground is settled before it slides along it
+    static const int AXIS_ORDER[3] = {1, 0, 2};
+
+    for (int i = 0; i < 3; ++i) {
+        const int axis = AXIS_ORDER[i];
+        const float requested = std::clamp(delta[axis], -MAX_SWEEP_DISTANCE, MAX_SWEEP_DISTANCE);
+
+        bool hit = false;
+        float travelled = SweepAxis(world, axis, requested, boxMin, boxMax, result.cellLookups, hit);
+
+        if (hit) {
+            result.normal[axis] = (requested > 0.0f) ? -1 : 1;
+            result.velocity[axis] = 0.0f;
+            // A fraction of the whole step, not of the clamped sweep
+            result.timeOfImpact = std::min(result.timeOfImpact, travelled / delta[axis]);
+        }
+    }
+
+    result.position = (boxMin + boxMax) * 0.5f;
+    return result;
+}
@@ -0,0 +1,107 @@
+// src/Water.cpp
+
+#include "Water.h"
+
+#include <algorithm>
+
+// Horizontal neighbour offsets (+X, -X, +Z, -Z)
+static const glm::ivec3 HORIZONTAL[4] = {
+    glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0), glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1)
+};
+static const glm::ivec3 UP(0, 1, 0);
+
+void WaterSimulation::OnBlockChanged(const World& world, int x, int y, int z, uint64_t currentTick) {
+    glm::ivec3 p(x, y, z);
+    if (world.isFluidID(world.getBlock(x, y, z))) {
+        scheduler.Schedule(x, y, z, currentTick + WATER_TICK_DELAY);
+    }
+    WakeFluidNeighbours(world, p, currentTick);
+}
+
+size_t WaterSimulation::Update(World& world, uint64_t currentTick) {
+    scheduler.CollectDue(currentTick, WATER_UPDATE_BUDGET, dueCells);
+    for (const glm::ivec3& p : dueCells) {
+        UpdateCell(world, p, currentTick);
+    }
+    totalCellsUpdated += dueCells.size();
+    return dueCells.size();
+}
+
+void WaterSimulation::WakeFluidNeighbours(const World& world, glm::ivec3 p, uint64_t currentTick) {
+    const glm::ivec3 neighbours[6] = { p + UP, p - UP, p + HORIZONTAL[0], p + HORIZONTAL[1], p + HORIZONTAL[2], p + HORIZONTAL[3] };
+    for (const glm::ivec3& n : neighbours) {
+        if (world.isFluidID(world.getBlock(n.x, n.y, n.z))) {
+            scheduler.Schedule(n.x, n.y, n.z, currentTick + WATER_TICK_DELAY);
+        }
+    }
+}
+
+void WaterSimulation::PlaceFluid(World& world, glm::ivec3 p, BlockID id, uint8_t level, uint64_t currentTick) {
+    world.setBlock(p.x, p.y, p.z, id); // Marks the chunk dirty
+    world.setFluidLevel(p.x, p.y, p.z, level);
+    scheduler.Schedule(p.x, p.y, p.z, currentTick + WATER_TICK_DELAY);
+}
+
+void WaterSimulation::UpdateCell(World& world, glm::ivec3 p, uint64_t currentTick) {
+    const BlockID id = world.getBlock(p.x, p.y, p.z);
+    if (!world.isFluidID(id)) {
+        return; // Replaced since it was scheduled
+    }
+
+    int level = world.getFluidLevel(p.x, p.y, p.z);
+
+    // --- 1. Flowing cells re-derive their level from whatever feeds them ---
+    if (level > 0) {
+        int fedLevel = WATER_MAX_LEVEL + 1; // "not fed"
+
+        glm::ivec3 above = p + UP;
+        if (world.getBlock(above.x, above.y, above.z) == id) {
+            fedLevel = 1; // Falling water
+        } else {
+            for (const glm::ivec3& offset : HORIZONTAL) {
+                glm::ivec3 n = p + offset;
+                if (world.getBlock(n.x, n.y, n.z) == id) {
+                    fedLevel = std::min(fedLevel, (int)world.getFluidLevel(n.x, n.y, n.z) + 1);
+                }
+            }
+        }
+
+        if (fedLevel > WATER_MAX_LEVEL) {
+            // Source removed: dry up and let the neighbours re-evaluate
+            world.setBlock(p.x, p.y, p.z, 0);
+            WakeFluidNeighbours(world, p, currentTick);
+            return;
+        }
+        if (fedLevel != level) {
+            level = fedLevel;
+            world.setFluidLevel(p.x, p.y, p.z, (uint8_t)level);
+            WakeFluidNeighbours(world, p, currentTick);
+        }
+    }
+
+    // --- 2. Fall into air below ---
+    glm::ivec3 below = p - UP;
+    BlockID belowID = world.getBlock(below.x, below.y, below.z);
+    if (below.y >= 0 && belowID == 0) {
+        PlaceFluid(world, below, id, 1, currentTick);
+        return;
+    }
+
+    // --- 3. Resting on something solid: spread sideways ---
+    if (world.isFluidID(belowID) || level >= WATER_MAX_LEVEL) {
+        return;
+    }
+    for (const glm::ivec3& offset : HORIZONTAL) {
+        glm::ivec3 n = p + offset;
+        BlockID neighbourID = world.getBlock(n.x, n.y, n.z);
+        if (neighbourID == 0) {
+            // Only spread into loaded terrain
+            if (world.IsChunkLoaded(World::ToChunkCoord(n.x), World::ToChunkCoord(n.z))) {
+                PlaceFluid(world, n, id, (uint8_t)(level + 1), currentTick);
+            }
+        } else if (neighbourID == id && world.getFluidLevel(n.x, n.y, n.z) > level + 1) {
+            // A weaker neighbour can be topped up from here
+            scheduler.Schedule(n.x, n.y, n.z, currentTick + WATER_TICK_DELAY);
+        }
+    }
+}
@@ -0,0 +1,273 @@
+// src/World.cpp
+
+#include "World.h"
+#include "MappedWorld.h"
+#include "BrickMap.h"
+
+World::World() {}
+
+World::~World() {}
+
+BlockID World::getBlock(int x, int y, int z) const {
+    if (y < 0 || y >= CHUNK_HEIGHT) {
+        return 0;
+    }
+
+    const Chunk* chunk = GetChunk(ToChunkCoord(x), ToChunkCoord(z));
+    if (!chunk) {
+        const BrickChunk* brickChunk = GetCompactChunk(ToChunkCoord(x), ToChunkCoord(z));
+        return brickChunk ? brickChunk->GetBlock(ToLocalCoord(x), y, ToLocalCoord(z))
+                          : 0; // Unloaded terrain is treated as air
+    }
+    return chunk->blocks[Chunk::Index(ToLocalCoord(x), y, ToLocalCoord(z))];
+}
+
+void World::setBlock(int x, int y, int z, BlockID id) {
+    if (y < 0 || y >= CHUNK_HEIGHT) {
+        return;
+    }
+
+    const int chunkX = ToChunkCoord(x);
+    const int chunkZ = ToChunkCoord(z);
+    Chunk* chunk = GetChunk(chunkX, chunkZ);
+    if (!chunk && !(chunk = ExpandChunk(chunkX, chunkZ))) {
+        return; // Edits into unloaded terrain are dropped
+    }
+
+    const int localX = ToLocalCoord(x);
+    const int localZ = ToLocalCoord(z);
+    const int index = Chunk::Index(localX, y, localZ);
+    if (chunk->blocks[index] == id) {
+        return;
+    }
+    chunk->blocks[index] = id;
+    chunk->fluidLevel[index] = 0;
+    ++chunk->version;
+
+    // Face culling looks one block past the chunk edge, so border edits dirty the neighbour too
+    MarkChunkDirty(chunkX, chunkZ);
+    if (localX == 0)              MarkChunkDirty(chunkX - 1, chunkZ);
+    if (localX == CHUNK_SIZE - 1) MarkChunkDirty(chunkX + 1, chunkZ);
+    if (localZ == 0)              MarkChunkDirty(chunkX, chunkZ - 1);
+    if (localZ == CHUNK_SIZE - 1) MarkChunkDirty(chunkX, chunkZ + 1);
+}
+
+uint8_t World::getFluidLevel(int x, int y, int z) const {
+    if (y < 0 || y >= CHUNK_HEIGHT) {
+        return 0;
+    }
+
+    const Chunk* chunk = GetChunk(ToChunkCoord(x), ToChunkCoord(z));
+    if (!chunk) {
+        const BrickChunk* brickChunk = GetCompactChunk(ToChunkCoord(x), ToChunkCoord(z));
+        return brickChunk ? brickChunk->GetFluidLevel(ToLocalCoord(x), y, ToLocalCoord(z)) : 0;
+    }
+    return chunk->fluidLevel[Chunk::Index(ToLocalCoord(x), y, ToLocalCoord(z))];
+}
+
+void World::setFluidLevel(int x, int y, int z, uint8_t level) {
+    if (y < 0 || y >= CHUNK_HEIGHT) {
+        return;
+    }
+
+    Chunk* chunk = GetChunk(ToChunkCoord(x), ToChunkCoord(z));
+    if (!chunk) {
+        chunk = ExpandChunk(ToChunkCoord(x), ToChunkCoord(z));
+    }
+    if (chunk) {
+        chunk->fluidLevel[Chunk::Index(ToLocalCoord(x), y, ToLocalCoord(z))] = level;
+        ++chunk->version;
+    }
+}
+
+void World::setFlag(BlockID id, uint8_t flag, bool enabled) {
+    if (id >= blockFlags.size()) {
+        blockFlags.resize((size_t)id + 1, 0);
+    }
+    if (enabled) {
+        blockFlags[id] |= flag;
+    } else {
+        blockFlags[id] &= (uint8_t)~flag;
+    }
+}
+
+void World::SetBlockOpacity(BlockID id, bool opaque) {
+    setFlag(id, BLOCK_OPAQUE, opaque);
+}
+
+void World::SetBlockFluid(BlockID id, bool fluid) {
+    setFlag(id, BLOCK_FLUID, fluid);
+}
+
+void World::SetBlockTextureIndex(BlockID id, unsigned int textureIndex) {
+    if (id >= textureLUT.size()) {
+        textureLUT.resize((size_t)id + 1, 0);
+    }
+    textureLUT[id] = (uint16_t)textureIndex;
+}
+
+Chunk* World::GetChunk(int chunkX, int chunkZ) {
+    auto it = chunks.find(ChunkKey(chunkX, chunkZ));
+    return (it != chunks.end()) ? it->second.get() : nullptr;
+}
+
+const Chunk* World::GetChunk(int chunkX, int chunkZ) const {
+    if (mapped) {
+        return mapped->GetChunk(chunkX, chunkZ); // Index lookup into the mapping, no hashing
+    }
+    auto it = chunks.find(ChunkKey(chunkX, chunkZ));
+    return (it != chunks.end()) ? it->second.get() : nullptr;
+}
+
+Chunk* World::CreateChunk(int chunkX, int chunkZ) {
+    if (Chunk* expanded = ExpandChunk(chunkX, chunkZ)) {
+        return expanded;
+    }
+    std::unique_ptr<Chunk>& slot = chunks[ChunkKey(chunkX, chunkZ)];
+    if (!slot) {
+        slot = std::make_unique<Chunk>();
+        slot->chunkX = chunkX;
+        slot->chunkZ = chunkZ;
+
+        // Neighbours were drawing their border faces against air; they need a remesh too
+        MarkChunkDirty(chunkX, chunkZ);
+        MarkChunkDirty(chunkX - 1, chunkZ);
+        MarkChunkDirty(chunkX + 1, chunkZ);
+        MarkChunkDirty(chunkX, chunkZ - 1);
+        MarkChunkDirty(chunkX, chunkZ + 1);
+    }
+    return slot.get();
+}
+
+Chunk* World::InsertChunk(std::unique_ptr<Chunk> chunk) {
+    const int chunkX = chunk->chunkX;
+    const int chunkZ = chunk->chunkZ;
+    std::unique_ptr<Chunk>& slot = chunks[ChunkKey(chunkX, chunkZ)];
+    slot = std::move(chunk);
+    DropCompactChunk(ChunkKey(chunkX, chunkZ));
+
+    MarkChunkDirty(chunkX, chunkZ);
+    MarkChunkDirty(chunkX - 1, chunkZ);
+    MarkChunkDirty(chunkX + 1, chunkZ);
+    MarkChunkDirty(chunkX, chunkZ - 1);
+    MarkChunkDirty(chunkX, chunkZ + 1);
+    return slot.get();
+}
+
+bool World::RemoveChunk(int chunkX, int chunkZ) {
+    const int64_t key = ChunkKey(chunkX, chunkZ);
+    if (chunks.erase(key) == 0 && !DropCompactChunk(key)) {
+        return false;
+    }
+    dirtyChunks.erase(key);
+
+    // Neighbours now border air and must draw the faces they were culling against this chunk
+    MarkChunkDirty(chunkX - 1, chunkZ);
+    MarkChunkDirty(chunkX + 1, chunkZ);
+    MarkChunkDirty(chunkX, chunkZ - 1);
+    MarkChunkDirty(chunkX, chunkZ + 1);
+    return true;
+}
+
+void World::AttachMappedWorld(const MappedWorld* mappedWorld) {
+    mapped = mappedWorld;
+}
+
+bool World::IsChunkLoaded(int chunkX, int chunkZ) const {
+    return GetChunk(chunkX, chunkZ) != nullptr || IsCompact(chunkX, chunkZ);
+}
+
+size_t World::ChunkCount() const {
+    return mapped ? mapped->ChunkCount() : chunks.size() + compact.size();
+}
+
+void World::GetChunkKeys(std::vector<int64_t>& out) const {
+    if (mapped) {
+        mapped->GetChunkKeys(out);
+        return;
+    }
+    out.clear();
+    out.reserve(chunks.size() + compact.size());
+    for (const auto& pair : chunks) {
+        out.push_back(pair.first);
+    }
+    for (const auto& pair : compact) {
+        out.push_back(pair.first);
+    }
+}
+
+const Chunk* World::ReadChunk(int chunkX, int chunkZ, Chunk& scratch) const {
+    if (const Chunk* chunk = GetChunk(chunkX, chunkZ)) {
+        return chunk;
+    }
+    const BrickChunk* brickChunk = GetCompactChunk(chunkX, chunkZ);
+    if (!brickChunk) {
+        return nullptr;
+    }
+    brickChunk->ToChunk(scratch);
+    return &scratch;
+}
+
+const BrickChunk* World::GetCompactChunk(int chunkX, int chunkZ) const {
+    if (compact.empty()) {
+        return nullptr; // Nothing compacted: no second hash lookup for unloaded terrain
+    }
+    auto it = compact.find(ChunkKey(chunkX, chunkZ));
+    return (it != compact.end()) ? it->second.get() : nullptr;
+}
+
+bool World::DropCompactChunk(int64_t key) {
+    auto it = compact.find(key);
+    if (it == compact.end()) {
+        return false;
+    }
+    compactBytes -= it->second->MemoryBytes();
+    compact.erase(it);
+    return true;
+}
+
+bool World::CompactChunk(int chunkX, int chunkZ) {
+    auto it = chunks.find(ChunkKey(chunkX, chunkZ));
+    if (it == chunks.end() || it->second->IsModified()) {
+        return false;
+    }
+    std::unique_ptr<BrickChunk> brickChunk = std::make_unique<BrickChunk>();
+    brickChunk->FromChunk(*it->second);
+    compactBytes += brickChunk->MemoryBytes();
+    compact[it->first] = std::move(brickChunk);
+    chunks.erase(it); // Same blocks, so no remesh needed
+    return true;
+}
+
+Chunk* World::ExpandChunk(int chunkX, int chunkZ) {
+    if (Chunk* chunk = GetChunk(chunkX, chunkZ)) {
+        return chunk;
+    }
+    const int64_t key = ChunkKey(chunkX, chunkZ);
+    auto it = compact.find(key);
+    if (it == compact.end()) {
+        return nullptr;
+    }
+    std::unique_ptr<Chunk> chunk = std::make_unique<Chunk>();
+    it->second->ToChunk(*chunk);
+    DropCompactChunk(key);
+    Chunk* result = chunk.get();
+    chunks[key] = std::move(chunk);
+    return result;
+}
+
+size_t World::ChunkMemoryBytes() const {
+    return chunks.size() * sizeof(Chunk) + compactBytes;
+}
+
+void World::MarkChunkDirty(int chunkX, int chunkZ) {
+    // Only loaded chunks have a mesh to rebuild
+    if (IsChunkLoaded(chunkX, chunkZ)) {
+        dirtyChunks.insert(ChunkKey(chunkX, chunkZ));
+    }
+}
+
+void World::TakeDirtyChunks(std::vector<int64_t>& out) {
+    out.assign(dirtyChunks.begin(), dirtyChunks.end());
+    dirtyChunks.clear();
+}
@@ -5,6 +5,21 @@
 #include <glm/gtc/matrix_transform.hpp> // Needed for perspective and lookAt functions
 #include <glm/gtc/type_ptr.hpp>         // Needed for glm::value_ptr
 #include <vector>
+#include <string>
+#include <mutex>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
 
 // --- STB IMAGE SETUP ---
 // Define this implementation flag in ONE source file (main.cpp)
@@ -23,6 +38,27 @@ using json = nlohmann::json;
 
 #include "../include/Camera.h" 
 #include "../include/Shader.h" 
+#include "../include/FixedTimestep.h"
+#include "../include/World.h"
+#include "../include/VoxelCollision.h"
+#include "../include/Entities.h"
+#include "../include/SpatialHash.h"
+#include "../include/Mesher.h"
+#include "../include/Water.h"
+#include "../include/TerrainGen.h"
+#include "../include/ChunkStreamer.h"
+#include "../include/RegionFile.h"
+#include "../include/AutoSave.h"
+#include "../include/EditJournal.h"
+#include "../include/MappedWorld.h"
+#include "../include/MeshCache.h"
+#include "../include/OcclusionCuller.h"
+#include "../include/CaveCulling.h"
+#include "../include/RenderPacket.h"
+#include "../include/JobSystem.h"
+#include "../include/Headless.h"
+#include "../include/InputLog.h"
+#include "../include/Checksum.h"
 
 // --- NEW: Block Data Structures ---
 struct BlockDefinition {
@@ -30,6 +66,7 @@ struct BlockDefinition {
     std::string name = "Air";
     std::string texturePath = "";
     bool isOpaque = false;
+    bool isFluid = false; // Optional "is_fluid" key: the block flows (see Water.h)
     // New: Texture index for the shader (index into the Texture Array)
     unsigned int textureIndex = 0; 
 };
@@ -56,13 +93,55 @@ float deltaTime = 0.0f;
 float lastFrame = 0.0f; 
 
 // --- NEW: Player Entity Physics ---
-glm::vec3 playerPos = glm::vec3(8.0f, 15.0f, 8.0f); // Start position (above the world)
-glm::vec3 playerVelocity = glm::vec3(0.0f);
-glm::vec3 PLAYER_SIZE = glm::vec3(0.6f, 1.8f, 0.6f); // Player's AABB Hitbox (Width, Height, Depth)
-const float GRAVITY = -25.0f; // Gravity force (units/sec^2)
+// The player is entity 0 in the entity store; gravity, collision and friction are shared
+// with every other body (see Entities.h).
+const glm::vec2 PLAYER_SPAWN_XZ = glm::vec2(8.0f, 8.0f); // Start column; the height is taken from the terrain
+const glm::vec3 PLAYER_SIZE_STANDING = glm::vec3(0.6f, 1.8f, 0.6f); // Player's AABB Hitbox (Width, Height, Depth)
+const glm::vec3 PLAYER_SIZE_SNEAKING = glm::vec3(0.6f, 1.5f, 0.6f);
 const float JUMP_VELOCITY = 10.0f;
 float PLAYER_SPEED = 3.5f; // Horizontal movement speed
-bool isGrounded = false;
+
+EntityStore entities;
+uint32_t playerEntity = 0;
+int physicsThreads = 1; // Worker threads for the entity collision pass (--physics-threads N)
+
+// --- NEW: Dropped Items ---
+// Broken blocks drop a small item entity; the player collects items that come within PICKUP_RADIUS.
+const glm::vec3 ITEM_SIZE = glm::vec3(0.25f);
+const float PICKUP_RADIUS = 1.5f;
+SpatialHash entityGrid;            // Rebuilt every tick for neighbour queries
+uint32_t nearbyEntities[64];       // Query result buffer (no allocation per query)
+// ------------------------------------------
+
+// --- NEW: Fixed-Timestep Simulation ---
+// Keyboard state sampled once per rendered frame on the main thread (GLFW input is main-thread only),
+// turned into a PlayerInput by the packet builder (see ApplyInputEvent) and consumed by the next
+// simulation tick.
+struct PlayerInput {
+    glm::vec3 forward = glm::vec3(0.0f, 0.0f, -1.0f); // Horizontal camera forward at sample time
+    glm::vec3 right = glm::vec3(1.0f, 0.0f, 0.0f);    // Horizontal camera right at sample time
+    bool moveForward = false;
+    bool moveBack = false;
+    bool moveLeft = false;
+    bool moveRight = false;
+    bool sneak = false;
+    bool sprint = false;
+    bool jump = false;
+};
+
+PlayerInput latestInput;
+std::mutex inputMutex; // Guards latestInput when the simulation runs on its own thread
+InputQueue inputQueue; // Window callbacks -> packet builder
+std::mutex worldMutex; // Guards the world and entities (edits, meshing, simulation ticks) across threads
+
+bool useSimThread = false;   // --sim-thread: tick physics on a SimulationThread instead of the render loop
+FixedTimestep simClock;      // Accumulator for the single-threaded mode
+SimStateBuffer simStates;    // Last two published ticks, read by the renderer for interpolation
+SimulationThread simThread;
+uint64_t simTickCount = 0;   // Ticks simulated so far (either mode, guarded by worldMutex)
+uint64_t simChecksum = CHECKSUM_BASIS; // Entity state after every tick so far, chained (see ChecksumSimulation)
+int jobThreads = JobSystem::DefaultWorkerCount(); // --job-threads N (0 runs jobs deterministically on the waiting thread)
+std::unique_ptr<JobSystem> jobSystem; // Created by main(), so the main thread runs the MainThread (GL) jobs
 // ------------------------------------------
 
 // --- NEW: Raycast Offset Constant ---
@@ -77,108 +156,131 @@ bool firstMouse = true;
 // ------------------------------------------
 
 // --- VOXEL WORLD CONSTANTS ---
-const int WORLD_SIZE_X = 20;
-const int WORLD_SIZE_Y = 16; // A thin slice of ground
-const int WORLD_SIZE_Z = 20;
+// The world is unbounded horizontally: chunks stream in and out around the camera (see ChunkStreamer.h)
+const int WORLD_SIZE_Y = CHUNK_HEIGHT;
+uint32_t terrainSeed = 1337;                 // --seed N
+int viewDistance = DEFAULT_VIEW_DISTANCE;    // --view-distance N (chunks)
+int streamThreads = 2;                       // --stream-threads N
+int compactDistance = DEFAULT_COMPACT_DISTANCE; // --compact-distance N (chunks; 0 keeps every chunk dense)
+int lodDistance = DEFAULT_LOD_DISTANCE;      // --lod-distance N (chunks at full resolution; 0 = no LOD)
+bool occlusionCulling = true;                // --no-occlusion-culling draws every chunk in the frustum
+bool caveCulling = true;                     // --no-cave-culling skips the section visibility search
+bool vertexPulling = false;                  // --vertex-pulling draws chunks from face records in storage buffers
+std::string worldDirectory = "world";        // --world DIR (region files of edited chunks)
+JournalSync journalSync = JournalSync::Batch; // --journal-sync none|batch|edit
+std::string mapPath;                         // --map FILE (read-only baked map instead of streamed terrain)
+std::string bakeMapPath;                     // --bake-map FILE (write a baked map and exit)
+int bakeRadius = 16;                         // --bake-radius N (chunks around the spawn column)
+bool headless = false;                       // --headless: fly a scripted camera path offscreen and report frame times
+int headlessFrames = 600;                    // --headless-frames N (measured frames: one lap of the path)
+std::string headlessImagePath;               // --headless-image FILE (the last frame as a PPM)
+std::string recordPath;                      // --record FILE (input log of this session)
+std::string replayPath;                      // --replay FILE (play an input log back at one tick per frame)
+std::string frameTimesPath;                  // --frame-times FILE (CSV: one line per frame)
+const int MAX_REMESHES_PER_FRAME = 8;        // Nearest dirty chunks first; the rest wait a frame
+const int MAX_CACHED_MESHES_PER_FRAME = 32;  // Mesh cache lookups per frame (a hit is ~10x cheaper than meshing)
 // -----------------------------
 
-// A simple 3D array to represent the world. 
-// 1 = Block exists, 0 = Air.
-int world[WORLD_SIZE_X][WORLD_SIZE_Y][WORLD_SIZE_Z];
+// The voxel world, stored as chunk columns (see World.h).
+// The play area above is covered by chunks at startup. 0 = Air.
+World world;
+// Every block edit is logged here between autosaves (see EditJournal.h)
+EditJournal editJournal;
+// With --map, the world reads its chunks straight from this mapping (see MappedWorld.h)
+MappedWorld mappedWorld;
+std::unordered_set<int64_t> mappedInView; // Mapped chunks within the view distance (meshed or waiting to be)
+glm::ivec2 mappedViewChunk(INT32_MIN);
 
 // --- MESH GENERATION DATA ---
-// --- NEW GLOBAL VARIABLES FOR MESHING ---
-unsigned int VBO_Global; // VBO ID
-int totalVertices_Global = 0; // Total vertices to draw
-// --- NEW GLOBAL FOR DRAW ORDER ---
-int opaqueVertexCount = 0; // Number of vertices in the opaque part of the VBO
+// One VAO/VBO per chunk column. Only chunks reported dirty by the world are rebuilt.
+// Translucent faces get their own VAO/VBO plus an index buffer holding their back-to-front order.
+//
+// A frame is prepared (streaming, meshing, sorting, culling) into a RenderPacket, which the
+// render loop then draws (see RenderPacket.h). With --game-thread the packets are built on a
+// game thread, one frame ahead of the render thread. The GPU side of a chunk lives on the render
+// thread (ChunkRenderData), the CPU side on the thread building the packets (ChunkFrameState).
+struct ChunkRenderData {
+    unsigned int VAO = 0;
+    unsigned int VBO = 0;
+    int opaqueVertexCount = 0; // Vertices in the opaque VBO
+    glm::vec3 boundsMin = glm::vec3(0.0f); // Box around every vertex (opaque and translucent)
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    ChunkVisibility visibility = ChunkVisibility::Culled; // This frame's (see OcclusionCuller)
+    int sectionVertexStart[SECTIONS + 1] = {}; // Opaque vertex range of each section (see ChunkMesh)
+    uint8_t visibleSections = 0;               // This frame's (see CaveCuller)
+
+    unsigned int translucentVAO = 0;
+    unsigned int translucentVBO = 0;
+    unsigned int translucentEBO = 0;
+    int translucentIndexCount = 0;
+    size_t bufferBytes = 0; // Vertex / face record data uploaded for this chunk
+};
+std::unordered_map<int64_t, ChunkRenderData> chunkMeshes; // Render thread
+std::vector<uint32_t> faceRecordScratch; // Face records being uploaded (vertex pulling)
+size_t chunkBufferBytes = 0;         // bufferBytes of every chunk
+
+struct ChunkFrameState {
+    int lod = 0;            // Level of detail the mesh was built at (see ChunkLod)
+    bool hasFaces = false;
+    bool hasTranslucent = false;
+    TranslucentOrder translucentOrder;
+};
+std::unordered_map<int64_t, ChunkFrameState> chunkStates; // Packet builder
+std::vector<int64_t> dirtyChunkKeys; // Reused between frames
+// Meshes of unchanged chunks are loaded from here instead of being rebuilt (see MeshCache.h)
+MeshCache meshCache;
+// Camera chunk the chunk LODs were last chosen for
+glm::ivec2 lodCameraChunk(INT32_MIN);
+// Frustum + occlusion query culling of the chunk meshes (render thread)
+OcclusionCuller occlusion;
+// Section visibility search from the camera: skips sections hidden behind rock (see CaveCulling.h)
+CaveCuller caveCuller;
+
+// Translucent faces are re-sorted only when the camera enters a new block (or a chunk is remeshed)
+glm::vec3 translucentSortPos(0.0f);
+glm::ivec3 translucentSortCell(INT32_MIN);
+bool translucentOrderStale = true;
+std::vector<int64_t> translucentChunkOrder; // Chunks with translucent faces, farthest first
+
+// --headless: the camera circles the spawn column above the terrain, looking along the circle and
+// down a little, so the view sweeps every direction and crosses chunk borders (LOD remeshes).
+// Scripted time advances a fixed step per frame; nothing depends on the wall clock.
+const float HEADLESS_PATH_RADIUS = 24.0f;      // Blocks
+const float HEADLESS_PATH_HEIGHT = 12.0f;      // Blocks above the spawn column
+const float HEADLESS_PATH_PITCH = -15.0f;      // Degrees
+const double HEADLESS_FRAME_DT = 1.0 / 60.0;   // Scripted seconds per frame
+const int HEADLESS_MAX_WARMUP_FRAMES = 5000;   // Frames to wait for the view to be meshed
+int benchmarkFrames = 0;                       // Measured frames built so far (packet builder)
+
+// --record / --replay: input is applied between ticks, so a log plays back tick for tick. Both run
+// the simulation inline and on a world freshly generated from the seed (saved edits would change
+// it), so a replay with the same build reproduces the simulation bit for bit.
+InputRecorder inputRecorder;
+InputReplay inputReplay;
+bool replaying = false;
+
+// Draw calls and vertices submitted this frame (render thread, reported by --headless and --replay)
+struct DrawCounters {
+    size_t drawCalls = 0;
+    size_t vertices = 0;
+};
+DrawCounters frameDraws;
+
+bool useGameThread = false;       // --game-thread: build the render packets on their own thread
+RenderPacketQueue renderPackets;  // Game thread -> render thread
+// The camera belongs to the packet builder: mouse input reaches it through inputQueue
+// ----------------------------------------
+
+// --- NEW: Water Simulation ---
+WaterSimulation water;
 // ----------------------------------------
 
 // --- NEW GLOBAL: Currently selected block ID for placement ---
 unsigned int currentPlacementBlockID = 4; // Default to Block ID 4 (Dirt, based on your main() init)
+int cID = 1; // Stepped by N / M
 // -----------------------------------------------------------
 
 
-// 8 floats per vertex: (X, Y, Z), (Nx, Ny, Nz), (U, V)
-// Each face is 6 vertices (2 triangles)
-// The standard unit cube is positioned at (0, 0, 0)
-// This structure is designed to be easily translated later.
-static const float FACE_VERTICES[6 * 48] = {
-    // --- TOP FACE (+Y) ---
-    // Normals: 0.0f, 1.0f, 0.0f
-    -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f, // Top-left
-     0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f, // Top-right
-     0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f, // Bottom-right
-
-     0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f, // Bottom-right
-    -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f, // Bottom-left
-    -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f, // Top-left
-
-    // --- BOTTOM FACE (-Y) ---
-    // Normals: 0.0f, -1.0f, 0.0f
-    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-     0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
-     
-    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-    -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
-     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-
-    // --- FRONT FACE (+Z) ---
-    // Normals: 0.0f, 0.0f, 1.0f
-    -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-     0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
-     0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
-
-     0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
-    -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
-    -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-
-    // --- BACK FACE (-Z) ---
-    // Normals: 0.0f, 0.0f, -1.0f
-    -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-     0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-     0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
-
-    -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-    -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
-     0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-
-    // --- LEFT FACE (-X) ---
-    // Normals: -1.0f, 0.0f, 0.0f
-    // Vertices run: Top-Front, Top-Back, Bottom-Back (Triangle 1)
-    -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f, // (U=1.0, V=1.0) Top-Front (+Z)
-    -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f, // (U=0.0, V=1.0) Top-Back (-Z)
-    -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f, // (U=0.0, V=0.0) Bottom-Back (-Z)
-
-    // Vertices run: Bottom-Back, Bottom-Front, Top-Front (Triangle 2)
-    -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f, // (U=0.0, V=0.0) Bottom-Back (-Z)
-    -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f, // (U=1.0, V=0.0) Bottom-Front (+Z)
-    -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f, // (U=1.0, V=1.0) Top-Front (+Z)
-
-    // --- RIGHT FACE (+X) ---
-    // Normals: 1.0f, 0.0f, 0.0f
-    // Vertices run: Top-Front, Bottom-Back, Top-Back (Triangle 1)
-     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f, // (U=0.0, V=1.0) Top-Front (+Z)
-     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f, // (U=1.0, V=0.0) Bottom-Back (-Z)
-     0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f, // (U=1.0, V=1.0) Top-Back (-Z)
-
-    // Vertices run: Top-Front, Bottom-Front, Bottom-Back (Triangle 2)
-     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f, // (U=0.0, V=1.0) Top-Front (+Z)
-     0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f, // (U=0.0, V=0.0) Bottom-Front (+Z)
-     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f  // (U=1.0, V=0.0) Bottom-Back (-Z)
-};
-
-// Offsets for checking neighbors (Top, Bottom, Front, Back, Left, Right)
-static const int FACE_OFFSETS[6][3] = {
-    {0, 1, 0},   // +Y (Top)
-    {0, -1, 0},  // -Y (Bottom)
-    {0, 0, 1},   // +Z (Front)
-    {0, 0, -1},  // -Z (Back)
-    {-1, 0, 0},  // -X (Left)
-    {1, 0, 0}    // +X (Right)
-};
-
 // --- Light Source Position ---
 // Adjust light position to be visible over the line of blocks
 //glm::vec3 lightPos(5.0f, 3.0f, 4.0f); // Position the light source over the middle of the line
@@ -196,12 +298,11 @@ const float CROSSHAIR_VERTICES[] = {
 
 // --- NEW: Dynamic Light Parameters (Sun/Moon Cycle) ---
 // Radius of the light's orbit around the center of the world
-const float LIGHT_ORBIT_RADIUS = 30.0f; 
+const float LIGHT_ORBIT_RADIUS = 120.0f; 
 // Time in seconds for one full 360-degree cycle (5 minutes = 300 seconds)
 const float LIGHT_CYCLE_DURATION = 300.0f; 
-// Center of the world (adjust based on your world size)
-// The center of the 16x16x16 world is at (8, 8, 8)
-const glm::vec3 WORLD_CENTER(WORLD_SIZE_X / 2.0f, WORLD_SIZE_Y / 2.0f, WORLD_SIZE_Z / 2.0f); 
+// Height of the orbit's center. Horizontally the sun follows the camera, so it stays in view as the world streams.
+const float SUN_ORBIT_HEIGHT = WORLD_SIZE_Y / 2.0f;
 // ------------------------------------------------------
 
 bool LoadBlockDefinitions(const std::string& path) {
@@ -222,7 +323,7 @@ bool LoadBlockDefinitions(const std::string& path) {
     unsigned int currentTextureIndex = 0;
     
     // The "Air" block (ID 0) is implicitly defined and must be handled
-    blockDefs[0] = {0, "Air", "", false, 0}; 
+    blockDefs[0] = {0, "Air", "", false, false, 0}; 
 
     for (const auto& block : data["blocks"]) {
         BlockDefinition def;
@@ -235,7 +336,12 @@ bool LoadBlockDefinitions(const std::string& path) {
         // This will be used to sample the correct layer in the Texture Array
         def.textureIndex = currentTextureIndex++; 
         
+        def.isFluid = block.value("is_fluid", false);
+        
         blockDefs[def.id] = def;
+        world.SetBlockOpacity((BlockID)def.id, def.isOpaque);
+        world.SetBlockFluid((BlockID)def.id, def.isFluid);
+        world.SetBlockTextureIndex((BlockID)def.id, def.textureIndex);
         std::cout << "Loaded Block: ID " << def.id << ", Name: " << def.name << std::endl;
     }
     
@@ -324,133 +430,403 @@ glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     return true;
 }
 
-// The number of floats per vertex (Position, Normal, TexCoords, BlockID)
-const int VERTEX_ATTRIBUTES = 10; // NEW: Pos(3), Normal(3), TexCoord(2), BlockID(1), TexIndex(1)
+// Tell OpenGL how to interpret the chunk vertex data (call with the chunk's VAO and VBO bound)
+void SetupChunkVertexAttributes() {
+    // Total size of one vertex is 10 floats (Position + Normal + TexCoords + BlockID + TexIndex)
+    GLsizei stride = VERTEX_ATTRIBUTES * sizeof(float); // 10 * sizeof(float)
+
+    // 1. Position attribute (location 0): 3 floats
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glEnableVertexAttribArray(0);
 
-// Function to check if a block exists at world coordinates (x, y, z)
-bool isBlock(int x, int y, int z) {
-    if (x < 0 || x >= WORLD_SIZE_X || 
-        y < 0 || y >= WORLD_SIZE_Y || 
-        z < 0 || z >= WORLD_SIZE_Z) 
-    {
-        return 0; // Out of bounds is treated as air
+    // 2. Normal attribute (location 1): 3 floats
+    // Offset is 3 floats
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    // 3. Texture Coordinate attribute (location 2): 2 floats
+    // Offset is 6 floats
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+
+    // 4. Block ID attribute (location 3): 1 float
+    // Offset is 8 floats
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)(8 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+    
+    // 5. NEW: Texture Index attribute (location 4): 1 float
+    // Offset is 9 floats (3 Pos + 3 Normal + 2 TexCoord + 1 BlockID)
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, stride, (void*)(9 * sizeof(float)));
+    glEnableVertexAttribArray(4);
+}
+
+// Fills one of a chunk's buffers from a mesher vertex buffer: the vertices themselves, or with
+// vertex pulling their face records (drawn through shaders/pulled.vs, about 30x smaller).
+// Adds the bytes uploaded to bytes. Returns false (buffer left empty) if the faces cannot be packed.
+bool UploadChunkVertices(unsigned int buffer, const std::vector<float>& vertices, int64_t key, size_t& bytes) {
+    if (!vertexPulling) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_DRAW);
+        bytes += vertices.size() * sizeof(float);
+        return true;
     }
-    return world[x][y][z] != 0;
+    const bool packed = PackFaceRecords(vertices, World::ChunkKeyX(key), World::ChunkKeyZ(key), faceRecordScratch);
+    if (!packed) {
+        std::cerr << "ERROR::RENDER: Chunk (" << World::ChunkKeyX(key) << ", " << World::ChunkKeyZ(key)
+                  << ") has a face that cannot be packed into face records" << std::endl;
+        faceRecordScratch.assign(FACE_RECORD_HEADER_WORDS, 0);
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, faceRecordScratch.size() * sizeof(uint32_t), faceRecordScratch.data(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    bytes += faceRecordScratch.size() * sizeof(uint32_t);
+    return packed;
 }
 
-bool isOpaque(int x, int y, int z) {
-    // Boundary Check: Out of bounds is always non-opaque (Air)
-    if (x < 0 || x >= WORLD_SIZE_X || 
-        y < 0 || y >= WORLD_SIZE_Y || 
-        z < 0 || z >= WORLD_SIZE_Z) 
-    {
-        return false; 
+// Uploads a chunk mesh from a render packet, creating the chunk's VAO/VBO on first use
+void UploadChunkMesh(const ChunkUpload& upload) {
+    const ChunkMesh& mesh = upload.mesh;
+    ChunkRenderData& data = chunkMeshes[upload.key];
+    if (data.VAO == 0) {
+        glGenVertexArrays(1, &data.VAO);
+        glGenBuffers(1, &data.VBO);
+        if (!vertexPulling) { // Pulled faces need no attributes: the VAO stays empty
+            glBindVertexArray(data.VAO);
+            glBindBuffer(GL_ARRAY_BUFFER, data.VBO);
+            SetupChunkVertexAttributes();
+            glBindVertexArray(0);
+        }
     }
+    chunkBufferBytes -= data.bufferBytes;
+    data.bufferBytes = 0;
 
-    unsigned int id = world[x][y][z];
+    data.opaqueVertexCount = mesh.opaqueVertexCount;
+    std::copy(mesh.sectionVertexStart, mesh.sectionVertexStart + SECTIONS + 1, data.sectionVertexStart);
 
-    // Lookup the definition for the block ID
-    auto it = blockDefs.find(id);
-    if (it != blockDefs.end()) {
-        return it->second.isOpaque;
+    // glBufferSubData is more efficient for updating, but glBufferData is safer 
+    // for changing the size. We use glBufferData here as the mesh size changes frequently.
+    if (!UploadChunkVertices(data.VBO, mesh.vertices, upload.key, data.bufferBytes)) {
+        data.opaqueVertexCount = 0;
+        std::fill(data.sectionVertexStart, data.sectionVertexStart + SECTIONS + 1, 0);
     }
 
-    return false; // Default to non-opaque if block ID is unknown
-}
+    // --- Translucent part: only chunks that actually contain water/glass get the extra buffers ---
+    data.translucentIndexCount = 0;
+    if (mesh.translucentVertexCount > 0) {
+        if (data.translucentVAO == 0) {
+            glGenVertexArrays(1, &data.translucentVAO);
+            glGenBuffers(1, &data.translucentVBO);
+            glGenBuffers(1, &data.translucentEBO);
+            glBindVertexArray(data.translucentVAO);
+            if (!vertexPulling) {
+                glBindBuffer(GL_ARRAY_BUFFER, data.translucentVBO);
+                SetupChunkVertexAttributes();
+            }
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.translucentEBO); // Recorded in the VAO
+            glBindVertexArray(0);
+        }
 
-// Function Generates the final mesh for the entire world based on visible faces.
-std::vector<float> GenerateMesh() {
-    std::vector<float> finalMesh; 
-    
-    // IMPORTANT: Redefine this global constant or ensure it's 10 here.
-    // const int VERTEX_ATTRIBUTES = 10; 
+        if (UploadChunkVertices(data.translucentVBO, mesh.translucentVertices, upload.key, data.bufferBytes)) {
+            // Already sorted for the packet's camera, so the new faces never draw unsorted
+            const std::vector<uint32_t>& indices = upload.translucentIndices;
+            data.translucentIndexCount = (int)indices.size();
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.translucentEBO);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+    }
+    chunkBufferBytes += data.bufferBytes;
+    data.boundsMin = upload.boundsMin;
+    data.boundsMax = upload.boundsMax;
     
-    // Iterate over every block
-    for (int y = 0; y < WORLD_SIZE_Y; ++y) {
-        for (int x = 0; x < WORLD_SIZE_X; ++x) {
-            for (int z = 0; z < WORLD_SIZE_Z; ++z) {
-                
-                if (isBlock(x, y, z)) {
-                    
-                    float blockId = (float)world[x][y][z];
-                    
-                    // 1. DETERMINE TEXTURE INDEX for this block
-                    unsigned int texIndex = 0;
-                    if (blockDefs.count((unsigned int)blockId)) {
-                        texIndex = blockDefs.at((unsigned int)blockId).textureIndex;
-                    }
+    // Unbind
+    glBindBuffer(GL_ARRAY_BUFFER, 0); 
+}
 
-                    // Check its 6 faces
-                    for (int face = 0; face < 6; ++face) {
-                        int neighbor_x = x + FACE_OFFSETS[face][0];
-                        int neighbor_y = y + FACE_OFFSETS[face][1];
-                        int neighbor_z = z + FACE_OFFSETS[face][2];
-                        
-                        // CULLING CHECK: DRAW face ONLY IF neighbor is NOT an OPAQUE block
-                        if (!isOpaque(neighbor_x, neighbor_y, neighbor_z)) {
-                            
-                            // FACE_VERTICES currently contains 8 floats per vertex (Pos(3), Normal(3), TexCoord(2))
-                            // 6 vertices * 8 floats/vertex = 48 floats per face.
-                            const int FACE_FLOATS_OLD = 6 * (VERTEX_ATTRIBUTES - 2); // 48
-                            const int face_start_offset = face * FACE_FLOATS_OLD;
-                            
-                            // Loop for the 6 vertices in this face
-                            // The stride for the data in FACE_VERTICES is 8 (VERTEX_ATTRIBUTES - 2)
-                            for (int i = 0; i < FACE_FLOATS_OLD; i += (VERTEX_ATTRIBUTES - 2)) {
-                                
-                                // 2. PUSH POSITION, NORMAL, AND TEXCOORDS (8 FLOATS)
-                                // Indices 0 through 7 from FACE_VERTICES are pushed
-                                
-                                // Position (x, y, z): Indices 0, 1, 2
-                                finalMesh.push_back(FACE_VERTICES[face_start_offset + i + 0] + (float)x); 
-                                finalMesh.push_back(FACE_VERTICES[face_start_offset + i + 1] + (float)y); 
-                                finalMesh.push_back(FACE_VERTICES[face_start_offset + i + 2] + (float)z); 
-                                
-                                // Normal and Texture Coords: Indices 3 through 7
-                                for (int j = 3; j < VERTEX_ATTRIBUTES - 2; ++j) {
-                                    finalMesh.push_back(FACE_VERTICES[face_start_offset + i + j]);
-                                }
-                                
-                                // 3. PUSH BLOCK ID (9th float)
-                                finalMesh.push_back(blockId); 
-                                
-                                // 4. PUSH TEXTURE INDEX (10th float)
-                                finalMesh.push_back((float)texIndex); 
-                            }
-                        }
-                    }
+// Draws the opaque faces of the chunk's visible sections, one draw per run of adjacent sections
+void DrawChunkSections(const ChunkRenderData& data) {
+    glBindVertexArray(data.VAO);
+    if (vertexPulling) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, data.VBO);
+    }
+    if (data.visibleSections == ALL_SECTIONS) {
+        glDrawArrays(GL_TRIANGLES, 0, data.opaqueVertexCount);
+        ++frameDraws.drawCalls;
+        frameDraws.vertices += data.opaqueVertexCount;
+        return;
+    }
+    for (int s = 0; s < SECTIONS;) {
+        if (!(data.visibleSections & (1u << s))) {
+            ++s;
+            continue;
+        }
+        const int first = data.sectionVertexStart[s];
+        while (s < SECTIONS && (data.visibleSections & (1u << s))) ++s;
+        if (data.sectionVertexStart[s] > first) {
+            glDrawArrays(GL_TRIANGLES, first, data.sectionVertexStart[s] - first);
+            ++frameDraws.drawCalls;
+            frameDraws.vertices += data.sectionVertexStart[s] - first;
+        }
+    }
+}
+
+// Records a mesh the packet builder just wrote to packet.NextUpload() and queues it for upload:
+// the chunk's LOD, translucent face order (sorted for the last sort position) and section
+// visibility sets, and the mesh bounds for frustum and occlusion culling.
+void QueueChunkUpload(RenderPacket& packet, int64_t key, int lod) {
+    ChunkUpload& upload = packet.NextUpload();
+    const ChunkMesh& mesh = upload.mesh;
+    upload.key = key;
+
+    ChunkFrameState& state = chunkStates[key];
+    state.lod = lod;
+    state.hasFaces = mesh.opaqueVertexCount > 0 || mesh.translucentVertexCount > 0;
+    state.hasTranslucent = mesh.translucentVertexCount > 0;
+    state.translucentOrder.Reset(mesh.translucentFaceCenters);
+    state.translucentOrder.Sort(translucentSortPos);
+    upload.translucentIndices = state.translucentOrder.Indices();
+    translucentOrderStale = true; // The chunk may have gained or lost translucent faces
+    caveCuller.SetChunk(key, mesh.sectionVisibility);
+
+    upload.boundsMin = glm::vec3(INFINITY);
+    upload.boundsMax = glm::vec3(-INFINITY);
+    for (const std::vector<float>* vertices : { &mesh.vertices, &mesh.translucentVertices }) {
+        for (size_t i = 0; i < vertices->size(); i += VERTEX_ATTRIBUTES) {
+            const glm::vec3 position((*vertices)[i], (*vertices)[i + 1], (*vertices)[i + 2]);
+            upload.boundsMin = glm::min(upload.boundsMin, position);
+            upload.boundsMax = glm::max(upload.boundsMax, position);
+        }
+    }
+    packet.CommitUpload();
+}
+
+// Regenerates the meshes of the dirty chunks nearest the camera (up to MAX_REMESHES_PER_FRAME) into
+// packet uploads. Chunks whose mesh is in the mesh cache are loaded from there instead (up to
+// MAX_CACHED_MESHES_PER_FRAME lookups), and freshly built meshes are stored for the next run. Chunks
+// at (or next to) a reduced level of detail are meshed at their LOD and not cached: they are cheap to build.
+// Streaming can dirty dozens of chunks at once; the rest stay dirty and are picked up next frame.
+// Returns the number of chunks still waiting.
+size_t RemeshDirtyChunks(glm::vec3 cameraPos, RenderPacket& packet) {
+    // Meshing reads the world, which the simulation thread may be changing (water), so hold the lock
+    std::lock_guard<std::mutex> lock(worldMutex);
+
+    world.TakeDirtyChunks(dirtyChunkKeys);
+    auto chunkDistance = [&](int64_t key) {
+        float dx = (World::ChunkKeyX(key) + 0.5f) * CHUNK_SIZE - cameraPos.x;
+        float dz = (World::ChunkKeyZ(key) + 0.5f) * CHUNK_SIZE - cameraPos.z;
+        return dx * dx + dz * dz;
+    };
+    size_t count = std::min(dirtyChunkKeys.size(), (size_t)(MAX_REMESHES_PER_FRAME + MAX_CACHED_MESHES_PER_FRAME));
+    std::partial_sort(dirtyChunkKeys.begin(), dirtyChunkKeys.begin() + count, dirtyChunkKeys.end(),
+                      [&](int64_t a, int64_t b) { return chunkDistance(a) < chunkDistance(b); });
+
+    int remeshed = 0, lookups = 0;
+    size_t waiting = 0;
+    for (size_t i = 0; i < dirtyChunkKeys.size(); ++i) {
+        int64_t key = dirtyChunkKeys[i];
+        const int chunkX = World::ChunkKeyX(key), chunkZ = World::ChunkKeyZ(key);
+        if (i < count) {
+            // Built straight into the packet (the upload's mesh is reused between frames)
+            ChunkMesh& mesh = packet.NextUpload().mesh;
+            const int lod = ChunkLod(chunkX, chunkZ, lodCameraChunk, lodDistance);
+            int neighbourLods[4];
+            bool fullDetail = (lod == 0);
+            for (int n = 0; n < 4; ++n) {
+                neighbourLods[n] = ChunkLod(chunkX + FACE_OFFSETS[2 + n][0], chunkZ + FACE_OFFSETS[2 + n][2], lodCameraChunk, lodDistance);
+                fullDetail = fullDetail && neighbourLods[n] == 0;
+            }
+            if (!fullDetail) {
+                if (remeshed < MAX_REMESHES_PER_FRAME) {
+                    GenerateLodChunkMesh(world, chunkX, chunkZ, lod, neighbourLods, mesh);
+                    QueueChunkUpload(packet, key, lod);
+                    ++remeshed;
+                    continue;
+                }
+                world.MarkChunkDirty(chunkX, chunkZ); // Next frame
+                ++waiting;
+                continue;
+            }
+
+            const uint64_t meshKey = meshCache.MeshKey(world, chunkX, chunkZ);
+            if (meshKey != 0 && lookups < MAX_CACHED_MESHES_PER_FRAME) {
+                ++lookups;
+                if (meshCache.Load(chunkX, chunkZ, meshKey, mesh)) {
+                    QueueChunkUpload(packet, key, 0);
+                    continue;
                 }
             }
+            if (remeshed < MAX_REMESHES_PER_FRAME) {
+                GenerateChunkMesh(world, chunkX, chunkZ, mesh);
+                meshCache.Store(chunkX, chunkZ, meshKey, mesh);
+                QueueChunkUpload(packet, key, 0);
+                ++remeshed;
+                continue;
+            }
         }
+        world.MarkChunkDirty(chunkX, chunkZ); // Next frame
+        ++waiting;
     }
-    
-    opaqueVertexCount = finalMesh.size() / VERTEX_ATTRIBUTES;
-    totalVertices_Global = opaqueVertexCount; 
+    return waiting;
+}
 
-    return finalMesh;
+// Chooses chunk LODs for the camera's chunk. When the camera enters another chunk, every meshed
+// chunk whose LOD changed is remeshed, along with its four neighbours: their border faces are
+// culled against it at its LOD (see GenerateLodChunkMesh).
+// The caller holds worldMutex.
+void UpdateChunkLods(glm::vec3 cameraPos) {
+    glm::ivec2 cameraChunk(World::ToChunkCoord((int)std::floor(cameraPos.x)),
+                           World::ToChunkCoord((int)std::floor(cameraPos.z)));
+    if (cameraChunk == lodCameraChunk) {
+        return;
+    }
+    lodCameraChunk = cameraChunk;
+    for (const auto& pair : chunkStates) {
+        const int chunkX = World::ChunkKeyX(pair.first), chunkZ = World::ChunkKeyZ(pair.first);
+        if (pair.second.lod == ChunkLod(chunkX, chunkZ, cameraChunk, lodDistance)) continue;
+        world.MarkChunkDirty(chunkX, chunkZ);
+        for (int n = 2; n < 6; ++n) {
+            world.MarkChunkDirty(chunkX + FACE_OFFSETS[n][0], chunkZ + FACE_OFFSETS[n][2]);
+        }
+    }
 }
 
-// Function to regenerate the mesh and upload it to the GPU
-void UpdateMesh() {
-    // 1. Generate the new mesh based on the current world array
-    std::vector<float> meshVertices = GenerateMesh();
-    
-    // 2. Update the global vertex count
-    totalVertices_Global = meshVertices.size() / VERTEX_ATTRIBUTES;
+// Forgets a chunk the streamer evicted and queues the release of its GPU buffers
+void ReleaseChunkState(RenderPacket& packet, int64_t key) {
+    if (chunkStates.erase(key) == 0) {
+        return;
+    }
+    caveCuller.RemoveChunk(key);
+    translucentOrderStale = true;
+    packet.releases.push_back(key);
+}
 
-    // 3. Upload the new data to the VBO
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_Global);
-    
-    // glBufferSubData is more efficient for updating, but glBufferData is safer 
-    // for changing the size. We use glBufferData here as the mesh size changes frequently.
-    glBufferData(GL_ARRAY_BUFFER, meshVertices.size() * sizeof(float), meshVertices.data(), GL_DYNAMIC_DRAW);
-    
-    // Unbind
-    glBindBuffer(GL_ARRAY_BUFFER, 0); 
+// Frees the GPU buffers of a chunk the streamer evicted
+void ReleaseChunkMesh(int64_t key) {
+    auto it = chunkMeshes.find(key);
+    if (it == chunkMeshes.end()) {
+        return;
+    }
+    ChunkRenderData& data = it->second;
+    chunkBufferBytes -= data.bufferBytes;
+    glDeleteVertexArrays(1, &data.VAO);
+    glDeleteBuffers(1, &data.VBO);
+    if (data.translucentVAO != 0) {
+        glDeleteVertexArrays(1, &data.translucentVAO);
+        glDeleteBuffers(1, &data.translucentVBO);
+        glDeleteBuffers(1, &data.translucentEBO);
+    }
+    chunkMeshes.erase(it);
+    occlusion.Release(key);
+}
+
+// Applies a packet's buffer changes, in the order they were made: releases, uploads, then the
+// re-sorted translucent faces
+void ApplyRenderPacket(const RenderPacket& packet) {
+    for (int64_t key : packet.releases) {
+        ReleaseChunkMesh(key);
+    }
+    for (size_t i = 0; i < packet.uploadCount; ++i) {
+        UploadChunkMesh(packet.uploads[i]);
+    }
+    for (size_t i = 0; i < packet.indexUpdateCount; ++i) {
+        const TranslucentIndexUpdate& update = packet.indexUpdates[i];
+        auto it = chunkMeshes.find(update.key);
+        // Skips chunks whose translucent faces failed to upload
+        if (it == chunkMeshes.end() || it->second.translucentIndexCount != (int)update.indices.size()) continue;
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, it->second.translucentEBO);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, update.indices.size() * sizeof(uint32_t), update.indices.data());
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+// The read-only counterpart of ChunkStreamer::Update: mapped chunks need no loading, so when the
+// camera enters another chunk the chunks that came into range are just marked dirty (meshed by
+// RemeshDirtyChunks, nearest first) and those past the eviction radius are reported in evicted.
+void UpdateMappedView(glm::vec3 cameraPos, std::vector<int64_t>& evicted) {
+    evicted.clear();
+    glm::ivec2 cameraChunk(World::ToChunkCoord((int)std::floor(cameraPos.x)),
+                           World::ToChunkCoord((int)std::floor(cameraPos.z)));
+    if (cameraChunk == mappedViewChunk) {
+        return;
+    }
+    mappedViewChunk = cameraChunk;
+
+    const int evictRadius = viewDistance + EVICT_MARGIN;
+    for (auto it = mappedInView.begin(); it != mappedInView.end();) {
+        int dx = World::ChunkKeyX(*it) - cameraChunk.x;
+        int dz = World::ChunkKeyZ(*it) - cameraChunk.y;
+        if (dx * dx + dz * dz > evictRadius * evictRadius) {
+            evicted.push_back(*it);
+            it = mappedInView.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (int dx = -viewDistance; dx <= viewDistance; ++dx) {
+        for (int dz = -viewDistance; dz <= viewDistance; ++dz) {
+            if (dx * dx + dz * dz > viewDistance * viewDistance) continue;
+            int chunkX = cameraChunk.x + dx;
+            int chunkZ = cameraChunk.y + dz;
+            if (mappedWorld.GetChunk(chunkX, chunkZ) && mappedInView.insert(World::ChunkKey(chunkX, chunkZ)).second) {
+                world.MarkChunkDirty(chunkX, chunkZ);
+            }
+        }
+    }
 }
 
-// Forward declaration of the global mesh update function
-extern void UpdateMesh(); 
+// Re-sorts translucent faces (per chunk, and the chunks themselves) back to front, queueing the
+// new orders in the packet. Does nothing until the camera crosses into another block, so a still
+// or slow camera costs nothing.
+void SortTranslucentChunks(glm::vec3 cameraPos, RenderPacket& packet) {
+    glm::ivec3 cell = glm::ivec3(glm::floor(cameraPos));
+    if (cell == translucentSortCell && !translucentOrderStale) {
+        return;
+    }
+    const bool cameraMoved = (cell != translucentSortCell);
+    translucentSortCell = cell;
+    translucentSortPos = cameraPos;
+    translucentOrderStale = false;
+
+    translucentChunkOrder.clear();
+    for (auto& pair : chunkStates) {
+        ChunkFrameState& state = pair.second;
+        if (!state.hasTranslucent) continue;
+        translucentChunkOrder.push_back(pair.first);
+
+        // Freshly uploaded chunks were sorted for this position already
+        if (cameraMoved && state.translucentOrder.Sort(cameraPos)) {
+            TranslucentIndexUpdate& update = packet.AddIndexUpdate();
+            update.key = pair.first;
+            update.indices = state.translucentOrder.Indices();
+        }
+    }
+
+    // Chunk columns are disjoint, so ordering them by their centres is enough
+    auto chunkDistance = [&](int64_t key) {
+        float dx = (World::ChunkKeyX(key) + 0.5f) * CHUNK_SIZE - cameraPos.x;
+        float dz = (World::ChunkKeyZ(key) + 0.5f) * CHUNK_SIZE - cameraPos.z;
+        return dx * dx + dz * dz;
+    };
+    std::sort(translucentChunkOrder.begin(), translucentChunkOrder.end(),
+              [&](int64_t a, int64_t b) { return chunkDistance(a) > chunkDistance(b); });
+}
+
+// Lists the chunks to draw: those with faces in a section the cave search reached (every
+// section without cave culling), and the translucent ones among them farthest first
+void QueueChunkDraws(RenderPacket& packet) {
+    for (const auto& pair : chunkStates) {
+        if (!pair.second.hasFaces) continue;
+        const uint8_t sections = caveCulling ? caveCuller.VisibleSections(pair.first) : ALL_SECTIONS;
+        if (sections != 0) {
+            packet.draws.push_back({ pair.first, sections });
+        }
+    }
+    for (int64_t key : translucentChunkOrder) {
+        if (!caveCulling || caveCuller.VisibleSections(key) != 0) {
+            packet.translucentOrder.push_back(key);
+        }
+    }
+}
 
 // Global constants for movement direction (used in raycasting)
 const float RAY_DISTANCE = 8.0f; // Increased distance for better interaction range
@@ -460,8 +836,8 @@ extern unsigned int currentPlacementBlockID;
 // --- NEW: Raycast Result Structure ---
 struct RaycastHit {
     bool hit = false;
-    glm::ivec3 target_block_coord = glm::ivec3(-1); // The solid block hit (for destruction/info)
-    glm::ivec3 placement_block_coord = glm::ivec3(-1); // The adjacent air block (for placement)
+    glm::ivec3 target_block_coord = glm::ivec3(0); // The solid block hit (for destruction/info); only valid if hit
+    glm::ivec3 placement_block_coord = glm::ivec3(0); // The adjacent air block (for placement); only valid if hit
 };
 
 // --- NEW: Single Raycast Function (DDA Implementation) ---
@@ -471,10 +847,6 @@ RaycastHit CastSingleRay(glm::vec3 start_pos, glm::vec3 ray_dir) {
     // Integer coordinates of the current block, start in the block player is currently in
     glm::ivec3 map_pos = glm::ivec3(glm::floor(start_pos)); 
     
-    // The final result (will be stored in the struct)
-    glm::ivec3 target_block_coord = glm::ivec3(-1); 
-    glm::ivec3 placement_block_coord = glm::ivec3(-1); 
-    
     // --- DDA Voxel Traversal Setup ---
     glm::ivec3 step;
     
@@ -536,52 +908,66 @@ RaycastHit CastSingleRay(glm::vec3 start_pos, glm::vec3 ray_dir) {
         // --- 4. Check for Block Hit ---
         
         // Bounds Check
-        if (map_pos.x < 0 || map_pos.x >= WORLD_SIZE_X || 
-            map_pos.y < 0 || map_pos.y >= WORLD_SIZE_Y || 
-            map_pos.z < 0 || map_pos.z >= WORLD_SIZE_Z ||
+        if (map_pos.y < 0 || map_pos.y >= WORLD_SIZE_Y || 
             current_dist >= RAY_DISTANCE) 
         {
              break; // Left world bounds or max distance reached
         }
         
         // Block Solid Check (ID != 0)
-        if (world[map_pos.x][map_pos.y][map_pos.z] != 0) {
+        if (world.getBlock(map_pos.x, map_pos.y, map_pos.z) != 0) {
+            // Any coordinate can be a target (the world extends to negative x/z), so the flag says "hit"
+            result.hit = true;
             // map_pos is the solid block to destroy
-            target_block_coord = map_pos;
+            result.target_block_coord = map_pos;
             
             // last_air_coord is the air block for placement
-            placement_block_coord = last_air_coord; 
+            result.placement_block_coord = last_air_coord; 
             break; // Found the target block
         }
     }
-
-    if (target_block_coord.x != -1) {
-        result.hit = true;
-        result.target_block_coord = target_block_coord;
-        result.placement_block_coord = placement_block_coord;
-    }
     
     return result;
 }
 
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
     
-    // Only process actions on press, not release
-    if (action != GLFW_PRESS) return;
+    // Only process actions on press, not release (and nothing while a log is replayed)
+    if (action != GLFW_PRESS || replaying) return;
+    if (button != GLFW_MOUSE_BUTTON_LEFT && button != GLFW_MOUSE_BUTTON_RIGHT && button != GLFW_MOUSE_BUTTON_MIDDLE) return;
+
+    // Acted on by the packet builder, between ticks (see HandleClick)
+    InputEvent event;
+    event.type = InputEventType::Click;
+    event.button = (uint8_t)button;
+    inputQueue.Push(event);
+}
+
+// A mouse button press with the camera at eye: break, place or pick the targeted block
+void HandleClick(int button, const Camera& eye) {
 
     // --- 0. SINGLE RAYCAST EXECUTION ---
-    
+
     // Set the starting position (eye height, slightly in front of camera)
-    glm::vec3 base_ray_pos = camera.Position + camera.Front * RAY_START_OFFSET; 
+    glm::vec3 base_ray_pos = eye.Position + eye.Front * RAY_START_OFFSET; 
     base_ray_pos.y += 0.25f; // Vertical position adjustment (centered on eye height)
     base_ray_pos.x -= -0.35f;
     base_ray_pos.z -= -0.35f;
     
     // The ray direction is simply the camera's forward vector
-    glm::vec3 ray_dir = camera.Front;
+    glm::vec3 ray_dir = eye.Front;
     
-    // Cast the single ray
-    RaycastHit best_hit = CastSingleRay(base_ray_pos, ray_dir);
+    // Cast the single ray (chunks may be streaming in or out on another thread)
+    RaycastHit best_hit;
+    BlockID targetID = 0, placementID = 0;
+    {
+        std::lock_guard<std::mutex> lock(worldMutex);
+        best_hit = CastSingleRay(base_ray_pos, ray_dir);
+        if (best_hit.hit) {
+            targetID = world.getBlock(best_hit.target_block_coord.x, best_hit.target_block_coord.y, best_hit.target_block_coord.z);
+            placementID = world.getBlock(best_hit.placement_block_coord.x, best_hit.placement_block_coord.y, best_hit.placement_block_coord.z);
+        }
+    }
     
     // --- Raycast result extraction ---
     glm::ivec3 target_block_coord = best_hit.target_block_coord; 
@@ -596,12 +982,28 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
     }
 
 
+    // --- 0b. A mapped (--map) world cannot be edited; picking still works ---
+    if (world.IsReadOnly() && button != GLFW_MOUSE_BUTTON_MIDDLE) {
+        std::cout << "ACTION FAILED: The map is read-only." << std::endl;
+    }
+
     // --- 1. BLOCK DESTRUCTION (Left Click) ---
-    if (button == GLFW_MOUSE_BUTTON_LEFT) {
+    else if (button == GLFW_MOUSE_BUTTON_LEFT) {
         if (best_hit.hit) { 
-            world[target_block_coord.x][target_block_coord.y][target_block_coord.z] = 0; 
+            uint64_t journalTicket;
+            {
+                std::lock_guard<std::mutex> lock(worldMutex);
+                BlockID oldID = world.getBlock(target_block_coord.x, target_block_coord.y, target_block_coord.z);
+                world.setBlock(target_block_coord.x, target_block_coord.y, target_block_coord.z, 0); 
+                journalTicket = editJournal.Append(target_block_coord.x, target_block_coord.y, target_block_coord.z, oldID, 0, simTickCount);
+
+                water.OnBlockChanged(world, target_block_coord.x, target_block_coord.y, target_block_coord.z, simTickCount);
+
+                // Drop the block as an item that pops up and falls back to the ground
+                entities.Spawn(glm::vec3(target_block_coord) + glm::vec3(0.5f), ITEM_SIZE, ENTITY_ITEM, glm::vec3(0.0f, 4.0f, 0.0f));
+            }
+            editJournal.WaitWritten(journalTicket); // Outside the lock: only waits with --journal-sync edit
             std::cout << "ACTION: Block destroyed at: (" << target_block_coord.x << ", " << target_block_coord.y << ", " << target_block_coord.z << ")" << std::endl;
-            UpdateMesh(); 
         } else {
             std::cout << "ACTION FAILED: No solid block targeted for destruction." << std::endl;
         }
@@ -612,10 +1014,10 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
         if (best_hit.hit) {
             
             // CRITICAL: Check if the placement spot is Air (ID 0). 
-            if (world[placement_block_coord.x][placement_block_coord.y][placement_block_coord.z] == 0) {
+            if (placementID == 0) {
                 
                 // --- ROBUST PLAYER OVERLAP CHECK (Prevents placement inside player) ---
-                glm::ivec3 player_feet_block = glm::ivec3(glm::floor(camera.Position));
+                glm::ivec3 player_feet_block = glm::ivec3(glm::floor(eye.Position));
                 glm::ivec3 player_head_block = player_feet_block;
                 player_head_block.y += 1; 
 
@@ -623,15 +1025,22 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
                     placement_block_coord != player_head_block) {
                     
                     // Placement is safe
-                    world[placement_block_coord.x][placement_block_coord.y][placement_block_coord.z] = currentPlacementBlockID; 
+                    uint64_t journalTicket;
+                    {
+                        std::lock_guard<std::mutex> lock(worldMutex);
+                        world.setBlock(placement_block_coord.x, placement_block_coord.y, placement_block_coord.z, (BlockID)currentPlacementBlockID); 
+                        journalTicket = editJournal.Append(placement_block_coord.x, placement_block_coord.y, placement_block_coord.z,
+                                                           0, (BlockID)currentPlacementBlockID, simTickCount);
+                        water.OnBlockChanged(world, placement_block_coord.x, placement_block_coord.y, placement_block_coord.z, simTickCount);
+                    }
+                    editJournal.WaitWritten(journalTicket);
                     std::cout << "ACTION: Block placed at: (" << placement_block_coord.x << ", " << placement_block_coord.y << ", " << placement_block_coord.z << ") - ID: " << currentPlacementBlockID << std::endl;
-                    UpdateMesh();
                 } else {
                     // Placement failed due to player conflict
                     std::cout << "ACTION FAILED: Cannot place block inside player's occupied space (Feet: " << player_feet_block.x << ", " << player_feet_block.y << ", " << player_feet_block.z << " | Head: " << player_head_block.x << ", " << player_head_block.y << ", " << player_head_block.z << ")." << std::endl;
                 }
             } else {
-                std::cout << "ACTION FAILED: Placement spot (" << placement_block_coord.x << ", " << placement_block_coord.y << ", " << placement_block_coord.z << ") is already occupied by ID " << world[placement_block_coord.x][placement_block_coord.y][placement_block_coord.z] << std::endl;
+                std::cout << "ACTION FAILED: Placement spot (" << placement_block_coord.x << ", " << placement_block_coord.y << ", " << placement_block_coord.z << ") is already occupied by ID " << placementID << std::endl;
             }
         } else {
             std::cout << "ACTION FAILED: No target block was hit by crosshair ray (Required for placement)." << std::endl;
@@ -641,7 +1050,7 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
     // --- 3. BLOCK PICK (Middle Click) ---
     else if (button == GLFW_MOUSE_BUTTON_MIDDLE) {
         if (best_hit.hit) { 
-            unsigned int pickedID = world[target_block_coord.x][target_block_coord.y][target_block_coord.z];
+            unsigned int pickedID = targetID;
             
             if (pickedID != 0) {
                 currentPlacementBlockID = pickedID; 
@@ -652,129 +1061,338 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
 }
 
 
-// TESTING PLAYER & COLLISION --------------------------------------------------------------
-// Collision Check and Resolution: Checks for solid block collisions and resolves player position.
-// This uses a sweeping AABB check.
-void CheckCollisionAndResolve(glm::vec3& pos, glm::vec3& vel, glm::vec3 size, float dt) {
-    glm::vec3 newPos = pos + vel * dt;
-    glm::vec3 halfSize = size * 0.5f;
-
-    // Define the range of block coordinates to check around the player's new position
-    glm::ivec3 minBlock = glm::floor(newPos - halfSize);
-    glm::ivec3 maxBlock = glm::floor(newPos + halfSize);
-
-    for (int x = minBlock.x; x <= maxBlock.x; ++x) {
-        for (int y = minBlock.y; y <= maxBlock.y; ++y) {
-            for (int z = minBlock.z; z <= maxBlock.z; ++z) {
-
-                // Check collision only against OPAQUE (solid) blocks
-                if (isOpaque(x, y, z)) {
-                    // Block AABB center
-                    glm::vec3 blockCenter = glm::vec3((float)x + 0.5f, (float)y + 0.5f, (float)z + 0.5f);
-                    glm::vec3 blockHalfSize = glm::vec3(0.5f);
-
-                    // --- Collision Resolution (Axis of Least Penetration) ---
-                    glm::vec3 distance = newPos - blockCenter;
-                    glm::vec3 penetration = glm::abs(distance) - (halfSize + blockHalfSize);
-
-                    if (penetration.x < 0.0f && penetration.y < 0.0f && penetration.z < 0.0f) {
-                        
-                        // Find the shallowest penetration axis
-                        if (penetration.x > penetration.y && penetration.x > penetration.z) {
-                            // X-axis collision is deepest (resolve X)
-                            float push_x = penetration.x;
-                            newPos.x += (distance.x > 0) ? -push_x : push_x;
-                            vel.x = 0.0f; // Stop movement on this axis
-                        } 
-                        else if (penetration.y > penetration.z) {
-                            // Y-axis collision is deepest (resolve Y)
-                            float push_y = penetration.y;
-                            newPos.y += (distance.y > 0) ? -push_y : push_y;
-                            
-                            // Check for ground collision: if the player is hitting the top of a block
-                            if (distance.y < 1.9) {
-                                isGrounded = true; 
-                            }
-                            vel.y = 0.0f; // Stop vertical movement
-                        } 
-                        else {
-                            // Z-axis collision is deepest (resolve Z)
-                            float push_z = penetration.z;
-                            newPos.z += (distance.z > 0) ? -push_z : push_z;
-                            vel.z = 0.0f; // Stop movement on this axis
-                        }
-                    }
-                }
-            }
+// Turns the sampled keyboard state into the player's intended velocity and hitbox
+void ApplyPlayerInput(const PlayerInput& input) {
+    // Reset horizontal velocity
+    glm::vec3 playerVelocity = entities.GetVelocity(playerEntity);
+    playerVelocity.x = 0.0f;
+    playerVelocity.z = 0.0f;
+
+    // Crouching shrinks the hitbox and slows the player; sprinting only works while standing
+    if (input.sneak) {
+        entities.SetSize(playerEntity, PLAYER_SIZE_SNEAKING);
+        PLAYER_SPEED = 2.5f;
+    } else {
+        entities.SetSize(playerEntity, PLAYER_SIZE_STANDING);
+        PLAYER_SPEED = input.sprint ? 5.5f : 3.5f;
+    }
+
+    // Horizontal Movement (Set desired velocity)
+    if (input.moveForward) playerVelocity += input.forward * PLAYER_SPEED;
+    if (input.moveBack)    playerVelocity -= input.forward * PLAYER_SPEED;
+    if (input.moveLeft)    playerVelocity -= input.right * PLAYER_SPEED;
+    if (input.moveRight)   playerVelocity += input.right * PLAYER_SPEED;
+
+    // Jumping (Spacebar)
+    if (input.jump && entities.HasFlag(playerEntity, ENTITY_GROUNDED)) {
+        playerVelocity.y = JUMP_VELOCITY;
+        entities.flags[playerEntity] &= ~(uint32_t)ENTITY_GROUNDED; // Prevents spamming jump
+    }
+
+    entities.SetVelocity(playerEntity, playerVelocity);
+}
+
+// Collects every item entity within PICKUP_RADIUS of the player (uses the entity grid from this tick)
+void CollectNearbyItems() {
+    uint32_t found = entityGrid.QueryRadius(entities.GetPosition(playerEntity), PICKUP_RADIUS,
+                                            nearbyEntities, sizeof(nearbyEntities) / sizeof(nearbyEntities[0]));
+    found = std::min(found, (uint32_t)(sizeof(nearbyEntities) / sizeof(nearbyEntities[0])));
+
+    // Despawn from the highest index down, since Despawn() moves the last entity into the freed slot
+    std::sort(nearbyEntities, nearbyEntities + found, std::greater<uint32_t>());
+    for (uint32_t k = 0; k < found; ++k) {
+        uint32_t i = nearbyEntities[k];
+        if (entities.HasFlag(i, ENTITY_ITEM)) {
+            entities.Despawn(i);
+            std::cout << "ACTION: Picked up item" << std::endl;
         }
     }
-    
-    // Update player position and global velocity
-    pos = newPos;
-    playerVelocity = vel;
 }
 
-// Applies gravity and calls the collision resolver
-void UpdatePlayerPhysics(float dt) {
-    // Reset grounded status
-    isGrounded = false;
-    
-    // 1. Apply Gravity to Y-velocity
-    playerVelocity.y += GRAVITY * dt;
-    
-    // 2. Perform Collision and Movement (AABB vs. World)
-    CheckCollisionAndResolve(playerPos, playerVelocity, PLAYER_SIZE, dt);
-    
-    // 3. Apply friction/damping to horizontal movement when grounded
-    if (isGrounded) {
-        playerVelocity.x *= 0.8f;
-        playerVelocity.z *= 0.8f;
-        
-        // Stop movement if below a threshold
-        if (glm::length(glm::vec2(playerVelocity.x, playerVelocity.z)) < 0.05f) {
-            playerVelocity.x = 0.0f;
-            playerVelocity.z = 0.0f;
+// Applies one input event (packet builder, between ticks). With --record it is logged at the tick
+// count it was applied after; keyboard samples only when they can change the player's input.
+void ApplyInputEvent(InputEvent& event) {
+    static uint16_t loggedKeys = 0;
+    static bool keysLogged = false;
+    static bool turnedSinceKeys = false; // The camera turned: the same keys now move another way
+    bool log = true;
+
+    if (event.type == InputEventType::MouseMove) {
+        camera.ProcessMouseMovement(event.dx, event.dy);
+        turnedSinceKeys = true;
+    } else if (event.type == InputEventType::Keys) {
+        // Calculate forward/right vectors based on camera's view (horizontal-only)
+        PlayerInput input;
+        input.forward = glm::normalize(glm::vec3(camera.Front.x, 0.0f, camera.Front.z));
+        input.right = glm::normalize(glm::cross(input.forward, camera.Up));
+        // Movement keys are only recorded here; ApplyPlayerInput turns them into velocity on the next tick
+        input.moveForward = (event.keys & INPUT_KEY_FORWARD) != 0;
+        input.moveBack    = (event.keys & INPUT_KEY_BACK) != 0;
+        input.moveLeft    = (event.keys & INPUT_KEY_LEFT) != 0;
+        input.moveRight   = (event.keys & INPUT_KEY_RIGHT) != 0;
+        input.sneak       = (event.keys & INPUT_KEY_SNEAK) != 0;
+        input.sprint      = (event.keys & INPUT_KEY_SPRINT) != 0;
+        input.jump        = (event.keys & INPUT_KEY_JUMP) != 0;
+        {
+            std::lock_guard<std::mutex> lock(inputMutex);
+            latestInput = input;
+        }
+
+        // Held N / M step the placement block every frame
+        if (event.keys & INPUT_KEY_NEXT_BLOCK) {
+            cID++;
+            currentPlacementBlockID = cID;
         }
+        if (event.keys & INPUT_KEY_PREVIOUS_BLOCK) {
+            cID--;
+            currentPlacementBlockID = cID;
+        }
+
+        const uint16_t stepKeys = INPUT_KEY_NEXT_BLOCK | INPUT_KEY_PREVIOUS_BLOCK;
+        log = !keysLogged || event.keys != loggedKeys || turnedSinceKeys || (event.keys & stepKeys) != 0;
+        if (log) {
+            loggedKeys = event.keys;
+            keysLogged = true;
+            turnedSinceKeys = false;
+        }
+    } else if (event.type == InputEventType::Click) {
+        // The camera position follows the interpolated player, which depends on frame timing:
+        // the log keeps the one the click was made from
+        Camera eye = camera;
+        if (replaying) {
+            eye.Position = event.eye;
+        } else {
+            event.eye = eye.Position;
+        }
+        HandleClick(event.button, eye);
     }
+
+    if (log && inputRecorder.IsOpen()) {
+        event.tick = simTickCount; // Inline simulation only: no tick runs concurrently
+        inputRecorder.Write(event);
+    }
+}
+
+// FNV-1a of every entity's position, velocity and flags, chained onto h (call with worldMutex held)
+uint64_t ChecksumSimulation(uint64_t h) {
+    const uint32_t count = entities.Count();
+    h = ChecksumBytes(h, &count, sizeof(count));
+    for (const std::vector<float>* values : { &entities.posX, &entities.posY, &entities.posZ,
+                                              &entities.velX, &entities.velY, &entities.velZ }) {
+        h = ChecksumBytes(h, values->data(), count * sizeof(float));
+    }
+    return ChecksumBytes(h, entities.flags.data(), count * sizeof(uint32_t));
+}
+
+// Wall clock seconds: GLFW's, or since the first call without a window
+double WallTime() {
+    static const auto startTime = std::chrono::steady_clock::now();
+    return headless ? std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() : glfwGetTime();
+}
+
+// One fixed-length simulation step. Runs either inline from the render loop or on simThread.
+void SimulationTick(float dt) {
+    PlayerInput input;
+    {
+        std::lock_guard<std::mutex> lock(inputMutex);
+        input = latestInput;
+    }
+
+    SimState state;
+    {
+        // Entities are also touched by HandleClick (item drops), so they share the world lock
+        std::lock_guard<std::mutex> lock(worldMutex);
+        state.tick = ++simTickCount;
+
+        ApplyPlayerInput(input);
+        StepEntities(entities, world, dt, physicsThreads, jobSystem.get()); // Apply gravity, check collision, update positions
+        water.Update(world, simTickCount);                 // Flow any water scheduled for this tick
+
+        entityGrid.Build(entities);
+        CollectNearbyItems();
+        simChecksum = ChecksumSimulation(simChecksum);
+
+        state.playerPos = entities.GetPosition(playerEntity);
+        state.playerVelocity = entities.GetVelocity(playerEntity);
+        state.playerSize = entities.GetSize(playerEntity);
+        state.isGrounded = entities.HasFlag(playerEntity, ENTITY_GROUNDED);
+    }
+    state.time = WallTime();
+    simStates.Publish(state);
 }
 //--------------------------------------------------------------------------------------------------
 
+// --headless: the camera at a frame of the scripted path, one lap around center every headlessFrames
+Camera HeadlessPathCamera(int pathFrame, glm::vec3 center) {
+    const float angle = 2.0f * glm::pi<float>() * (float)pathFrame / (float)headlessFrames;
+    glm::vec3 position = center + glm::vec3(HEADLESS_PATH_RADIUS * std::cos(angle), HEADLESS_PATH_HEIGHT,
+                                            HEADLESS_PATH_RADIUS * std::sin(angle));
+    // Facing along the circle: the tangent (-sin, cos) as a yaw (see Camera::updateCameraVectors)
+    const float yaw = glm::degrees(std::atan2(std::cos(angle), -std::sin(angle)));
+    return Camera(position, glm::vec3(0.0f, 1.0f, 0.0f), yaw, HEADLESS_PATH_PITCH);
+}
 
-int main() {
-    // 1. Initialize GLFW
-    if (!glfwInit()) {
-        std::cerr << "Failed to initialize GLFW" << std::endl;
-        return -1;
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--sim-thread") == 0) {
+            useSimThread = true;
+        } else if (std::strcmp(argv[i], "--game-thread") == 0) {
+            useGameThread = true;
+        } else if (std::strcmp(argv[i], "--physics-threads") == 0 && i + 1 < argc) {
+            physicsThreads = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--job-threads") == 0 && i + 1 < argc) {
+            jobThreads = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            terrainSeed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--view-distance") == 0 && i + 1 < argc) {
+            viewDistance = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--stream-threads") == 0 && i + 1 < argc) {
+            streamThreads = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--compact-distance") == 0 && i + 1 < argc) {
+            compactDistance = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--lod-distance") == 0 && i + 1 < argc) {
+            lodDistance = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--no-occlusion-culling") == 0) {
+            occlusionCulling = false;
+        } else if (std::strcmp(argv[i], "--no-cave-culling") == 0) {
+            caveCulling = false;
+        } else if (std::strcmp(argv[i], "--vertex-pulling") == 0) {
+            vertexPulling = true;
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--headless-frames") == 0 && i + 1 < argc) {
+            headlessFrames = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--headless-image") == 0 && i + 1 < argc) {
+            headlessImagePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--frame-times") == 0 && i + 1 < argc) {
+            frameTimesPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--world") == 0 && i + 1 < argc) {
+            worldDirectory = argv[++i];
+        } else if (std::strcmp(argv[i], "--map") == 0 && i + 1 < argc) {
+            mapPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--bake-map") == 0 && i + 1 < argc) {
+            bakeMapPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--bake-radius") == 0 && i + 1 < argc) {
+            bakeRadius = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--journal-sync") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            journalSync = (std::strcmp(mode, "none") == 0) ? JournalSync::None
+                        : (std::strcmp(mode, "edit") == 0) ? JournalSync::Edit : JournalSync::Batch;
+        }
     }
-    
-    // Set OpenGL version to 4.6 Core Profile
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4); 
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6); 
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-#ifdef __APPLE__
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
+    // --bake-map: write the saved world (region files over generated terrain) around the spawn
+    // column as a baked map for --map, without opening a window
+    if (!bakeMapPath.empty()) {
+        TerrainSettings settings;
+        settings.seed = terrainSeed;
+        TerrainGenerator generator(settings);
+        RegionStore store(worldDirectory);
+        const int centerX = World::ToChunkCoord((int)std::floor(PLAYER_SPAWN_XZ.x));
+        const int centerZ = World::ToChunkCoord((int)std::floor(PLAYER_SPAWN_XZ.y));
+        const int side = 2 * bakeRadius + 1;
+        bool baked = MappedWorld::Bake(bakeMapPath, centerX - bakeRadius, centerZ - bakeRadius, side, side,
+            [&](Chunk& chunk) {
+                if (!store.LoadChunk(chunk)) generator.GenerateChunk(chunk);
+                return true;
+            });
+        std::cout << (baked ? "Baked " : "Failed to bake ") << side * side << " chunks to " << bakeMapPath << std::endl;
+        return baked ? 0 : 1;
+    }
 
-    // 2. Create the Window Object
-    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Terraris Engine", NULL, NULL); 
-    if (window == NULL) {
-        std::cerr << "Failed to create GLFW window" << std::endl;
-        glfwTerminate();
-        return -1;
+    // --replay: the world is generated from the seed the log was recorded with
+    replaying = !replayPath.empty();
+    if (replaying) {
+        if (!recordPath.empty()) {
+            std::cerr << "ERROR::INPUT_LOG: --record and --replay cannot be combined" << std::endl;
+            return -1;
+        }
+        if (!inputReplay.Open(replayPath)) {
+            return -1;
+        }
+        terrainSeed = inputReplay.Seed();
+        std::cout << "Replaying " << inputReplay.EventCount() << " input events over " << inputReplay.EndTick()
+                  << " ticks from " << replayPath << std::endl;
+    } else if (!recordPath.empty()) {
+        if (headless) {
+            std::cerr << "ERROR::INPUT_LOG: --record needs a window to take input from" << std::endl;
+            return -1;
+        }
+        if (!inputRecorder.Open(recordPath, terrainSeed)) {
+            return -1;
+        }
+    }
+    // Input is applied between ticks only when the ticks run inline
+    const bool deterministicSim = replaying || inputRecorder.IsOpen();
+    if (deterministicSim) {
+        useSimThread = false;
+    }
+    // --headless without a log to replay flies the scripted camera path
+    const bool headlessPath = headless && !replaying;
+    // Time advances a fixed step per frame instead of with the wall clock
+    const bool scriptedTime = headless || replaying;
+
+    std::ofstream frameTimesFile;
+    if (!frameTimesPath.empty()) {
+        frameTimesFile.open(frameTimesPath);
+        if (!frameTimesFile) {
+            std::cerr << "ERROR::BENCHMARK: Cannot write " << frameTimesPath << std::endl;
+            return -1;
+        }
+        frameTimesFile << "frame,tick,build_ms,frame_ms\n";
     }
-    glfwMakeContextCurrent(window);
 
-    // Set callbacks
-    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
-    glfwSetCursorPosCallback(window, mouse_callback);
-    glfwSetMouseButtonCallback(window, mouse_button_callback); // <-- REGISTER CALLBACK
-    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED); 
+    jobSystem = std::make_unique<JobSystem>(jobThreads);
 
-    // 3. Initialize GLAD
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-        std::cerr << "Failed to initialize GLAD" << std::endl;
-        return -1;
+    // --headless: an offscreen context and framebuffer instead of a window (no GLFW at all)
+    HeadlessContext headlessContext;
+    GLFWwindow* window = NULL;
+    if (headless) {
+        useSimThread = false; // The camera follows the scripted path (or the replayed player)
+        if (!headlessContext.Create(SCR_WIDTH, SCR_HEIGHT)) {
+            return -1;
+        }
+    } else {
+        // 1. Initialize GLFW
+        if (!glfwInit()) {
+            std::cerr << "Failed to initialize GLFW" << std::endl;
+            return -1;
+        }
+
+        // Set OpenGL version to 4.6 Core Profile
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4); 
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6); 
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+#ifdef __APPLE__
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+
+        // 2. Create the Window Object
+        window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Terraris Engine", NULL, NULL); 
+        if (window == NULL) {
+            std::cerr << "Failed to create GLFW window" << std::endl;
+            glfwTerminate();
+            return -1;
+        }
+        glfwMakeContextCurrent(window);
+
+        // Set callbacks
+        glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+        glfwSetCursorPosCallback(window, mouse_callback);
+        glfwSetMouseButtonCallback(window, mouse_button_callback); // <-- REGISTER CALLBACK
+        glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED); 
+
+        // 3. Initialize GLAD
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+            std::cerr << "Failed to initialize GLAD" << std::endl;
+            return -1;
+        }
     }
 
     // --- SETUP: VBO, VAO, and Shaders ---
@@ -783,67 +1401,91 @@ int main() {
     glEnable(GL_DEPTH_TEST); 
 
     // --- 1. World Initialization ---
-    // Fill the world array to create a simple 16x1x16 plane at y=0
-    for (int x = 0; x < WORLD_SIZE_X; ++x) {
-        for (int z = 0; z < WORLD_SIZE_Z; ++z) {
-            for (int y = 0; y <= 4; ++y) {  // Fill from y = 0 to y = 4
-                world[x][y][z] = 1135; // Block ID 4 (Dirt)
-            }
+    // Terrain comes from the seed (see TerrainGen.h) and streams in around the camera on worker threads.
+    // The chunks around the spawn column are built right away so the player has ground to land on.
+    TerrainSettings terrainSettings;
+    terrainSettings.seed = terrainSeed;
+    TerrainGenerator terrain(terrainSettings);
+    ChunkStreamer streamer(terrain, viewDistance, streamThreads);
+
+    // Saved chunks are read back from the region files (on the streaming threads). Chunks edited
+    // since their last save are snapshotted every AUTOSAVE_INTERVAL seconds, when evicted and on
+    // exit, and written by the autosaver's I/O thread. Its pending snapshots are checked before the
+    // disk so a chunk that is evicted and streamed back in before its save lands keeps its edits.
+    // Edits made since the last autosave are in the journal; any left over from a crash are
+    // replayed onto chunks as they load.
+    //
+    // With --map the world is a read-only baked map instead: nothing is streamed, saved or journaled.
+    // With --headless, --record or --replay it is freshly generated terrain (saved edits would change
+    // the picture and the simulation): nothing is loaded, saved or journaled. The camera path's
+    // chunks are built up front as far as it can see, and not streamed.
+    RegionStore regionStore(worldDirectory);
+    AutoSaver autosaver(regionStore);
+    const bool readOnlyWorld = !mapPath.empty();
+    const bool scratchWorld = headless || deterministicSim;
+    if (readOnlyWorld) {
+        if (!mappedWorld.Open(mapPath)) {
+            glfwTerminate();
+            return -1;
         }
+        world.AttachMappedWorld(&mappedWorld);
+        std::cout << "Mapped " << mappedWorld.ChunkCount() << " chunks (" << mappedWorld.MappedBytes() / (1024 * 1024)
+                  << " MB) from " << mapPath << ", read-only" << std::endl;
+    } else if (!scratchWorld && !editJournal.Open(worldDirectory, journalSync,
+        [&regionStore, &terrain](Chunk& chunk) {
+            if (!regionStore.LoadChunk(chunk)) terrain.GenerateChunk(chunk);
+        },
+        [&regionStore](const Chunk& chunk) { return regionStore.SaveChunk(chunk); },
+        [&regionStore]() { return regionStore.Sync(); })) {
+        std::cerr << "WARNING: Edit journal unavailable; edits are only kept by autosaves" << std::endl;
     }
-    
-    // Add a layer of water on top of the ground
-    for (int x = 0; x < WORLD_SIZE_X; ++x) {
-        for (int z = 0; z < WORLD_SIZE_Z; ++z) {
-            world[x][5][z] = 1139; // Block ID 3 (Water/Transparent) at y=1
+    streamer.SetCompactDistance(compactDistance);
+    if (!scratchWorld) {
+        // Replayed journal edits are kept until the chunk carrying them is flushed to disk
+        autosaver.SetSavedCallback([](const std::vector<int64_t>& keys) { editJournal.ChunksSaved(keys); });
+        streamer.SetLoader([&autosaver](Chunk& chunk) {
+            if (!autosaver.ReadPending(chunk)) editJournal.LoadChunk(chunk);
+            return true;
+        });
+        streamer.SetUnloader([&autosaver](const Chunk& chunk) {
+            if (chunk.IsModified()) autosaver.Enqueue(chunk);
+        });
+    }
+    // A baked map may not cover the usual spawn column; start in its middle then
+    glm::vec2 spawnXZ = PLAYER_SPAWN_XZ;
+    if (readOnlyWorld && !mappedWorld.GetChunk(World::ToChunkCoord((int)std::floor(spawnXZ.x)),
+                                                World::ToChunkCoord((int)std::floor(spawnXZ.y)))) {
+        spawnXZ = glm::vec2((mappedWorld.MinChunkX() + mappedWorld.Width() / 2 + 0.5f) * CHUNK_SIZE,
+                            (mappedWorld.MinChunkZ() + mappedWorld.Depth() / 2 + 0.5f) * CHUNK_SIZE);
+    }
+    const int spawnChunkX = World::ToChunkCoord((int)std::floor(spawnXZ.x));
+    const int spawnChunkZ = World::ToChunkCoord((int)std::floor(spawnXZ.y));
+    const int preloadRadius = headlessPath ? viewDistance + (int)std::ceil(HEADLESS_PATH_RADIUS / CHUNK_SIZE) + 1 : 1;
+    for (int dx = -preloadRadius; dx <= preloadRadius && !readOnlyWorld; ++dx) {
+        for (int dz = -preloadRadius; dz <= preloadRadius; ++dz) {
+            if (headlessPath && dx * dx + dz * dz > preloadRadius * preloadRadius) continue;
+            streamer.LoadNow(world, spawnChunkX + dx, spawnChunkZ + dz);
         }
     }
-
-// --- 2. Generate the Single Mesh ---
-    std::vector<float> meshVertices = GenerateMesh();
-    totalVertices_Global = meshVertices.size() / VERTEX_ATTRIBUTES; // Use the global variable
-    
-    // VBO/VAO setup
-    unsigned int VAO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO_Global); // Initialize the global VBO ID
-
-    // Bind the VAO first
-    glBindVertexArray(VAO);
-    
-    // Bind the VBO and transfer the dynamic mesh data
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_Global);
-    // CHANGE FROM GL_STATIC_DRAW TO GL_DYNAMIC_DRAW
-    glBufferData(GL_ARRAY_BUFFER, meshVertices.size() * sizeof(float), meshVertices.data(), GL_DYNAMIC_DRAW);
-
-    // Tell OpenGL how to interpret the vertex data (position attribute at layout location 0)
-    // Total size of one vertex is 10 floats (Position + Normal + TexCoords + BlockID + TexIndex)
-    GLsizei stride = VERTEX_ATTRIBUTES * sizeof(float); // 10 * sizeof(float)
-
-    // 1. Position attribute (location 0): 3 floats
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    std::cout << "Seed " << terrainSeed << ", view distance " << viewDistance << " chunks, noise: "
+              << NoiseISAName(ActiveNoiseISA()) << std::endl;
+    std::vector<int64_t> evictedChunkKeys;
+    double lastTitleUpdate = 0.0;
+    double lastAutosave = WallTime();
+
+// --- 2. Chunk Meshes ---
+    // Every chunk created above is dirty; RemeshDirtyChunks() builds its VAO/VBO on the first frame.
+
+    // Lamp cube VAO (position only, taken from the unit cube faces: 36 vertices, 8 floats each)
+    unsigned int lampVAO, lampVBO;
+    glGenVertexArrays(1, &lampVAO);
+    glGenBuffers(1, &lampVBO);
+    glBindVertexArray(lampVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, lampVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(FACE_VERTICES), FACE_VERTICES, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
-    // 2. Normal attribute (location 1): 3 floats
-    // Offset is 3 floats
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // 3. Texture Coordinate attribute (location 2): 2 floats
-    // Offset is 6 floats
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    // 4. Block ID attribute (location 3): 1 float
-    // Offset is 8 floats
-    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)(8 * sizeof(float)));
-    glEnableVertexAttribArray(3);
-    
-    // 5. NEW: Texture Index attribute (location 4): 1 float
-    // Offset is 9 floats (3 Pos + 3 Normal + 2 TexCoord + 1 BlockID)
-    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, stride, (void*)(9 * sizeof(float)));
-    glEnableVertexAttribArray(4);
-
     // Unbind VBO and VAO
     glBindBuffer(GL_ARRAY_BUFFER, 0); 
     glBindVertexArray(0);
@@ -851,9 +1493,29 @@ int main() {
     // 2. Create the Shader Program (for the shaded cube)
     Shader lightingShader("../shaders/basic.vs", "../shaders/basic.fs"); // RENAMED for clarity
 
+    // Vertex pulling reads the face records from a storage buffer in the vertex shader, which
+    // GL 4.3 allows implementations not to support (GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS may be 0)
+    std::unique_ptr<Shader> pulledShader;
+    if (vertexPulling) {
+        GLint vertexStorageBlocks = 0;
+        glGetIntegerv(GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS, &vertexStorageBlocks);
+        if (vertexStorageBlocks > 0) {
+            pulledShader = std::make_unique<Shader>("../shaders/pulled.vs", "../shaders/basic.fs");
+        } else {
+            std::cerr << "ERROR::RENDER: No storage buffers in vertex shaders; drawing chunks from vertex attributes" << std::endl;
+            vertexPulling = false;
+        }
+    }
+    // Draws the chunk meshes (same uniforms and fragment shader either way)
+    Shader& chunkShader = vertexPulling ? *pulledShader : lightingShader;
+
     // 3. Create the Lamp Shader Program (for the light source)
     Shader lightCubeShader("../shaders/light.vs", "../shaders/light.fs"); // <-- NEW
 
+    // Chunk bounding boxes for occlusion queries
+    occlusion.Init("../shaders/occlusion.vs", "../shaders/occlusion.fs");
+    occlusion.SetEnabled(occlusionCulling);
+
     // Load crosshair shader
     Shader crosshairShader("../shaders/crosshair.vs", "../shaders/crosshair.fs");
 
@@ -890,91 +1552,364 @@ int main() {
     glBindTexture(GL_TEXTURE_2D_ARRAY, blockTextureArrayID);
 
     // 3. Tell the shader where to find the single Texture Array (Unit 0)
-    lightingShader.use();
-    lightingShader.setInt("u_blockTextureArray", 0);
+    chunkShader.use();
+    chunkShader.setInt("u_blockTextureArray", 0);
 
     // --------------------------------------------------------------------------
+
+    // --- MESH CACHE ---
+    // Keyed on the block tables too, so it is opened once they are loaded.
+    // A baked map keeps its own cache next to the map file.
+    // --headless, --record and --replay mesh every chunk (the mesher is part of what they measure).
+    if (!scratchWorld) {
+        meshCache.Open(readOnlyWorld ? mapPath + ".meshcache" : worldDirectory + "/meshcache", world);
+    }
     
-    // 4. The Render Loop
-    while (!glfwWindowShouldClose(window)) {
-        
+    // --- Simulation Start ---
+    // Drop the player just above the highest block of the spawn column
+    int spawnX = (int)std::floor(spawnXZ.x), spawnZ = (int)std::floor(spawnXZ.y);
+    int spawnY = CHUNK_HEIGHT - 1;
+    while (spawnY > 0 && !world.isBlock(spawnX, spawnY - 1, spawnZ)) {
+        --spawnY;
+    }
+    glm::vec3 playerSpawn(spawnXZ.x, (float)spawnY + PLAYER_SIZE_STANDING.y, spawnXZ.y);
+    playerEntity = entities.Spawn(playerSpawn, PLAYER_SIZE_STANDING, ENTITY_PLAYER);
+
+    // Publish the spawn state twice so the renderer has a valid (previous, current) pair from frame one
+    SimState spawnState;
+    spawnState.playerPos = entities.GetPosition(playerEntity);
+    spawnState.playerSize = entities.GetSize(playerEntity);
+    spawnState.time = WallTime();
+    simStates.Publish(spawnState);
+    simStates.Publish(spawnState);
+
+    if (useSimThread) {
+        simThread.Start(SimulationTick);
+    }
+    lastFrame = scriptedTime ? 0.0f : (float)glfwGetTime();
+    const glm::vec3 headlessPathCenter(spawnXZ.x, (float)spawnY, spawnXZ.y);
+    bool viewComplete = false; // Everything in view streamed in and meshed (reported once, as the start-up time)
+    uint64_t frameNumber = 0;
+
+    std::vector<InputEvent> frameInput; // Reused between frames
+
+    // --record / --replay: a tick with the chunks around the player built first, so collisions never
+    // depend on how far the streamer has got. Likewise every chunk flowing water can reach: it only
+    // spreads into loaded chunks, so otherwise the flow would depend on streaming timing.
+    std::vector<int64_t> waterChunkKeys; // Reused between ticks
+    auto deterministicTick = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(worldMutex);
+            const glm::vec3 playerPos = entities.GetPosition(playerEntity);
+            const int playerChunkX = World::ToChunkCoord((int)std::floor(playerPos.x));
+            const int playerChunkZ = World::ToChunkCoord((int)std::floor(playerPos.z));
+            for (int dx = -1; dx <= 1; ++dx) {
+                for (int dz = -1; dz <= 1; ++dz) {
+                    streamer.LoadNow(world, playerChunkX + dx, playerChunkZ + dz);
+                }
+            }
+            water.GetPendingChunks(waterChunkKeys);
+            for (int64_t key : waterChunkKeys) {
+                const int chunkX = World::ChunkKeyX(key);
+                const int chunkZ = World::ChunkKeyZ(key);
+                streamer.LoadNow(world, chunkX, chunkZ);
+                streamer.LoadNow(world, chunkX - 1, chunkZ);
+                streamer.LoadNow(world, chunkX + 1, chunkZ);
+                streamer.LoadNow(world, chunkX, chunkZ - 1);
+                streamer.LoadNow(world, chunkX, chunkZ + 1);
+            }
+        }
+        SimulationTick((float)simClock.TickDt);
+    };
+
+    // Prepares one frame into a render packet: input, physics (unless it has its own thread), the
+    // camera, chunk streaming, meshing, translucent sorting and cave culling. No GL calls: with
+    // --game-thread this runs on the game thread, a frame ahead of the render loop; otherwise at
+    // the top of every render loop iteration.
+    auto buildFrame = [&](RenderPacket& packet) {
+        const auto buildStart = std::chrono::steady_clock::now();
+        packet.Clear();
+        packet.frame = frameNumber++;
+        // Measured frames: the camera path once the view is meshed, or a replay's ticks from then on
+        const bool replayTick = replaying && viewComplete && simTickCount < inputReplay.EndTick();
+        packet.benchmarkFrame = ((headlessPath && viewComplete) || replayTick) ? benchmarkFrames++ : -1;
+
         // --- Calculate Delta Time ---
-        float currentFrame = (float)glfwGetTime();
+        // --headless / --replay: scripted time, a fixed step per frame
+        float currentFrame = scriptedTime ? (float)(packet.frame * HEADLESS_FRAME_DT) : (float)glfwGetTime();
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
-        // Input processing
-        // --- NEW: Physics and Player Update ---
-        processInput(window);           // Calculate intended velocity
-        UpdatePlayerPhysics(deltaTime); // Apply gravity, check collision, update playerPos
+        // --- Input since the last frame, applied before the next tick ---
+        inputQueue.Drain(frameInput);
+        for (InputEvent& event : frameInput) {
+            ApplyInputEvent(event);
+        }
+
+        // --- NEW: Fixed-Timestep Physics ---
+        // Inline mode runs as many whole ticks as the elapsed time allows; threaded mode ticks on its own.
+        // A replay runs exactly one tick per frame, after the input logged before it.
+        float alpha = 0.0f;
+        if (replaying) {
+            if (replayTick) {
+                InputEvent event;
+                while (inputReplay.Next(simTickCount, event)) {
+                    ApplyInputEvent(event);
+                }
+                deterministicTick();
+            }
+            alpha = 1.0f;
+        } else if (!useSimThread && !headless) {
+            int ticks = simClock.Advance(deltaTime);
+            for (int i = 0; i < ticks; ++i) {
+                if (deterministicSim) {
+                    deterministicTick();
+                } else {
+                    SimulationTick((float)simClock.TickDt);
+                }
+            }
+            alpha = simClock.Alpha();
+        }
+        SimState previousState, currentState;
+        simStates.Read(previousState, currentState);
+        // The published tick: with --sim-thread, simTickCount is only safe to read under worldMutex
+        packet.tick = currentState.tick;
+        packet.replayDone = replaying && viewComplete && currentState.tick >= inputReplay.EndTick();
+        if (useSimThread) {
+            // Blend by how long ago the newest tick was published
+            alpha = (float)((glfwGetTime() - currentState.time) / SIM_TICK_DT);
+        }
+        alpha = glm::clamp(alpha, 0.0f, 1.0f);
         
         // 1. Update Camera Position to follow the Player's Head
-        // Set the camera's position based on the player entity's position, placing it near the top of the hitbox
-        camera.Position = playerPos + glm::vec3(-0.45f, PLAYER_SIZE.y * 0.2f, -0.45f);
+        // Interpolate between the last two ticks so motion stays smooth at any frame rate,
+        // then place the camera near the top of the hitbox
+        glm::vec3 renderPlayerPos = glm::mix(previousState.playerPos, currentState.playerPos, alpha);
+        if (headlessPath) {
+            camera = HeadlessPathCamera(std::max(packet.benchmarkFrame, 0), headlessPathCenter);
+        } else {
+            camera.Position = renderPlayerPos + glm::vec3(-0.45f, currentState.playerSize.y * 0.2f, -0.45f);
+        }
+        Camera frameCamera = camera;
         // ------------------------------------
 
-        // Rendering commands
-        // Clear the screen AND the depth buffer
-        glClearColor(0.5f, 0.8f, 1.0f, 1.0f); // <-- NEW SKY BLUE COLOR
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); 
-
-        // 1. Define Transformation Matrices (Same for both objects)
-        glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-        glm::mat4 view = camera.GetViewMatrix();
-        
+        // 2. Define Transformation Matrices (Same for every object)
+        packet.projection = glm::perspective(glm::radians(frameCamera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, (viewDistance + 1) * CHUNK_SIZE * 1.5f);
+        packet.view = frameCamera.GetViewMatrix();
+        packet.cameraPos = frameCamera.Position;
 
-        lightingShader.use(); // Use the shader that performs lighting calculations
-        
         // --- NEW: Calculate Dynamic Light Position ---
-        float time = (float)glfwGetTime();
+        float time = currentFrame;
         
         // Calculate the current angle (in radians) based on time and cycle duration
         // This angle cycles from 0 to 2*PI over 300 seconds
         float angle = (time / LIGHT_CYCLE_DURATION) * 2.0f * glm::pi<float>();
         
-        // Calculate Light Position in a 3D arc (centered at WORLD_CENTER)
-        glm::vec3 lightPos;
+        // Calculate Light Position in a 3D arc (centered above the camera's column)
         // X: Cosine for horizontal movement (East/West)
-        lightPos.x = WORLD_CENTER.x + LIGHT_ORBIT_RADIUS * glm::cos(angle);
+        packet.lightPos.x = frameCamera.Position.x + LIGHT_ORBIT_RADIUS * glm::cos(angle);
         // Y: Sine for vertical movement (Sun height/arc). Offset ensures it starts at 0 height.
-        lightPos.y = WORLD_CENTER.y + LIGHT_ORBIT_RADIUS * glm::sin(angle);
+        packet.lightPos.y = SUN_ORBIT_HEIGHT + LIGHT_ORBIT_RADIUS * glm::sin(angle);
         // Z: Fixed or set to a small radius offset for the arc plane
-        lightPos.z = WORLD_CENTER.z + 0.0f; 
+        packet.lightPos.z = frameCamera.Position.z + 0.0f; 
         
         // Ensure the light is always above the horizon (y > 0). If using a 360-arc, this means the light
         // will pass underneath the world during the "night" phase.
-        
+
+        // For a day/night cycle, we can also vary the intensity (lightColor) based on the sun's height (lightPos.y)
+        // For now, let's keep it fixed or adjust it slightly:
+        packet.lightColor = glm::vec3(1.0f, 0.78f, 0.0f); // Use a bright color for the "sun"
         // ---------------------------------------------
 
-        lightingShader.use(); // Use the shader that performs lighting calculations
+        // 3. Stream chunks around the camera and rebuild the meshes the world marked dirty
+        {
+            std::lock_guard<std::mutex> lock(worldMutex);
+            if (readOnlyWorld) {
+                UpdateMappedView(frameCamera.Position, evictedChunkKeys);
+            } else if (!headlessPath) {
+                streamer.Update(world, frameCamera.Position, frameCamera.Front, evictedChunkKeys);
+            }
+            for (int64_t key : evictedChunkKeys) {
+                water.ClearChunk(World::ChunkKeyX(key), World::ChunkKeyZ(key));
+            }
+            UpdateChunkLods(frameCamera.Position);
+            // Only copies the edited chunks; encoding and writing happen on the I/O thread.
+            // The journal segment covering the edits up to now is deleted once they are written.
+            if (!readOnlyWorld && !scratchWorld && currentFrame - lastAutosave >= AUTOSAVE_INTERVAL) {
+                lastAutosave = currentFrame;
+                uint32_t journalSegment = editJournal.Seal();
+                autosaver.SnapshotModified(world);
+                autosaver.AfterWrites([journalSegment](bool allSaved) {
+                    if (allSaved) editJournal.Discard(journalSegment);
+                });
+            }
+        }
+        for (int64_t key : evictedChunkKeys) {
+            ReleaseChunkState(packet, key);
+        }
+        const size_t meshesWaiting = RemeshDirtyChunks(frameCamera.Position, packet);
+        if (!viewComplete && meshesWaiting == 0) {
+            StreamerStats stats = streamer.GetStats();
+            if (readOnlyWorld || (stats.queuedChunks == 0 && stats.inFlightChunks == 0)) {
+                viewComplete = true;
+                std::cout << "View complete " << WallTime() << " s after start (" << meshCache.GetStats().hits
+                          << " chunk meshes from the mesh cache)" << std::endl;
+            }
+        }
+        SortTranslucentChunks(frameCamera.Position, packet);
+        // Sections the camera may see through air / water (CPU, from the meshes' visibility sets)
+        if (caveCulling) {
+            caveCuller.Update(frameCamera.Position, frameCamera.Front, viewDistance + EVICT_MARGIN);
+        }
+        QueueChunkDraws(packet);
+
+        // --- Streaming stats for the window title (twice a second; the render loop adds its own) ---
+        if (currentFrame - lastTitleUpdate >= 0.5) {
+            lastTitleUpdate = currentFrame;
+            StreamerStats stats = streamer.GetStats();
+            AutoSaveStats saveStats = autosaver.GetStats();
+            char title[256];
+            if (readOnlyWorld) {
+                std::snprintf(title, sizeof(title), "Terraris Engine | read-only map: %zu chunks (%.1f MB mapped) | %zu in view",
+                              mappedWorld.ChunkCount(), mappedWorld.MappedBytes() / (1024.0 * 1024.0), mappedInView.size());
+            } else {
+                std::snprintf(title, sizeof(title), "Terraris Engine | chunks %zu, %zu compact (%.1f MB) | queued %zu | in flight %zu | %.0f chunks/s | saving %zu",
+                              stats.residentChunks, stats.compactChunks, stats.residentBytes / (1024.0 * 1024.0), stats.queuedChunks,
+                              stats.inFlightChunks, stats.loadRate, saveStats.pendingChunks);
+            }
+            packet.updateTitle = true;
+            packet.title = title;
+            packet.caves = caveCuller.GetStats();
+        }
+        packet.buildMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+    };
+
+    // --game-thread: packets are built on their own thread while the render loop draws the previous one
+    std::thread gameThread;
+    if (useGameThread) {
+        gameThread = std::thread([&]() {
+            while (RenderPacket* packet = renderPackets.BeginWrite()) {
+                buildFrame(*packet);
+                renderPackets.EndWrite();
+            }
+        });
+    }
+    RenderPacket inlinePacket; // Built and drawn by the render loop without --game-thread
+
+    // --headless / --replay: the measured frames (timed once the GPU finished them, or once swapped)
+    std::vector<double> benchmarkFrameTimes;
+    size_t benchmarkDrawCalls = 0;
+    size_t benchmarkVertices = 0;
+    std::vector<uint8_t> headlessPixels; // The last frame
+    bool benchmarkFailed = false;
+    bool runFinished = false; // The camera path flown or the replay played to its end
+
+    // 4. The Render Loop
+    while (!runFinished && (headless || !glfwWindowShouldClose(window))) {
+        const auto frameStart = std::chrono::steady_clock::now();
+        frameDraws = DrawCounters();
+
+        // Input processing
+        if (!headless) {
+            processInput(window); // Sample keyboard state for the next simulation tick
+        }
+
+        // This frame's packet: the oldest one the game thread finished, or one built right here
+        RenderPacket* framePacket = &inlinePacket;
+        if (useGameThread) {
+            framePacket = renderPackets.BeginRead();
+            if (framePacket == nullptr) break;
+        } else {
+            buildFrame(inlinePacket);
+        }
+        const RenderPacket& packet = *framePacket;
+        // Kept for the timings below (the packet is handed back before the buffers are swapped)
+        const uint64_t packetFrame = packet.frame;
+        const uint64_t packetTick = packet.tick;
+        const int benchmarkFrame = packet.benchmarkFrame;
+        const double buildMilliseconds = packet.buildMilliseconds;
+        runFinished = packet.replayDone;
+        // GL work other threads handed to the main thread, then the meshes built for this frame
+        // (and the evicted ones freed)
+        jobSystem->RunMainThreadJobs();
+        ApplyRenderPacket(packet);
+
+        // Rendering commands
+        // Clear the screen AND the depth buffer
+        glClearColor(0.5f, 0.8f, 1.0f, 1.0f); // <-- NEW SKY BLUE COLOR
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); 
+
+        // 1. Transformation Matrices and light from the packet (Same for every object)
+        const glm::mat4& projection = packet.projection;
+        const glm::mat4& view = packet.view;
+        const glm::vec3& lightPos = packet.lightPos;
+
+        chunkShader.use(); // Use the shader that performs lighting calculations
         
         // Pass common matrices
-        lightingShader.setMat4("projection", projection);
-        lightingShader.setMat4("view", view);
+        chunkShader.setMat4("projection", projection);
+        chunkShader.setMat4("view", view);
 
         // --- Pass Lighting Data ---
         // Pass the calculated dynamic lightPos to the shader 
-        lightingShader.setVec3("lightPos", lightPos); // <-- USE DYNAMIC lightPos
-        
-        // For a day/night cycle, we can also vary the intensity (lightColor) based on the sun's height (lightPos.y)
-        // For now, let's keep it fixed or adjust it slightly:
-        lightingShader.setVec3("lightColor", glm::vec3(1.0f, 0.78f, 0.0f)); // Use a bright color for the "sun"
+        chunkShader.setVec3("lightPos", lightPos); // <-- USE DYNAMIC lightPos
+        chunkShader.setVec3("lightColor", packet.lightColor);
 
         
         // Pass the camera's world position for specular calculations 
-        lightingShader.setVec3("viewPos", camera.Position); 
+        chunkShader.setVec3("viewPos", packet.cameraPos); 
         // ----------------------------------------------------
 
         // Model matrix for the main block (at origin, 1x1 scale)
         glm::mat4 model = glm::mat4(1.0f); 
-        lightingShader.setMat4("model", model);
+        chunkShader.setMat4("model", model);
+
+        // 3. Draw the packet's chunks
+        // Phase 1: the chunks in the frustum that were visible last frame
+        occlusion.BeginFrame(projection * view, packet.cameraPos);
+        for (const ChunkDraw& draw : packet.draws) {
+            ChunkRenderData& chunkMesh = chunkMeshes[draw.key];
+            chunkMesh.visibleSections = draw.visibleSections;
+            if (chunkMesh.opaqueVertexCount == 0 && chunkMesh.translucentIndexCount == 0) {
+                chunkMesh.visibility = ChunkVisibility::Culled;
+                continue;
+            }
+            chunkMesh.visibility = occlusion.Classify(draw.key, chunkMesh.boundsMin, chunkMesh.boundsMax);
+            if (chunkMesh.visibility != ChunkVisibility::Visible || chunkMesh.opaqueVertexCount == 0) continue;
+            DrawChunkSections(chunkMesh);
+        }
+        // Phase 2: test every chunk box against that depth; last frame's hidden chunks are drawn
+        // only where their box passed
+        occlusion.IssueQueries();
+        chunkShader.use();
+        for (const ChunkDraw& draw : packet.draws) {
+            const ChunkRenderData& chunkMesh = chunkMeshes[draw.key];
+            if (chunkMesh.visibility != ChunkVisibility::Tested || chunkMesh.opaqueVertexCount == 0) continue;
+            occlusion.BeginConditional(draw.key);
+            DrawChunkSections(chunkMesh);
+            occlusion.EndConditional();
+        }
 
-        // Draw the cube
-        // Bind the geometry
-        // 3. Draw the single generated mesh
-        glBindVertexArray(VAO);
-        // Draw using the global count
-        glDrawArrays(GL_TRIANGLES, 0, totalVertices_Global); // <-- USE GLOBAL COUNT
+        // 4. Translucent pass: blended, back to front, testing against (but not writing) depth
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDepthMask(GL_FALSE);
+        for (int64_t key : packet.translucentOrder) {
+            const ChunkRenderData& chunkMesh = chunkMeshes[key];
+            if (chunkMesh.visibility == ChunkVisibility::Culled) continue;
+            const bool conditional = (chunkMesh.visibility == ChunkVisibility::Tested);
+            if (conditional) occlusion.BeginConditional(key);
+            glBindVertexArray(chunkMesh.translucentVAO);
+            if (vertexPulling) {
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, chunkMesh.translucentVBO);
+            }
+            glDrawElements(GL_TRIANGLES, chunkMesh.translucentIndexCount, GL_UNSIGNED_INT, (void*)0);
+            ++frameDraws.drawCalls;
+            frameDraws.vertices += chunkMesh.translucentIndexCount;
+            if (conditional) occlusion.EndConditional();
+        }
+        glDepthMask(GL_TRUE);
+        glDisable(GL_BLEND);
 
 
         // --- PASS 2: DRAW THE LIGHT CUBE (LAMP) ---
@@ -991,8 +1926,11 @@ int main() {
         model = glm::scale(model, glm::vec3(5.5f)); // Make it a slightly larger sun
         lightCubeShader.setMat4("model", model);
         
-        // Draw the cube (re-using the same VAO as the object)
+        // Draw the cube
+        glBindVertexArray(lampVAO);
         glDrawArrays(GL_TRIANGLES, 0, 36);
+        ++frameDraws.drawCalls;
+        frameDraws.vertices += 36;
 
         // Swap the buffers
         //glfwSwapBuffers(window);
@@ -1031,6 +1969,8 @@ int main() {
     // 4. Draw the point
     glBindVertexArray(crosshairVAO);
     glDrawArrays(GL_POINTS, 0, 1);
+    ++frameDraws.drawCalls;
+    ++frameDraws.vertices;
     
     // 6. Cleanup
     glBindVertexArray(0);
@@ -1040,18 +1980,154 @@ int main() {
     glEnable(GL_DEPTH_TEST); 
     // --------------------------------------------------------
 
-    glfwSwapBuffers(window);
-    glfwPollEvents();
+    // --- Window title: the packet's streaming stats plus what was drawn ---
+    if (packet.updateTitle && !headless) {
+        size_t triangles = 0;
+        for (const auto& pair : chunkMeshes) {
+            triangles += (pair.second.opaqueVertexCount + pair.second.translucentIndexCount) / 3;
+        }
+        const OcclusionStats& cull = occlusion.GetStats();
+        // Chunks drawn this frame: in the frustum and visible last frame (+ occluded ones that may reappear)
+        char drawn[160];
+        std::snprintf(drawn, sizeof(drawn), " | %zuk tris (%.1f MB) | visible %zu/%zu, %zu occluded | sections %zu/%zu",
+                      triangles / 1000, chunkBufferBytes / (1024.0 * 1024.0), cull.visible, chunkMeshes.size(), cull.occluded,
+                      packet.caves.visibleSections, packet.caves.chunks * SECTIONS);
+        glfwSetWindowTitle(window, (packet.title + drawn).c_str());
+    }
+    const size_t queries = occlusion.GetStats().queries; // One 36-vertex box each
+    frameDraws.drawCalls += queries;
+    frameDraws.vertices += queries * 36;
+    if (headlessPath && benchmarkFrame + 1 == headlessFrames) {
+        runFinished = true;
+    }
+    // --- Headless: the frame is done once the GPU (or llvmpipe) has drawn it ---
+    if (headless) {
+        glFinish();
+        if (benchmarkFrame < 0 && !runFinished && packetFrame >= (uint64_t)HEADLESS_MAX_WARMUP_FRAMES) {
+            std::cerr << "ERROR::HEADLESS: The view was still being meshed after " << HEADLESS_MAX_WARMUP_FRAMES << " frames" << std::endl;
+            benchmarkFailed = true;
+            break;
+        }
+    }
+    if (useGameThread) {
+        renderPackets.EndRead(); // The game thread may refill it now
+    }
+
+    if (!headless) {
+        glfwSwapBuffers(window);
+    }
+    const double frameMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+    if (benchmarkFrame >= 0) {
+        benchmarkFrameTimes.push_back(frameMilliseconds);
+        benchmarkDrawCalls += frameDraws.drawCalls;
+        benchmarkVertices += frameDraws.vertices;
+    }
+    if (headless && runFinished) {
+        headlessContext.ReadPixels(headlessPixels); // The last frame
+    }
+    if (frameTimesFile.is_open()) {
+        char line[96];
+        std::snprintf(line, sizeof(line), "%llu,%llu,%.3f,%.3f\n", (unsigned long long)packetFrame,
+                      (unsigned long long)packetTick, buildMilliseconds, frameMilliseconds);
+        frameTimesFile << line;
+    }
+    if (!headless) {
+        glfwPollEvents();
+    }
     // --------------------------------------------------------
 
     }
+    if (useGameThread) {
+        renderPackets.Stop();
+        gameThread.join();
+    }
+
+    // --- Benchmark report: frame times of the measured frames, what was submitted, and the last image ---
+    if ((headlessPath || replaying) && !benchmarkFailed) {
+        const FrameTimeStats times = SummarizeFrameTimes(benchmarkFrameTimes);
+        if (replaying) {
+            std::printf("Replay: %llu of %llu ticks in %zu frames (started after %d frames of meshing)\n",
+                        (unsigned long long)simTickCount, (unsigned long long)inputReplay.EndTick(), times.frames,
+                        (int)(frameNumber - benchmarkFrames));
+        } else {
+            std::printf("Headless: %zu frames (path started after %d frames of meshing)\n", times.frames,
+                        (int)(frameNumber - benchmarkFrames));
+        }
+        if (times.frames > 0) {
+            std::printf("  frame ms: mean %.3f | p50 %.3f | p95 %.3f | p99 %.3f | max %.3f\n",
+                        times.mean, times.p50, times.p95, times.p99, times.max);
+            std::printf("  per frame: %.1f draw calls, %.0f vertices\n", (double)benchmarkDrawCalls / times.frames,
+                        (double)benchmarkVertices / times.frames);
+        }
+        // The same log on the same build must end in the same simulation state
+        if (replaying && simTickCount == inputReplay.EndTick()) {
+            const bool matches = (simChecksum == inputReplay.EndChecksum());
+            std::printf("  simulation checksum: %016llx (%s)\n", (unsigned long long)simChecksum,
+                        matches ? "matches the recording" : "DIFFERS from the recording");
+            benchmarkFailed = !matches;
+        } else if (replaying) {
+            std::printf("  stopped before the end of the log: no checksum to compare\n");
+        }
+        if (headless) {
+            std::printf("  image hash: %016llx\n", (unsigned long long)HashPixels(headlessPixels));
+            if (!headlessImagePath.empty() && !WritePPM(headlessImagePath, headlessContext.Width(), headlessContext.Height(), headlessPixels)) {
+                benchmarkFailed = true;
+            }
+        }
+    }
+    // --- Recording: the log ends at the last tick, with the simulation checksum there ---
+    if (inputRecorder.IsOpen()) {
+        const size_t events = inputRecorder.EventCount();
+        if (inputRecorder.Close(simTickCount, simChecksum)) {
+            std::cout << "Recorded " << events << " input events over " << simTickCount << " ticks ("
+                      << inputRecorder.ByteCount() << " bytes) to " << recordPath << std::endl;
+        }
+    }
 
     // 5. Cleanup
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO_Global);
+    simThread.Stop();
+    streamer.Stop();
+    jobSystem.reset();
+
+    // Save every chunk edited since the last autosave, and wait for the writes to finish.
+    // With everything saved, the journal is no longer needed.
+    if (!readOnlyWorld && !scratchWorld) {
+        uint32_t journalSegment;
+        {
+            std::lock_guard<std::mutex> lock(worldMutex);
+            journalSegment = editJournal.Seal();
+            autosaver.SnapshotModified(world);
+        }
+        autosaver.Stop();
+        AutoSaveStats saveStats = autosaver.GetStats();
+        editJournal.Close(); // Also finishes replaying an earlier session's edits into the region files
+        if (saveStats.writeErrors == 0) {
+            editJournal.Discard(journalSegment);
+        }
+        std::cout << "Saved " << saveStats.chunksWritten << " edited chunks to " << worldDirectory;
+        if (saveStats.writeErrors > 0) std::cout << " (" << saveStats.writeErrors << " failed)";
+        std::cout << std::endl;
+    }
+    meshCache.Close(); // Writes the meshes still queued
+    MeshCacheStats meshCacheStats = meshCache.GetStats();
+    std::cout << "Mesh cache: " << meshCacheStats.hits << " hits, " << meshCacheStats.misses << " misses, "
+              << meshCacheStats.stored << " meshes stored" << std::endl;
+    for (auto& pair : chunkMeshes) {
+        glDeleteVertexArrays(1, &pair.second.VAO);
+        glDeleteBuffers(1, &pair.second.VBO);
+        if (pair.second.translucentVAO != 0) {
+            glDeleteVertexArrays(1, &pair.second.translucentVAO);
+            glDeleteBuffers(1, &pair.second.translucentVBO);
+            glDeleteBuffers(1, &pair.second.translucentEBO);
+        }
+    }
+    occlusion.Shutdown();
+    glDeleteVertexArrays(1, &lampVAO);
+    glDeleteBuffers(1, &lampVBO);
+    headlessContext.Destroy();
     
     glfwTerminate();
-    return 0;
+    return benchmarkFailed ? 1 : 0;
 }
 
 // --- Function Definitions (mouse_callback, processInput, framebuffer_size_callback) are unchanged and defined below ---
@@ -1072,58 +2148,32 @@ void mouse_callback(GLFWwindow* window, double xposIn, double yposIn) {
     lastX = xpos;
     lastY = ypos;
 
-    camera.ProcessMouseMovement(xoffset, yoffset);
+    // The packet builder turns the camera (see ApplyInputEvent); a replay brings its own
+    if (replaying) return;
+    InputEvent event;
+    event.type = InputEventType::MouseMove;
+    event.dx = xoffset;
+    event.dy = yoffset;
+    inputQueue.Push(event);
 }
-int cID = 1;
 void processInput(GLFWwindow *window) {
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true);
-    
-    // Reset horizontal velocity
-    playerVelocity.x = 0.0f;
-    playerVelocity.z = 0.0f;
-    bool isSneaking = false;
-    // Calculate forward/right vectors based on camera's view (horizontal-only)
-    glm::vec3 forward = glm::normalize(glm::vec3(camera.Front.x, 0.0f, camera.Front.z));
-    glm::vec3 right = glm::normalize(glm::cross(forward, camera.Up));
-    
-    // Horizontal Movement (Set desired velocity)
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        playerVelocity += forward * PLAYER_SPEED;
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        playerVelocity -= forward * PLAYER_SPEED;
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        playerVelocity -= right * PLAYER_SPEED;
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        playerVelocity += right * PLAYER_SPEED;
-    if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS){
-        if (isSneaking == false){isSneaking = true;}
-    }
-    if (isSneaking == true){PLAYER_SIZE = glm::vec3(0.6f, 1.5f, 0.6f); PLAYER_SPEED = 2.5f;}
-    else{PLAYER_SIZE = glm::vec3(0.6f, 1.8f, 0.6f); PLAYER_SPEED = 3.5f;}
-    if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS){
-    if (isSneaking == false){PLAYER_SPEED = 5.5f;}
-    }
-        if (glfwGetKey(window, GLFW_KEY_N) == GLFW_PRESS)
-        {
-            cID++;
-                currentPlacementBlockID = cID;
-        }
-        if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS)
-        {
-            cID--;
-                currentPlacementBlockID = cID;
-        }
-        
-        
-    
-        
-    
-    // Jumping (Spacebar)
-    if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS && isGrounded) {
-        playerVelocity.y = JUMP_VELOCITY;
-        isGrounded = false; // Prevents spamming jump
-    }
+    if (replaying) return;
+
+    // Only sampled here; the packet builder turns them into a PlayerInput before the next tick
+    InputEvent event;
+    event.type = InputEventType::Keys;
+    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)            event.keys |= INPUT_KEY_FORWARD;
+    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)            event.keys |= INPUT_KEY_BACK;
+    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)            event.keys |= INPUT_KEY_LEFT;
+    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)            event.keys |= INPUT_KEY_RIGHT;
+    if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS) event.keys |= INPUT_KEY_SNEAK;
+    if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS)   event.keys |= INPUT_KEY_SPRINT;
+    if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)        event.keys |= INPUT_KEY_JUMP;
+    if (glfwGetKey(window, GLFW_KEY_N) == GLFW_PRESS)            event.keys |= INPUT_KEY_NEXT_BLOCK;
+    if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS)            event.keys |= INPUT_KEY_PREVIOUS_BLOCK;
+    inputQueue.Push(event);
     
     // We no longer move UP/DOWN with controls, as that's handled by gravity and collision.
     // REMOVE: if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS) camera.ProcessKeyboard(UP, deltaTime);